@@ -0,0 +1,138 @@
+"""
+DEADLINE-AWARE DETECTION SCALING
+
+Each detection frame has a deadline: from capture to result, a frame must be done before the next one arrives, the
+period the RMA analysis assumes for the camera service. On the Nano the time a frame takes varies with clock speed,
+and thermal throttling can push it past that deadline for minutes at a time. The detector then falls behind and every
+STOP reaches the TIVA late.
+
+DeadlineController watches the frame time (capture to detection result) of the last window frames. It moves along a
+fixed ladder of levels, each cheaper than the one before:
+
+    level  resolution  pyramid step  frames
+    0      1.0         1.1           all
+    1      1.0         1.2           all
+    2      0.75        1.2           all
+    3      0.5         1.2           all
+    4      0.5         1.3           every 2nd
+
+Resolution scales the image the cascade searches. A larger pyramid step means fewer pyramid levels, so fewer
+cascade passes over the image. At level 4 only every second frame goes to the detector; the rest are dropped before
+any work is done on them.
+
+When the p99 frame time of the window goes above high * deadline, the controller moves one level down. When it is
+below low * deadline over a full window, it moves one level up. Every change clears the window, and a step down needs
+min_samples new frames first, so the effect of one change is measured before the next one. Each change is written to
+syslog with the p99 that caused it. That lets it be lined up with the TIVA's WCET and overrun reports for the same
+period.
+
+ScaledDetector applies the current level to any backend in detectors.py. Boxes are always returned in full frame
+coordinates.
+
+Authors: Kiran Jojare, Ayswariya Kannan
+Subject: ECEN 5623 Real-Time Embedded Systems
+University: University of Colorado Boulder
+"""
+
+import collections
+import syslog
+
+import cv2
+
+from detectors import MIN_SIZE, crop
+
+Level = collections.namedtuple("Level", "scale scale_factor every")
+
+LEVELS = (
+    Level(1.0, 1.1, 1),
+    Level(1.0, 1.2, 1),
+    Level(0.75, 1.2, 1),
+    Level(0.5, 1.2, 1),
+    Level(0.5, 1.3, 2),
+)
+
+
+def percentile(values, q):
+    """Nearest-rank percentile of an unsorted sequence."""
+    ordered = sorted(values)
+    rank = max(1, int(q * len(ordered) + 0.999999))
+    return ordered[min(rank, len(ordered)) - 1]
+
+
+class DeadlineController:
+    """Picks the detection level from the p99 frame time of the last window frames."""
+
+    def __init__(self, deadline_ms, window=100, high=0.9, low=0.6, min_samples=30, levels=LEVELS):
+        self.deadline_ns = int(deadline_ms * 1e6)
+        self.window = collections.deque(maxlen=window)
+        self.high = high
+        self.low = low
+        self.min_samples = min_samples
+        self.levels = levels
+        self.index = 0
+        self.changes = 0
+        self.skipped = 0
+        self.misses = 0
+
+    @property
+    def level(self):
+        return self.levels[self.index]
+
+    def admit(self, seq):
+        """True if frame seq should be run through the detector at the current level."""
+        if seq % self.level.every == 0:
+            return True
+        self.skipped += 1
+        return False
+
+    def observe(self, frame_ns):
+        """Records one frame time (capture to detection result); may change the level."""
+        self.window.append(frame_ns)
+        if frame_ns > self.deadline_ns:
+            self.misses += 1
+        if len(self.window) < self.min_samples:
+            return
+        p99 = percentile(self.window, 0.99)
+        if p99 > self.high * self.deadline_ns and self.index < len(self.levels) - 1:
+            self._change(self.index + 1, p99, "over")
+        elif (p99 < self.low * self.deadline_ns and self.index > 0
+              and len(self.window) == self.window.maxlen):
+            self._change(self.index - 1, p99, "under")
+
+    def _change(self, index, p99, why):
+        verb = "down" if index > self.index else "up"
+        self.index = index
+        self.changes += 1
+        self.window.clear()
+        level = self.level
+        syslog.syslog(syslog.LOG_NOTICE if verb == "down" else syslog.LOG_INFO,
+                      f"Adaptive: step {verb} to level {index} (p99 {p99 / 1e6:.2f} ms {why} "
+                      f"{(self.high if verb == 'down' else self.low) * 100:g}% of {self.deadline_ns / 1e6:.1f} ms "
+                      f"deadline): scale {level.scale:g}, scale factor {level.scale_factor:g}, "
+                      f"every {level.every} frames")
+
+
+class ScaledDetector:
+    """Runs a backend at the controller's current resolution and pyramid step."""
+
+    def __init__(self, detector, controller):
+        self.detector = detector
+        self.controller = controller
+        self.name = detector.name + "+adaptive"
+        self.preprocess = getattr(detector, "preprocess", None)
+
+    def __call__(self, image, roi=None, min_size=MIN_SIZE, max_size=None):
+        level = self.controller.level
+        if level.scale == 1.0:
+            return self.detector(image, roi, min_size, max_size, scale_factor=level.scale_factor)
+
+        region, dx, dy = crop(image, roi)
+        if region.size == 0:
+            return []
+        s = level.scale
+        small = cv2.resize(region, None, fx=s, fy=s, interpolation=cv2.INTER_AREA)
+        # Sizes scale with the image, down to half of MIN_SIZE; smaller boxes are mostly false positives.
+        small_min = (max(MIN_SIZE[0] // 2, int(min_size[0] * s)), max(MIN_SIZE[1] // 2, int(min_size[1] * s)))
+        small_max = (int(max_size[0] * s), int(max_size[1] * s)) if max_size else None
+        boxes = self.detector(small, None, small_min, small_max, scale_factor=level.scale_factor)
+        return [(int(x / s) + dx, int(y / s) + dy, int(w / s), int(h / s)) for (x, y, w, h) in boxes]
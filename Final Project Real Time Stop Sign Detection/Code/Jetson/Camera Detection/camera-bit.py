@@ -1,103 +1,189 @@
-"""
-STOP SIGN DETECTION BOT
-
-This script captures video frames and uses OpenCV to detect stop signs. For each frame processed,
-it measures and logs the time taken to process the frame. Detected stop signs trigger a message sent
-over UART to a TIVA board, indicating the detection status, which is part of the STOP SIGN DETECTION BOT system.
-After processing all frames or upon termination, it logs the average and worst-case computation times.
-
-Authors: Kiran Jojare, Ayswariya Kannan
-Subject: ECEN 5623 Real-Time Embedded Systems
-Professor: Tim Scherr
-University: University of Colorado Boulder
-References:
-    - https://github.com/maurehur/Stop-Sign-detection_OpenCV
-    - https://devpost.com/software/stop-sign-detection
-
-This code is part of an academic project under the Real-Time Embedded Systems course at the University
-of Colorado Boulder, focusing on the practical application of real-time concepts in embedded systems
-and the integration with embedded hardware like the TIVA board for real-world applications.
-"""
-
-import cv2
-import numpy as np
-import time
-import syslog
-import serial
-
-# Configure the serial port
-ser = serial.Serial(
-    port="/dev/ttyTHS1",
-    baudrate=115200,
-    parity=serial.PARITY_NONE,
-    stopbits=serial.STOPBITS_ONE,
-    bytesize=serial.EIGHTBITS,
-)
-
-# Load stop sign detection classifier
-stop_sign_cascade = cv2.CascadeClassifier("/home/rtes/Desktop/cascade_stop_sign.xml")
-
-# Configure the video capture
-cap = cv2.VideoCapture(0)
-cap.set(3, 640)
-cap.set(4, 480)
-
-# Initialize previous detection state
-prev_detected = False
-
-# List to store computation times
-frame_times = []
-
-try:
-    while True:
-        start_time = time.time()  # Start time of the frame processing
-
-        # Read frame from camera
-        ret, frame = cap.read()
-        if not ret:
-            break
-
-        # Convert frame to grayscale
-        gray = cv2.cvtColor(frame, cv2.COLOR_BGR2GRAY)
-        # Detect stop signs
-        stop_signs = stop_sign_cascade.detectMultiScale(gray, scaleFactor=1.1, minNeighbors=5, minSize=(30, 30))
-
-        # Determine detection status
-        detected = len(stop_signs) > 0
-
-        # Log detection
-        if detected:
-            syslog.syslog(syslog.LOG_INFO, "Stop sign detected")
-
-        # Send data over UART when detection status changes
-        if detected != prev_detected:
-            data_packet = bytes([0xAA] * 8) if detected else bytes([0x00] * 8)
-            ser.write(data_packet)
-            syslog.syslog(syslog.LOG_INFO, f"Sent {'0xAA' if detected else '0x00'} packet over UART")
-            prev_detected = detected
-
-        # Display detected stop signs
-        for (x, y, w, h) in stop_signs:
-            cv2.rectangle(frame, (x, y), (x + w, y + h), (255, 0, 0), 2)
-        cv2.imshow("Frame", frame)
-
-        end_time = time.time()  # End time of the frame processing
-        frame_time = end_time - start_time
-        frame_times.append(frame_time)  # Append frame processing time
-        syslog.syslog(syslog.LOG_INFO, f"Frame Computation Time: {frame_time:.4f} seconds")
-
-        if cv2.waitKey(1) & 0xFF == ord('q'):
-            break
-
-finally:
-    # Cleanup
-    cap.release()
-    cv2.destroyAllWindows()
-
-    # Calculate average and worst case execution times
-    if frame_times:
-        average_time = sum(frame_times) / len(frame_times)
-        worst_case_time = max(frame_times)
-        syslog.syslog(syslog.LOG_INFO, f"Average Frame Computation Time: {average_time:.4f} seconds")
-        syslog.syslog(syslog.LOG_INFO, f"Worst Case Frame Computation Time: {worst_case_time:.4f} seconds")
-
+"""
+STOP SIGN DETECTION BOT
+
+This script captures video frames and uses OpenCV to detect stop signs, on the Jetson's GPU when OpenCV
+was built with CUDA (see detectors.py). Capture, detection and UART transmission run as a pipeline of
+threads (see pipeline.py), each optionally pinned to its own core with a SCHED_FIFO priority. The local
+window is optional: in the field it runs headless, or streams a low-priority MJPEG preview (see
+preview.py). Detected stop signs trigger a message sent over UART to a TIVA board, indicating the
+detection status, which is part of the STOP SIGN DETECTION BOT system. Stage latencies and the age of
+each frame when its result goes out are kept in fixed-size histograms (see latency_hist.py), with
+p50/p99/p99.9/max summaries written to syslog periodically and once more over the whole run at exit. The
+TIVA acknowledges every motor command it carries out, so the latency from frame capture to the motor
+GPIO write is measured too (see e2e_latency.py; e2e_report.py summarises its --e2e-log files). When the
+p99 frame time approaches the frame deadline, the detector steps down its resolution, pyramid depth and
+frame rate, and back up once there is slack again (see adaptive.py).
+
+Authors: Kiran Jojare, Ayswariya Kannan
+Subject: ECEN 5623 Real-Time Embedded Systems
+Professor: Tim Scherr
+University: University of Colorado Boulder
+References:
+    - https://github.com/maurehur/Stop-Sign-detection_OpenCV
+    - https://devpost.com/software/stop-sign-detection
+
+This code is part of an academic project under the Real-Time Embedded Systems course at the University
+of Colorado Boulder, focusing on the practical application of real-time concepts in embedded systems
+and the integration with embedded hardware like the TIVA board for real-world applications.
+"""
+
+import argparse
+import os
+import signal
+import threading
+import time
+import syslog
+
+import serial
+
+from adaptive import DeadlineController
+from capture import BACKENDS as CAPTURE_BACKENDS, open_capture
+from detectors import BACKENDS, make_detector
+from e2e_latency import LinkMonitor
+from latency_hist import LatencyHistogram, LatencyReporter
+from pipeline import CaptureStage, DetectStage, LatestQueue, TransmitStage
+from preview import MODES as PREVIEW_MODES, MjpegPreview, NoPreview, WindowPreview
+from uart_link import DetectionLink
+
+parser = argparse.ArgumentParser(description="Stop sign detector")
+parser.add_argument("--capture", choices=CAPTURE_BACKENDS, default="v4l2", help="capture backend (see capture.py)")
+parser.add_argument("--gst", help="GStreamer pipeline for --capture gst, ending in appsink")
+parser.add_argument("--device", type=int, default=0, help="camera index, /dev/videoN or CSI sensor id")
+parser.add_argument("--width", type=int, default=640)
+parser.add_argument("--height", type=int, default=480)
+parser.add_argument("--fps", type=int, default=30)
+parser.add_argument("--detector", choices=BACKENDS, default="auto", help="detector backend (see detectors.py)")
+parser.add_argument("--cascade", default="/home/rtes/Desktop/cascade_stop_sign.xml", help="stop sign cascade file")
+parser.add_argument("--track", type=int, default=15, metavar="N",
+                    help="track between full-frame scans, with a full scan at least every N frames (0: always scan)")
+parser.add_argument("--deadline-ms", type=float, default=None, metavar="MS",
+                    help="capture to result deadline for adaptive scaling (default: one frame period; 0: fixed)")
+parser.add_argument("--preview", choices=PREVIEW_MODES, default="auto",
+                    help="window, mjpeg stream, or none (headless); auto picks window only when $DISPLAY is set")
+parser.add_argument("--preview-every", type=int, default=None, metavar="N", help="preview every Nth frame")
+parser.add_argument("--preview-port", type=int, default=8080, help="HTTP port of the mjpeg preview")
+parser.add_argument("--report-every", type=float, default=10.0, metavar="S",
+                    help="seconds between latency summaries in syslog")
+parser.add_argument("--sync-every", type=float, default=0.5, metavar="S",
+                    help="seconds between clock sync requests to the TIVA (0: no actuation latency measurement)")
+parser.add_argument("--e2e-log", metavar="CSV", help="append every actuation acknowledgement to this CSV file")
+parser.add_argument("--service", action="append", default=[], metavar="ID=on|off",
+                    help="ask the TIVA to enable or disable optional sequenced service ID, subject to its admission control "
+                         "(repeatable; the reply is logged when --sync-every is not 0)")
+parser.add_argument("--link-trace", metavar="FILE", help="record every frame sent to the TIVA, for replay in host_sim")
+parser.add_argument("--cpus", default="1,2,3", help="cores for capture,detect,transmit; '-' leaves one unpinned")
+parser.add_argument("--fifo", default="50,40,60", help="SCHED_FIFO priorities for capture,detect,transmit; '-' for none")
+args = parser.parse_args()
+
+
+def per_stage(option):
+    """Splits a capture,detect,transmit option into three ints or None."""
+    values = [None if v.strip() in ("", "-") else int(v) for v in option.split(",")]
+    return (values + [None] * 3)[:3]
+
+
+cpus = per_stage(args.cpus)
+fifo = per_stage(args.fifo)
+
+# Configure the serial port
+ser = serial.Serial(
+    port="/dev/ttyTHS1",
+    baudrate=115200,
+    parity=serial.PARITY_NONE,
+    stopbits=serial.STOPBITS_ONE,
+    bytesize=serial.EIGHTBITS,
+    timeout=0.1,   # The TIVA answers on the same port; reads must not block shutdown
+)
+
+# Framed, CRC-checked detection link to the TIVA (see uart_link.py)
+link_trace = open(args.link_trace, "w") if args.link_trace else None
+link = DetectionLink(ser, trace=link_trace)
+
+# Sequenced services switched on or off for this run
+for request in args.service:
+    service, _, state = request.partition("=")
+    if not service.isdigit() or state not in ("on", "off"):
+        parser.error(f"--service {request}: expected ID=on or ID=off")
+    link.send_service_request(int(service), state == "on")
+
+# Load stop sign detection classifier, on the GPU when there is one, scaled down under deadline pressure
+deadline_ms = 1000.0 / args.fps if args.deadline_ms is None else args.deadline_ms
+controller = DeadlineController(deadline_ms) if deadline_ms > 0 else None
+detect = make_detector(args.detector, args.cascade, track_every=args.track, controller=controller)
+syslog.syslog(syslog.LOG_INFO, f"Detector backend: {detect.name}")
+
+
+# Configure the video capture; the GStreamer backends deliver grayscale frames straight from the hardware converter
+cap = open_capture(args.capture, args.width, args.height, args.fps, args.device, args.gst)
+
+# capture -> detect -> transmit, plus an optional preview fed from its own LatestQueue off the real-time path
+stop = threading.Event()
+signal.signal(signal.SIGTERM, lambda signum, frame: stop.set())
+frames = LatestQueue()
+to_transmit = LatestQueue()
+to_preview = LatestQueue()
+preview_mode = args.preview
+if preview_mode == "auto":
+    preview_mode = "window" if os.environ.get("DISPLAY") else "none"
+if preview_mode == "window":
+    preview = WindowPreview(to_preview, every=args.preview_every or 1)
+elif preview_mode == "mjpeg":
+    preview = MjpegPreview(to_preview, stop, port=args.preview_port, every=args.preview_every or 5)
+else:
+    preview = NoPreview(stop)
+results_to = [to_transmit] if preview_mode == "none" else [to_transmit, to_preview]
+
+# Fixed-size latency histograms per stage, summarised in syslog every --report-every seconds
+histograms = {name: LatencyHistogram(name) for name in ("capture", "preprocess", "detect", "transmit", "end_to_end",
+                                                        "actuation_stop", "actuation_clear")}
+reporter = LatencyReporter(list(histograms.values()), stop, period=args.report_every)
+
+stages = [
+    CaptureStage(cap, frames, stop, cpu=cpus[0], fifo_priority=fifo[0], histograms=histograms),
+    DetectStage(detect, frames, results_to, stop, controller=controller, cpu=cpus[1], fifo_priority=fifo[1],
+                histograms=histograms),
+    TransmitStage(link, to_transmit, stop, cpu=cpus[2], fifo_priority=fifo[2], histograms=histograms),
+]
+# Capture on the Jetson to motor GPIO write on the TIVA, from the TIVA's acknowledgements (see e2e_latency.py)
+if args.sync_every > 0:
+    stages.append(LinkMonitor(link, ser, stop, sync_every=args.sync_every, csv_path=args.e2e_log, histograms=histograms))
+transmit = stages[2]
+start_time = time.perf_counter()
+
+try:
+    for stage in stages:
+        stage.start()
+    reporter.start()
+
+    # The main thread only services the preview (or sleeps when headless) until a stage stops, 'q' or SIGTERM
+    while not stop.is_set():
+        if not preview.poll(0.1):
+            break
+
+except KeyboardInterrupt:
+    pass
+
+finally:
+    # Cleanup
+    stop.set()
+    for stage in stages:
+        if stage.is_alive():
+            stage.join(timeout=1.0)
+    cap.release()
+    preview.close()
+    if link_trace:
+        link_trace.close()
+
+    # Latency percentiles over the whole run, end_to_end being the frame age when the result went out
+    reporter.report_total()
+    if transmit.results:
+        elapsed = time.perf_counter() - start_time
+        syslog.syslog(syslog.LOG_INFO, f"Detection Rate: {transmit.results / elapsed:.1f} fps, "
+                                       f"{frames.dropped} frames skipped by detect, {to_transmit.dropped} results by transmit")
+    if hasattr(detect, "roi_scans"):
+        syslog.syslog(syslog.LOG_INFO, f"Tracking: {detect.full_scans} full scans, {detect.roi_scans} ROI scans, "
+                                       f"{detect.coasted} frames coasted")
+    if controller:
+        syslog.syslog(syslog.LOG_INFO, f"Adaptive: {controller.changes} level changes, ended at level "
+                                       f"{controller.index}, {controller.skipped} frames skipped, "
+                                       f"{controller.misses} deadline misses")
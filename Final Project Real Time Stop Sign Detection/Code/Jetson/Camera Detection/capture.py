@@ -0,0 +1,69 @@
+"""
+CAMERA CAPTURE BACKENDS
+
+    v4l2    cv2.VideoCapture(index) through V4L2; frames arrive as BGR, converted on the CPU
+    csi     nvarguscamerasrc (CSI camera through the ISP) in NVMM memory, then nvvidconv
+    usb     v4l2src (USB camera), then nvvidconv
+    gst     any GStreamer pipeline given with --gst, ending in appsink
+
+For csi and usb, nvvidconv uses the Jetson's VIC hardware converter to pick out the 8-bit luma plane. The only copy
+the CPU makes is into appsink, and the detector gets a grayscale frame directly. That removes the CPU-side BGR
+conversion in VideoCapture and the cvtColor(BGR2GRAY) pass that followed it. appsink keeps a single buffer and drops
+older ones, so the capture queue is latest-frame-wins from the sensor onwards.
+
+If a GStreamer pipeline cannot be opened (for example OpenCV was built without GStreamer), open_capture() logs a
+warning and falls back to v4l2.
+
+Authors: Kiran Jojare, Ayswariya Kannan
+Subject: ECEN 5623 Real-Time Embedded Systems
+University: University of Colorado Boulder
+"""
+
+import syslog
+
+import cv2
+
+BACKENDS = ("v4l2", "csi", "usb", "gst")
+
+APPSINK = "appsink drop=true max-buffers=1 sync=false"
+
+
+def csi_pipeline(width, height, fps, sensor_id=0):
+    return (f"nvarguscamerasrc sensor-id={sensor_id} ! "
+            f"video/x-raw(memory:NVMM),width={width},height={height},framerate={fps}/1,format=NV12 ! "
+            f"nvvidconv ! video/x-raw,format=GRAY8 ! {APPSINK}")
+
+
+def usb_pipeline(width, height, fps, device=0):
+    return (f"v4l2src device=/dev/video{device} io-mode=2 ! "
+            f"video/x-raw,width={width},height={height},framerate={fps}/1 ! "
+            f"nvvidconv ! video/x-raw,format=GRAY8 ! {APPSINK}")
+
+
+def open_v4l2(device, width, height):
+    cap = cv2.VideoCapture(device)
+    cap.set(cv2.CAP_PROP_FRAME_WIDTH, width)
+    cap.set(cv2.CAP_PROP_FRAME_HEIGHT, height)
+    return cap
+
+
+def open_capture(backend, width=640, height=480, fps=30, device=0, pipeline=None):
+    """Returns an opened cv2.VideoCapture for the requested backend, falling back to v4l2."""
+    if backend not in BACKENDS:
+        raise ValueError(f"unknown capture backend {backend!r}")
+    if backend == "v4l2":
+        return open_v4l2(device, width, height)
+
+    if backend == "csi":
+        pipeline = csi_pipeline(width, height, fps, device)
+    elif backend == "usb":
+        pipeline = usb_pipeline(width, height, fps, device)
+    elif not pipeline:
+        raise ValueError("the gst backend needs a pipeline")
+
+    cap = cv2.VideoCapture(pipeline, cv2.CAP_GSTREAMER)
+    if cap.isOpened():
+        syslog.syslog(syslog.LOG_INFO, f"Capture pipeline: {pipeline}")
+        return cap
+    syslog.syslog(syslog.LOG_WARNING, f"Cannot open GStreamer pipeline ({pipeline}), using V4L2")
+    return open_v4l2(device, width, height)
@@ -0,0 +1,227 @@
+"""
+STOP SIGN DETECTOR BACKENDS
+
+Every backend is a callable taking a BGR or grayscale frame and returning a list of (x, y, w, h) boxes, so the
+pipeline does not care where the work runs.
+
+    haar    cv2.CascadeClassifier on the CPU (the original path)
+    cuda    cv2.cuda.CascadeClassifier on the Nano's GPU; the upload, grayscale conversion and cascade all run on
+            the device and only the boxes come back
+    auto    cuda if OpenCV was built with CUDA and sees a device, haar otherwise
+
+make_detector() falls back to haar, with a syslog warning, whenever the CUDA backend cannot be set up (no CUDA build,
+no device, or a cascade file the GPU implementation cannot load).
+
+Both backends can also search just a region of the frame over a limited range of sizes. TrackingDetector uses that to
+detect then track: after a hit it follows the sign with Lucas-Kanade optical flow and only searches a padded region
+around the predicted box, at sizes close to the last one. It goes back to a full scan every N frames, and when the
+sign has been missed for a few frames in a row. Until then it keeps reporting the predicted box, so a single missed
+frame no longer flips the state sent to the TIVA.
+
+Authors: Kiran Jojare, Ayswariya Kannan
+Subject: ECEN 5623 Real-Time Embedded Systems
+University: University of Colorado Boulder
+"""
+
+import syslog
+
+import cv2
+import numpy as np
+
+BACKENDS = ("auto", "haar", "cuda")
+
+SCALE_FACTOR = 1.1
+MIN_NEIGHBORS = 5
+MIN_SIZE = (30, 30)
+
+
+def to_gray(image):
+    return image if image.ndim == 2 else cv2.cvtColor(image, cv2.COLOR_BGR2GRAY)
+
+
+def crop(image, roi):
+    """View of image inside roi = (x, y, w, h), clipped to the frame, and the clipped origin."""
+    if roi is None:
+        return image, 0, 0
+    x, y, w, h = roi
+    x0, y0 = max(0, x), max(0, y)
+    x1, y1 = min(image.shape[1], x + w), min(image.shape[0], y + h)
+    return image[y0:y1, x0:x1], x0, y0
+
+
+def offset_boxes(boxes, dx, dy):
+    return [(int(x) + dx, int(y) + dy, int(w), int(h)) for (x, y, w, h) in boxes]
+
+
+class HaarDetector:
+    """CPU Haar cascade over the full frame."""
+
+    name = "haar"
+    preprocess = staticmethod(to_gray)
+
+    def __init__(self, cascade_path):
+        self.cascade = cv2.CascadeClassifier(cascade_path)
+        if self.cascade.empty():
+            raise RuntimeError(f"cannot load cascade {cascade_path}")
+
+    def __call__(self, image, roi=None, min_size=MIN_SIZE, max_size=None, scale_factor=SCALE_FACTOR):
+        region, dx, dy = crop(to_gray(image), roi)
+        if region.size == 0:
+            return []
+        boxes = self.cascade.detectMultiScale(region, scaleFactor=scale_factor, minNeighbors=MIN_NEIGHBORS,
+                                              minSize=min_size, maxSize=max_size or ())
+        return offset_boxes(boxes, dx, dy)
+
+
+class CudaHaarDetector:
+    """The same cascade on the GPU. The device buffers are allocated once and reused for every frame."""
+
+    name = "cuda"
+    preprocess = None           # Grayscale conversion happens on the device, inside detect
+
+    def __init__(self, cascade_path):
+        if cuda_device_count() == 0:
+            raise RuntimeError("no CUDA device")
+        self.cascade = cv2.cuda.CascadeClassifier_create(cascade_path)
+        self.cascade.setScaleFactor(SCALE_FACTOR)
+        self.cascade.setMinNeighbors(MIN_NEIGHBORS)
+        self.cascade.setMinObjectSize(MIN_SIZE)
+        self.frame = cv2.cuda_GpuMat()
+        self.gray = cv2.cuda_GpuMat()
+        self.objects = cv2.cuda_GpuMat()
+
+    def __call__(self, image, roi=None, min_size=MIN_SIZE, max_size=None, scale_factor=SCALE_FACTOR):
+        # Only the region is uploaded; a tracked search moves a fraction of the frame.
+        region, dx, dy = crop(image, roi)
+        if region.size == 0:
+            return []
+        self.frame.upload(np.ascontiguousarray(region))
+        if region.ndim == 2:
+            gray = self.frame
+        else:
+            cv2.cuda.cvtColor(self.frame, cv2.COLOR_BGR2GRAY, self.gray)
+            gray = self.gray
+        self.cascade.setScaleFactor(scale_factor)
+        self.cascade.setMinObjectSize(min_size)
+        self.cascade.setMaxObjectSize(max_size or (0, 0))
+        self.objects = self.cascade.detectMultiScale(gray, self.objects)
+        return offset_boxes(self.cascade.convert(self.objects), dx, dy)
+
+
+class TrackingDetector:
+    """Detect then track on top of another backend; see the module docstring."""
+
+    preprocess = staticmethod(to_gray)      # Optical flow needs the grayscale frame on the CPU anyway
+
+    def __init__(self, detector, full_scan_every=15, max_misses=3, pad=0.5, scale_range=(0.75, 1.33)):
+        self.detector = detector
+        self.name = f"{detector.name}+track"
+        self.full_scan_every = full_scan_every
+        self.max_misses = max_misses
+        self.pad = pad
+        self.scale_range = scale_range
+        self.box = None
+        self.prev_gray = None
+        self.misses = 0
+        self.since_full_scan = 0
+        self.full_scans = 0
+        self.roi_scans = 0
+        self.coasted = 0
+
+    def __call__(self, image):
+        gray = to_gray(image)
+        self.since_full_scan += 1
+
+        if self.box is None or self.since_full_scan >= self.full_scan_every:
+            self.since_full_scan = 0
+            self.full_scans += 1
+            predicted = self._predict(gray) if self.box is not None else None
+            boxes = self.detector(gray)
+        else:
+            predicted = self._predict(gray)
+            min_size, max_size, roi = self._search_window(predicted)
+            self.roi_scans += 1
+            boxes = self.detector(gray, roi=roi, min_size=min_size, max_size=max_size)
+
+        self.prev_gray = gray
+        if boxes:
+            self.box = closest(boxes, predicted) if predicted is not None else max(boxes, key=lambda b: b[2] * b[3])
+            self.misses = 0
+            return boxes
+        if self.box is not None and self.misses < self.max_misses:
+            # Coast on the prediction for a few frames instead of reporting a clear straight away.
+            self.misses += 1
+            self.coasted += 1
+            self.box = predicted
+            return [predicted]
+        self.box = None
+        self.misses = 0
+        return []
+
+    def _predict(self, gray):
+        """Last box moved by the median optical flow of corners inside it (unmoved if flow fails)."""
+        x, y, w, h = self.box
+        if self.prev_gray is None or self.prev_gray.shape != gray.shape:
+            return self.box
+        region, dx, dy = crop(self.prev_gray, self.box)
+        if region.size == 0:
+            return self.box
+        corners = cv2.goodFeaturesToTrack(region, maxCorners=30, qualityLevel=0.01, minDistance=3)
+        if corners is None or len(corners) < 4:
+            return self.box
+        corners = corners + np.float32([dx, dy])
+        moved, status, _ = cv2.calcOpticalFlowPyrLK(self.prev_gray, gray, corners, None, winSize=(15, 15), maxLevel=2)
+        good = status.ravel() == 1
+        if good.sum() < 4:
+            return self.box
+        shift = np.median((moved - corners).reshape(-1, 2)[good], axis=0)
+        return (int(round(x + shift[0])), int(round(y + shift[1])), w, h)
+
+    def _search_window(self, box):
+        x, y, w, h = box
+        lo, hi = self.scale_range
+        min_size = (max(MIN_SIZE[0], int(w * lo)), max(MIN_SIZE[1], int(h * lo)))
+        max_size = (int(w * hi) + 1, int(h * hi) + 1)
+        margin = int(max(w, h) * self.pad)
+        roi = (x - margin, y - margin, w + 2 * margin, h + 2 * margin)
+        return min_size, max_size, roi
+
+
+def closest(boxes, box):
+    """Box whose centre is nearest to the centre of box."""
+    cx, cy = box[0] + box[2] / 2, box[1] + box[3] / 2
+    return min(boxes, key=lambda b: (b[0] + b[2] / 2 - cx) ** 2 + (b[1] + b[3] / 2 - cy) ** 2)
+
+
+def cuda_device_count():
+    try:
+        return cv2.cuda.getCudaEnabledDeviceCount()
+    except (AttributeError, cv2.error):
+        return 0
+
+
+def make_detector(backend, cascade_path, track_every=0, controller=None):
+    """
+    Returns a detector for the requested backend, falling back to the CPU cascade if the GPU one is unavailable.
+    With a DeadlineController (adaptive.py) the backend searches at the controller's current resolution and
+    pyramid step. With track_every > 0 it is wrapped in a TrackingDetector doing a full scan at least every
+    track_every frames.
+    """
+    detector = _make_backend(backend, cascade_path)
+    if controller is not None:
+        from adaptive import ScaledDetector
+        detector = ScaledDetector(detector, controller)
+    return TrackingDetector(detector, full_scan_every=track_every) if track_every > 0 else detector
+
+
+def _make_backend(backend, cascade_path):
+    if backend not in BACKENDS:
+        raise ValueError(f"unknown detector backend {backend!r}")
+    if backend == "auto":
+        backend = "cuda" if cuda_device_count() > 0 else "haar"
+    if backend == "cuda":
+        try:
+            return CudaHaarDetector(cascade_path)
+        except (AttributeError, RuntimeError, cv2.error) as e:
+            syslog.syslog(syslog.LOG_WARNING, f"CUDA detector unavailable ({e}), using the CPU cascade")
+    return HaarDetector(cascade_path)
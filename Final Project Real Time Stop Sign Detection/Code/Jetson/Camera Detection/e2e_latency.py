@@ -0,0 +1,143 @@
+"""
+END-TO-END DETECTION TO ACTUATION LATENCY
+
+Every detection frame sent to the TIVA carries the perf_counter time (in microseconds) at which its camera frame was
+captured. When a motor service acts on it, the TIVA sends an acknowledgement back over UART2 TX. The acknowledgement
+carries that capture time, the TIVA time the frame was decoded, and the TIVA time of the motor GPIO write.
+
+To put the TIVA times on the Jetson's clock, LinkMonitor sends a sync request every sync period. It then computes the
+offset NTP style from the four stamps of each exchange:
+
+    t1 Jetson send, t2 TIVA receive, t3 TIVA reply, t4 Jetson receive
+    offset = ((t2 - t1) + (t3 - t4)) / 2        round trip = (t4 - t1) - (t3 - t2)
+
+Of the last few exchanges, the one with the lowest round trip is used. Delays on the two sides of the link are the
+least asymmetric (and the TIVA's receive stamp the most prompt) on that one. All stamps are 32-bit microseconds and
+differences are taken modulo 2^32.
+
+Each acknowledgement then gives capture -> TIVA receive -> motor write, in Jetson time. Results are recorded in a
+LatencyHistogram per command and optionally appended to a CSV file; e2e_report.py summarises such files.
+
+Authors: Kiran Jojare, Ayswariya Kannan
+Subject: ECEN 5623 Real-Time Embedded Systems
+University: University of Colorado Boulder
+"""
+
+import syslog
+import time
+
+from pipeline import Stage
+from uart_link import (ADMISSION_NO_CULPRIT, ADMISSION_RESULTS, DETECTION_STOP, Actuation, FrameParser,
+                       ServiceReply, SyncReply, decode_message)
+
+CSV_HEADER = ("link_seq,state,service,capture_us,tiva_rx_us,actuated_us,offset_us,rtt_us,"
+              "capture_to_rx_us,rx_to_actuation_us,end_to_end_us")
+
+SERVICE_NAMES = {1: "Motor1Service2", 2: "Motor2Service3", 0xFF: "UART1 ISR fast path"}
+
+
+def now_us():
+    return time.perf_counter_ns() // 1000
+
+
+def diff32(a, b):
+    """a - b for 32-bit wrapping counters, as a signed value."""
+    d = (a - b) & 0xFFFFFFFF
+    return d - (1 << 32) if d >= (1 << 31) else d
+
+
+class ClockSync:
+    """Offset of the TIVA clock from the Jetson's, from the lowest round trip of the last window exchanges."""
+
+    def __init__(self, window=5):
+        self.window = window
+        self.samples = []       # (rtt, offset)
+        self.offset = None
+        self.rtt = None
+
+    def add(self, reply, t4):
+        rtt = diff32(t4, reply.t1) - diff32(reply.t3, reply.t2)
+        offset = (diff32(reply.t2, reply.t1) + diff32(reply.t3, t4)) / 2
+        if rtt < 0:
+            return
+        self.samples = (self.samples + [(rtt, offset)])[-self.window:]
+        self.rtt, self.offset = min(self.samples)
+
+    def to_jetson(self, tiva_us):
+        return (tiva_us - int(round(self.offset))) & 0xFFFFFFFF
+
+
+class LinkMonitor(Stage):
+    """Reads the TIVA -> Jetson direction of the link: clock sync replies, actuation acknowledgements and
+    admission control replies."""
+
+    def __init__(self, link, port, stop_event, sync_every=0.5, csv_path=None, **kw):
+        super().__init__("link-rx", stop_event, **kw)
+        self.link = link
+        self.port = port
+        self.sync_every = sync_every
+        self.parser = FrameParser()
+        self.clock = ClockSync()
+        self.pending = {}       # request id -> t1
+        self.request = 0
+        self.next_sync = 0.0
+        self.actuations = 0
+        self.unsynced = 0
+        self.csv = None
+        if csv_path:
+            self.csv = open(csv_path, "a", buffering=1)
+            if self.csv.tell() == 0:
+                self.csv.write(CSV_HEADER + "\n")
+
+    def step(self):
+        if time.monotonic() >= self.next_sync:
+            self.next_sync = time.monotonic() + self.sync_every
+            self.request = (self.request + 1) & 0xFF
+            t1 = now_us() & 0xFFFFFFFF
+            self.pending[self.request] = t1
+            self.link.send_sync(self.request, t1)
+
+        data = self.port.read(max(1, self.port.in_waiting))
+        t4 = now_us() & 0xFFFFFFFF
+        for _, payload in self.parser.feed(data):
+            msg = decode_message(payload)
+            if isinstance(msg, SyncReply):
+                if self.pending.pop(msg.request, None) == msg.t1:
+                    self.clock.add(msg, t4)
+            elif isinstance(msg, Actuation):
+                self.on_actuation(msg)
+            elif isinstance(msg, ServiceReply):
+                self.on_service_reply(msg)
+        return True
+
+    def on_service_reply(self, reply):
+        verdict = ADMISSION_RESULTS.get(reply.result, reply.result)
+        culprit = "" if reply.culprit == ADMISSION_NO_CULPRIT else f", service {reply.culprit} would miss its deadline"
+        bound = f", response time bound {reply.bound_us / 1000:.2f} ms" if reply.bound_us else ""
+        syslog.syslog(syslog.LOG_INFO, f"{'Enable' if reply.enable else 'Disable'} service {reply.service}: "
+                                       f"{verdict}{culprit}{bound}")
+
+    def on_actuation(self, ack):
+        if self.clock.offset is None or ack.capture_us == 0:
+            self.unsynced += 1
+            return
+        rx = self.clock.to_jetson(ack.rx_us)
+        actuated = self.clock.to_jetson(ack.actuated_us)
+        to_rx = diff32(rx, ack.capture_us)
+        to_act = diff32(actuated, rx)
+        total = diff32(actuated, ack.capture_us)
+        stop = ack.state == DETECTION_STOP
+        self.actuations += 1
+        self.record("actuation_stop" if stop else "actuation_clear", max(total, 0) * 1000)
+
+        syslog.syslog(syslog.LOG_INFO, f"Actuation {'STOP' if stop else 'CLEAR'} frame {ack.seq} by "
+                                       f"{SERVICE_NAMES.get(ack.service, ack.service)}: {total / 1000:.2f} ms "
+                                       f"from capture (to TIVA {to_rx / 1000:.2f}, to motor {to_act / 1000:.2f}, "
+                                       f"sync rtt {self.clock.rtt / 1000:.2f} ms)")
+        if self.csv:
+            self.csv.write(f"{ack.seq},{'stop' if stop else 'clear'},{ack.service},{ack.capture_us},{rx},{actuated},"
+                           f"{self.clock.offset:.1f},{self.clock.rtt},{to_rx},{to_act},{total}\n")
+
+    def finish(self):
+        if self.csv:
+            self.csv.close()
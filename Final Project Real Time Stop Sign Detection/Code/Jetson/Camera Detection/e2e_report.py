@@ -0,0 +1,67 @@
+"""
+END-TO-END LATENCY REPORT
+
+Summarises the CSV files written by camera-bit.py --e2e-log: for every command (STOP, CLEAR) and motor service, the
+distribution of frame capture -> TIVA receive -> motor GPIO write latency.
+
+    python3 e2e_report.py e2e.csv [more.csv ...]
+
+Authors: Kiran Jojare, Ayswariya Kannan
+Subject: ECEN 5623 Real-Time Embedded Systems
+University: University of Colorado Boulder
+"""
+
+import csv
+import sys
+
+from e2e_latency import SERVICE_NAMES
+
+PERCENTILES = (0.50, 0.90, 0.99, 0.999)
+COLUMNS = (("end_to_end_us", "capture -> motor"), ("capture_to_rx_us", "capture -> TIVA rx"),
+           ("rx_to_actuation_us", "TIVA rx -> motor"))
+
+
+def percentile(values, q):
+    """Nearest-rank percentile of a sorted list."""
+    rank = max(1, int(q * len(values) + 0.999999))
+    return values[min(rank, len(values)) - 1]
+
+
+def load(paths):
+    rows = []
+    for path in paths:
+        with open(path, newline="") as f:
+            rows.extend(csv.DictReader(f))
+    return rows
+
+
+def report(rows, out=sys.stdout):
+    groups = {}
+    for row in rows:
+        groups.setdefault((row["state"], int(row["service"])), []).append(row)
+
+    header = f"{'':20} {'n':>6} {'min':>8} " + " ".join(f"{'p%g' % (q * 100):>8}" for q in PERCENTILES) + f" {'max':>8}"
+    for (state, service), group in sorted(groups.items()):
+        print(f"{state.upper()} by {SERVICE_NAMES.get(service, service)} (ms)", file=out)
+        print(header, file=out)
+        for column, label in COLUMNS + (("rtt_us", "sync round trip"),):
+            values = sorted(int(row[column]) / 1000 for row in group)
+            cells = " ".join(f"{percentile(values, q):8.2f}" for q in PERCENTILES)
+            print(f"{label:20} {len(values):6} {values[0]:8.2f} {cells} {values[-1]:8.2f}", file=out)
+        print(file=out)
+
+
+def main(argv):
+    if len(argv) < 2:
+        print("usage: e2e_report.py e2e.csv [more.csv ...]", file=sys.stderr)
+        return 2
+    rows = load(argv[1:])
+    if not rows:
+        print("no actuation records", file=sys.stderr)
+        return 1
+    report(rows)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
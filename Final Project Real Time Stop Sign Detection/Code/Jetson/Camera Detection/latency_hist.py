@@ -0,0 +1,126 @@
+"""
+LATENCY HISTOGRAMS
+
+Fixed memory, HDR-style latency histograms for the detector stages. Each histogram has a few thousand integer
+buckets, however long the bot runs, and never needs a per-event syslog line.
+
+Values are in nanoseconds, taken from time.perf_counter_ns(). Values below 2^SUB_BITS ns get one bucket each. Above
+that, every power of two is split into 2^(SUB_BITS-1) equal buckets, so any value is reported within 1/128 (0.8%)
+of the truth. Percentiles report the highest value that falls into their bucket, so tails are never understated.
+Anything past MAX_NS goes into the last bucket; the exact maximum is kept separately.
+
+Each histogram has a single writer (the stage that owns it). LatencyReporter reads all of them from its own thread.
+Every period seconds it writes one syslog line per stage, covering only what was recorded since the previous report.
+
+Authors: Kiran Jojare, Ayswariya Kannan
+Subject: ECEN 5623 Real-Time Embedded Systems
+University: University of Colorado Boulder
+"""
+
+import syslog
+import threading
+
+SUB_BITS = 8
+HALF = 1 << (SUB_BITS - 1)
+MAX_NS = 1 << 36                # About 69 s
+BUCKETS = (MAX_NS.bit_length() - SUB_BITS + 1) * HALF
+
+PERCENTILES = (0.50, 0.99, 0.999)
+
+
+def bucket_index(value):
+    if value < (1 << SUB_BITS):
+        return max(value, 0)
+    if value >= MAX_NS:
+        return BUCKETS - 1
+    shift = value.bit_length() - SUB_BITS
+    return shift * HALF + (value >> shift)
+
+
+def bucket_high(index):
+    """Highest value that lands in bucket index."""
+    if index < (1 << SUB_BITS):
+        return index
+    shift = index // HALF - 1
+    return ((index % HALF + HALF) << shift) + (1 << shift) - 1
+
+
+class LatencyHistogram:
+    def __init__(self, name):
+        self.name = name
+        self.counts = [0] * BUCKETS
+        self.count = 0
+        self.total = 0
+        self.max = 0
+
+    def record(self, value_ns):
+        self.counts[bucket_index(value_ns)] += 1
+        self.count += 1
+        self.total += value_ns
+        if value_ns > self.max:
+            self.max = value_ns
+
+    def snapshot(self):
+        return Snapshot(list(self.counts), self.count, self.total, self.max)
+
+
+class Snapshot:
+    """Frozen copy of a histogram; subtracting an older snapshot gives the interval between them."""
+
+    def __init__(self, counts, count, total, max_ns):
+        self.counts = counts
+        self.count = count
+        self.total = total
+        self.max = max_ns
+
+    def __sub__(self, older):
+        counts = [a - b for a, b in zip(self.counts, older.counts)]
+        high = max((i for i, c in enumerate(counts) if c), default=0)
+        # The exact maximum is only known since start; the interval one is its bucket's upper edge.
+        return Snapshot(counts, self.count - older.count, self.total - older.total, min(bucket_high(high), self.max))
+
+    def percentile(self, q):
+        if self.count == 0:
+            return 0
+        target = max(1, int(q * self.count + 0.999999))
+        seen = 0
+        for i, c in enumerate(self.counts):
+            seen += c
+            if seen >= target:
+                return min(bucket_high(i), self.max)
+        return self.max
+
+    def mean(self):
+        return self.total / self.count if self.count else 0.0
+
+    def summary(self, name):
+        if self.count == 0:
+            return f"Latency {name}: no samples"
+        parts = " ".join(f"p{q * 100:g}={self.percentile(q) / 1e6:.2f}" for q in PERCENTILES)
+        return f"Latency {name}: n={self.count} mean={self.mean() / 1e6:.2f} {parts} max={self.max / 1e6:.2f} ms"
+
+
+class LatencyReporter(threading.Thread):
+    """Writes one syslog summary line per histogram every period seconds, covering that interval only."""
+
+    def __init__(self, histograms, stop_event, period=10.0):
+        super().__init__(name="latency", daemon=True)
+        self.histograms = histograms
+        self.stop_event = stop_event
+        self.period = period
+        self.last = [h.snapshot() for h in histograms]
+
+    def run(self):
+        while not self.stop_event.wait(self.period):
+            self.report()
+
+    def report(self):
+        for i, h in enumerate(self.histograms):
+            now = h.snapshot()
+            syslog.syslog(syslog.LOG_INFO, (now - self.last[i]).summary(h.name))
+            self.last[i] = now
+
+    def report_total(self):
+        """Summary since start, once, at exit."""
+        for h in self.histograms:
+            syslog.syslog(syslog.LOG_INFO, h.snapshot().summary(h.name + " (total)"))
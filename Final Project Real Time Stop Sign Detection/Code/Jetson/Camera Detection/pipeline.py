@@ -0,0 +1,231 @@
+"""
+DETECTOR PIPELINE
+
+Capture, detection and transmission run as separate threads so the frame time is set by the slowest stage instead
+of the sum of all of them. Stages hand work to each other through LatestQueue: a bounded queue that drops the oldest
+item when full, so a slow consumer always gets the newest frame and never works through a backlog of stale ones.
+
+Every frame carries the perf_counter_ns() time it was captured at. The number we bound is the age of a frame when its
+detection result goes out over UART, not the time any one stage takes. Each stage records its own latency, and the
+transmit stage that end-to-end age, into a LatencyHistogram (see latency_hist.py).
+
+OpenCV releases the GIL inside VideoCapture.read() and detectMultiScale(), so the stages really do overlap. Each
+stage can be pinned to a core and given a SCHED_FIFO priority (Linux only, needs root or CAP_SYS_NICE).
+
+Authors: Kiran Jojare, Ayswariya Kannan
+Subject: ECEN 5623 Real-Time Embedded Systems
+University: University of Colorado Boulder
+"""
+
+import os
+import syslog
+import threading
+import time
+
+
+class Frame:
+    """One captured image and when it was taken."""
+
+    __slots__ = ("seq", "t_capture", "image")
+
+    def __init__(self, seq, t_capture, image):
+        self.seq = seq
+        self.t_capture = t_capture
+        self.image = image
+
+
+class Detection:
+    """Detection result for one frame."""
+
+    __slots__ = ("frame", "boxes", "t_detected")
+
+    def __init__(self, frame, boxes, t_detected):
+        self.frame = frame
+        self.boxes = boxes
+        self.t_detected = t_detected
+
+    @property
+    def detected(self):
+        return len(self.boxes) > 0
+
+
+class LatestQueue:
+    """Bounded queue where put() never blocks: when full, the oldest item is dropped (latest frame wins)."""
+
+    def __init__(self, depth=1):
+        self.depth = depth
+        self.dropped = 0
+        self._items = []
+        self._closed = False
+        self._cond = threading.Condition()
+
+    def put(self, item):
+        with self._cond:
+            if len(self._items) >= self.depth:
+                self._items.pop(0)
+                self.dropped += 1
+            self._items.append(item)
+            self._cond.notify()
+
+    def get(self, timeout=None):
+        """Oldest queued item, or None on timeout or once the queue is closed and empty."""
+        with self._cond:
+            if not self._items and not self._closed:
+                self._cond.wait(timeout)
+            return self._items.pop(0) if self._items else None
+
+    @property
+    def closed(self):
+        return self._closed
+
+    def close(self):
+        """Wakes every consumer; get() returns None once the queue has drained."""
+        with self._cond:
+            self._closed = True
+            self._cond.notify_all()
+
+
+def configure_thread(name, cpu=None, fifo_priority=None):
+    """Pins the calling thread to one core and/or makes it SCHED_FIFO. Failures are logged, not fatal."""
+    # On Linux both calls with pid 0 apply to the calling thread only.
+    if cpu is not None:
+        try:
+            os.sched_setaffinity(0, {cpu})
+        except (AttributeError, OSError) as e:
+            syslog.syslog(syslog.LOG_WARNING, f"{name}: cannot pin to CPU {cpu}: {e}")
+    if fifo_priority is not None:
+        try:
+            os.sched_setscheduler(0, os.SCHED_FIFO, os.sched_param(fifo_priority))
+        except (AttributeError, OSError) as e:
+            syslog.syslog(syslog.LOG_WARNING, f"{name}: cannot set SCHED_FIFO {fifo_priority}: {e}")
+
+
+class Stage(threading.Thread):
+    """Base class of the pipeline threads. Subclasses implement step(), which returns False to stop the pipeline."""
+
+    def __init__(self, name, stop_event, cpu=None, fifo_priority=None, histograms=None):
+        super().__init__(name=name, daemon=True)
+        self.histograms = histograms or {}
+        self.stop_event = stop_event
+        self.cpu = cpu
+        self.fifo_priority = fifo_priority
+
+    def run(self):
+        configure_thread(self.name, self.cpu, self.fifo_priority)
+        try:
+            while not self.stop_event.is_set():
+                if self.step() is False:
+                    break
+        except Exception as e:
+            syslog.syslog(syslog.LOG_ERR, f"{self.name}: {e!r}")
+        finally:
+            self.stop_event.set()
+            self.finish()
+
+    def step(self):
+        raise NotImplementedError
+
+    def record(self, name, value_ns):
+        h = self.histograms.get(name)
+        if h is not None:
+            h.record(value_ns)
+
+    def finish(self):
+        pass
+
+
+class CaptureStage(Stage):
+    """Reads frames as fast as the camera delivers them into a LatestQueue."""
+
+    def __init__(self, cap, out_queue, stop_event, **kw):
+        super().__init__("capture", stop_event, **kw)
+        self.cap = cap
+        self.out_queue = out_queue
+        self.seq = 0
+
+    def step(self):
+        t0 = time.perf_counter_ns()
+        ret, image = self.cap.read()
+        if not ret:
+            return False
+        t1 = time.perf_counter_ns()
+        self.record("capture", t1 - t0)
+        self.out_queue.put(Frame(self.seq, t1, image))
+        self.seq += 1
+        return True
+
+    def finish(self):
+        self.out_queue.close()
+
+
+class DetectStage(Stage):
+    """
+    Runs detect(image) -> list of (x, y, w, h) on the newest frame and publishes the result. detect.preprocess(image),
+    if the detector has one, is run and timed separately first. With a controller (adaptive.py), frames it does not
+    admit are dropped unprocessed and the capture to result time of every other frame is fed back to it.
+    """
+
+    def __init__(self, detect, in_queue, out_queues, stop_event, controller=None, **kw):
+        super().__init__("detect", stop_event, **kw)
+        self.detect = detect
+        self.controller = controller
+        self.preprocess = getattr(detect, "preprocess", None)
+        self.in_queue = in_queue
+        self.out_queues = out_queues
+
+    def step(self):
+        frame = self.in_queue.get(timeout=0.1)
+        if frame is None:
+            # Timed out, or the capture stage closed the queue.
+            return not self.in_queue.closed
+        if self.controller and not self.controller.admit(frame.seq):
+            return True
+        t0 = time.perf_counter_ns()
+        image = self.preprocess(frame.image) if self.preprocess else frame.image
+        t1 = time.perf_counter_ns()
+        boxes = self.detect(image)
+        t2 = time.perf_counter_ns()
+        self.record("preprocess", t1 - t0)
+        self.record("detect", t2 - t1)
+        if self.controller:
+            self.controller.observe(t2 - frame.t_capture)
+        result = Detection(frame, boxes, t2)
+        for q in self.out_queues:
+            q.put(result)
+        return True
+
+    def finish(self):
+        for q in self.out_queues:
+            q.close()
+
+
+class TransmitStage(Stage):
+    """Sends a detection frame over UART whenever the detected state changes and records the age of every result."""
+
+    def __init__(self, link, in_queue, stop_event, **kw):
+        super().__init__("transmit", stop_event, **kw)
+        self.link = link
+        self.in_queue = in_queue
+        self.prev_detected = False
+        self.results = 0
+
+    def step(self):
+        result = self.in_queue.get(timeout=0.1)
+        if result is None:
+            return not self.in_queue.closed
+
+        sent = result.detected != self.prev_detected
+        if sent:
+            t0 = time.perf_counter_ns()
+            seq = self.link.send_detection(result.detected, result.frame.t_capture // 1000)
+            self.prev_detected = result.detected
+            self.record("transmit", time.perf_counter_ns() - t0)
+        age_ns = time.perf_counter_ns() - result.frame.t_capture
+        self.record("end_to_end", age_ns)
+        self.results += 1
+
+        # State changes are rare; the per-frame numbers only go into the histograms.
+        if sent:
+            syslog.syslog(syslog.LOG_INFO, f"Sent {'0xAA' if result.detected else '0x00'} frame {seq} "
+                                           f"over UART, frame age {age_ns / 1e6:.2f} ms")
+        return True
@@ -0,0 +1,151 @@
+"""
+DETECTOR PREVIEW
+
+Optional view of what the detector sees, kept off the real-time path:
+
+    window  cv2.imshow on the main thread (HighGUI must stay there), every Nth result
+    mjpeg   every Nth result drawn, downscaled and JPEG encoded by an encoder thread at SCHED_IDLE (or nice 19),
+            served as multipart/x-mixed-replace over HTTP, so any browser on the network can watch it
+    none    nothing is drawn or encoded at all
+
+The pipeline only ever hands a preview its results through a LatestQueue, so a slow viewer or encoder just sees fewer
+frames; it can never hold up detection or the UART link.
+
+Authors: Kiran Jojare, Ayswariya Kannan
+Subject: ECEN 5623 Real-Time Embedded Systems
+University: University of Colorado Boulder
+"""
+
+import os
+import syslog
+import threading
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+import cv2
+
+MODES = ("auto", "window", "mjpeg", "none")
+
+BOUNDARY = b"frame"
+
+
+def draw(result, scale=1.0):
+    """Copy of the result's frame, resized by scale, with its boxes drawn."""
+    image = result.frame.image
+    if scale != 1.0:
+        image = cv2.resize(image, None, fx=scale, fy=scale, interpolation=cv2.INTER_AREA)
+    else:
+        image = image.copy()
+    for (x, y, w, h) in result.boxes:
+        cv2.rectangle(image, (int(x * scale), int(y * scale)), (int((x + w) * scale), int((y + h) * scale)), (255, 0, 0), 2)
+    return image
+
+
+def lower_thread_priority():
+    """Calling thread only runs when the cores are otherwise idle."""
+    try:
+        os.sched_setscheduler(0, os.SCHED_IDLE, os.sched_param(0))
+    except (AttributeError, OSError):
+        try:
+            os.setpriority(os.PRIO_PROCESS, 0, 19)
+        except (AttributeError, OSError):
+            pass
+
+
+class WindowPreview:
+    """Local window; poll() must be called from the main thread and returns False once 'q' is pressed."""
+
+    def __init__(self, in_queue, every=1):
+        self.in_queue = in_queue
+        self.every = every
+
+    def poll(self, timeout):
+        result = self.in_queue.get(timeout=timeout)
+        if result is not None and result.frame.seq % self.every == 0:
+            cv2.imshow("Frame", draw(result))
+        return (cv2.waitKey(1) & 0xFF) != ord('q')
+
+    def close(self):
+        cv2.destroyAllWindows()
+
+
+class MjpegPreview:
+    """Low priority JPEG encoder thread plus an HTTP server streaming the latest JPEG to every client."""
+
+    def __init__(self, in_queue, stop_event, port=8080, every=5, scale=0.5, quality=70):
+        self.in_queue = in_queue
+        self.stop_event = stop_event
+        self.every = every
+        self.scale = scale
+        self.quality = quality
+        self.jpeg = None
+        self.count = 0
+        self.cond = threading.Condition()
+
+        preview = self
+
+        class Handler(BaseHTTPRequestHandler):
+            def do_GET(self):
+                self.send_response(200)
+                self.send_header("Content-Type", "multipart/x-mixed-replace; boundary=" + BOUNDARY.decode())
+                self.end_headers()
+                seen = 0
+                try:
+                    while not preview.stop_event.is_set():
+                        jpeg, seen = preview.wait_jpeg(seen)
+                        if jpeg is None:
+                            continue
+                        self.wfile.write(b"--" + BOUNDARY + b"\r\nContent-Type: image/jpeg\r\nContent-Length: " +
+                                         str(len(jpeg)).encode() + b"\r\n\r\n" + jpeg + b"\r\n")
+                except (BrokenPipeError, ConnectionResetError):
+                    pass
+
+            def log_message(self, format, *args):
+                pass
+
+        self.server = ThreadingHTTPServer(("", port), Handler)
+        self.server.daemon_threads = True
+        self.encoder = threading.Thread(target=self._encode, name="preview", daemon=True)
+        self.serve = threading.Thread(target=self.server.serve_forever, name="preview-http", daemon=True)
+        self.encoder.start()
+        self.serve.start()
+        syslog.syslog(syslog.LOG_INFO, f"MJPEG preview on port {port}, every {every} frames")
+
+    def wait_jpeg(self, seen):
+        """Blocks until a JPEG newer than number seen exists; returns (jpeg, its number) or (None, seen) on timeout."""
+        with self.cond:
+            if self.count == seen:
+                self.cond.wait(0.5)
+            if self.count == seen:
+                return None, seen
+            return self.jpeg, self.count
+
+    def _encode(self):
+        lower_thread_priority()
+        while not self.stop_event.is_set():
+            result = self.in_queue.get(timeout=0.5)
+            if result is None or result.frame.seq % self.every != 0:
+                continue
+            ok, jpeg = cv2.imencode(".jpg", draw(result, self.scale), [cv2.IMWRITE_JPEG_QUALITY, self.quality])
+            if ok:
+                with self.cond:
+                    self.jpeg = jpeg.tobytes()
+                    self.count += 1
+                    self.cond.notify_all()
+
+    def poll(self, timeout):
+        return not self.stop_event.wait(timeout)
+
+    def close(self):
+        self.server.shutdown()
+        self.server.server_close()
+
+
+class NoPreview:
+    def __init__(self, stop_event):
+        self.stop_event = stop_event
+
+    def poll(self, timeout):
+        return not self.stop_event.wait(timeout)
+
+    def close(self):
+        pass
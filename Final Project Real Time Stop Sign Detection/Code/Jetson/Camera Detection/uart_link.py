@@ -0,0 +1,179 @@
+"""
+UART LINK FRAMING
+
+Framing for the Jetson -> TIVA detection link. Mirrors uart_link.h on the TIVA side:
+
+    [SOF 0x7E] [SEQ] [LEN] [PAYLOAD 0 .. LEN-1] [CRC16 hi] [CRC16 lo]
+
+The CRC is CRC-16/CCITT-FALSE over SEQ, LEN and PAYLOAD. After the SOF, any 0x7E or 0x7D byte is
+sent as 0x7D followed by the byte XOR 0x20, so the receiver can always resynchronise on the next SOF.
+
+The TIVA answers on its UART2 TX with the same framing: clock sync replies and an acknowledgement for
+every motor command. Multi-byte fields are little endian microseconds, on the Jetson's clock
+(perf_counter) for fields the Jetson sent and on the TIVA's TimingNowUs() for the TIVA's own.
+
+DetectionLink can also record every frame it writes to a link trace, one line per frame:
+
+    <ms since the first frame> <wire bytes in hex>
+
+The host simulation of the TIVA firmware (TIVA_Stop_Sign_Bot/host_sim) replays these files.
+
+Authors: Kiran Jojare, Ayswariya Kannan
+Subject: ECEN 5623 Real-Time Embedded Systems
+University: University of Colorado Boulder
+"""
+
+import struct
+import threading
+import time
+from collections import namedtuple
+
+SOF = 0x7E
+ESC = 0x7D
+ESC_XOR = 0x20
+MAX_PAYLOAD = 16
+CRC_INIT = 0xFFFF
+
+# Payload message types (payload[0]), Jetson -> TIVA
+MSG_DETECTION = 0x01            # state, capture time
+MSG_SYNC_REQUEST = 0x02         # request id, Jetson send time
+MSG_SERVICE_REQUEST = 0x03      # service, enable (1) or disable (0)
+
+# TIVA -> Jetson
+MSG_ACTUATION = 0x81            # link seq, state, service, capture time, TIVA receive time, TIVA actuation time
+MSG_SYNC_REPLY = 0x82           # request id, Jetson send time, TIVA receive time, TIVA reply time
+MSG_SERVICE_REPLY = 0x83        # service, enable, admission result, culprit service, response time bound
+
+Actuation = namedtuple("Actuation", "seq state service capture_us rx_us actuated_us")
+SyncReply = namedtuple("SyncReply", "request t1 t2 t3")
+ServiceReply = namedtuple("ServiceReply", "service enable result culprit bound_us")
+
+# Admission results carried by MSG_SERVICE_REPLY (AdmissionResult in admission.h)
+ADMISSION_RESULTS = {0: "accepted", 1: "rejected", 2: "invalid"}
+ADMISSION_NO_CULPRIT = 0xFF
+
+# Detection states carried by MSG_DETECTION
+DETECTION_STOP = 0xAA
+DETECTION_CLEAR = 0x00
+
+
+def crc16(data, crc=CRC_INIT):
+    """CRC-16/CCITT-FALSE (poly 0x1021), bitwise; frames are only a few bytes long."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def _stuff(data):
+    out = bytearray()
+    for byte in data:
+        if byte in (SOF, ESC):
+            out += bytes([ESC, byte ^ ESC_XOR])
+        else:
+            out.append(byte)
+    return out
+
+
+def encode_frame(seq, payload):
+    """Return the stuffed wire frame for one payload."""
+    payload = bytes(payload)
+    if len(payload) > MAX_PAYLOAD:
+        raise ValueError("payload too long")
+    body = bytes([seq & 0xFF, len(payload)]) + payload
+    crc = crc16(body)
+    return bytes([SOF]) + bytes(_stuff(body + bytes([crc >> 8, crc & 0xFF])))
+
+
+class FrameParser:
+    """Byte-at-a-time decoder, the host-side twin of UARTLinkParseByte()."""
+
+    def __init__(self):
+        self.crc_errors = 0
+        self.length_errors = 0
+        self._buf = None
+        self._escaped = False
+
+    def feed(self, data):
+        """Feed raw bytes; returns a list of (seq, payload) tuples for every frame that passed its CRC."""
+        frames = []
+        for byte in data:
+            if byte == SOF:
+                if self._buf is not None:
+                    self.length_errors += 1
+                self._buf = bytearray()
+                self._escaped = False
+                continue
+            if self._buf is None:
+                continue
+            if byte == ESC:
+                self._escaped = True
+                continue
+            if self._escaped:
+                byte ^= ESC_XOR
+                self._escaped = False
+            self._buf.append(byte)
+
+            if len(self._buf) >= 2 and self._buf[1] > MAX_PAYLOAD:
+                self.length_errors += 1
+                self._buf = None
+                continue
+            if len(self._buf) >= 2 and len(self._buf) == self._buf[1] + 4:
+                body, rx_crc = self._buf[:-2], (self._buf[-2] << 8) | self._buf[-1]
+                if crc16(body) == rx_crc:
+                    frames.append((body[0], bytes(body[2:])))
+                else:
+                    self.crc_errors += 1
+                self._buf = None
+        return frames
+
+
+def decode_message(payload):
+    """Returns an Actuation, SyncReply or ServiceReply for a TIVA -> Jetson payload, None for anything else."""
+    if len(payload) >= 16 and payload[0] == MSG_ACTUATION:
+        return Actuation(*struct.unpack_from("<BBBIII", payload, 1))
+    if len(payload) >= 14 and payload[0] == MSG_SYNC_REPLY:
+        return SyncReply(*struct.unpack_from("<BIII", payload, 1))
+    if len(payload) >= 9 and payload[0] == MSG_SERVICE_REPLY:
+        return ServiceReply(*struct.unpack_from("<BBBBI", payload, 1))
+    return None
+
+
+class DetectionLink:
+    """Sends framed detection states over an open serial port with a rolling sequence number. Thread safe."""
+
+    def __init__(self, port, trace=None):
+        """trace: open text file that receives a link trace line for every frame written."""
+        self.port = port
+        self.seq = 0
+        self.trace = trace
+        self._trace_start = None
+        self._lock = threading.Lock()
+
+    def send(self, payload):
+        """Frames and writes payload; returns the sequence number it went out with."""
+        with self._lock:
+            seq = self.seq
+            frame = encode_frame(seq, payload)
+            self.port.write(frame)
+            self.seq = (seq + 1) & 0xFF
+            if self.trace is not None:
+                now = time.perf_counter()
+                if self._trace_start is None:
+                    self._trace_start = now
+                self.trace.write("%.3f %s\n" % ((now - self._trace_start) * 1e3, frame.hex()))
+        return seq
+
+    def send_detection(self, detected, capture_us=0):
+        """capture_us: perf_counter time the frame was captured, echoed back in the actuation acknowledgement."""
+        state = DETECTION_STOP if detected else DETECTION_CLEAR
+        return self.send(struct.pack("<BBI", MSG_DETECTION, state, capture_us & 0xFFFFFFFF))
+
+    def send_sync(self, request, now_us):
+        return self.send(struct.pack("<BBI", MSG_SYNC_REQUEST, request & 0xFF, now_us & 0xFFFFFFFF))
+
+    def send_service_request(self, service, enable):
+        """Asks the TIVA to enable or disable a sequenced service; it only enables one that passes admission control."""
+        return self.send(struct.pack("<BBB", MSG_SERVICE_REQUEST, service & 0xFF, 1 if enable else 0))
@@ -0,0 +1,134 @@
+/*
+ * Processor demand feasibility test for preemptive EDF.
+ * Author: Kiran Jojare, Ayswariya Kannan
+ * Course: ECEN 5623 Real-Time Operating Systems
+ * University: University of Colorado Boulder
+ *
+ * The utilization bound U <= 1 is only exact for EDF when D = T. For D < T
+ * (and with release jitter) the task set is feasible iff U <= 1 and, for
+ * every absolute deadline t inside the synchronous busy period L,
+ *
+ *     h(t) + B(t) <= t,   h(t) = sum_i max(0, floor((t + J_i - D_i) / T_i) + 1) C_i
+ *
+ * where B(t) is the largest blocking term of a task with a deadline <= t
+ * (Baker's stack resource policy bound). LLF is optimal on one processor as
+ * well, so the same test is its exact feasibility test.
+ */
+
+#include <stdio.h>
+#include "feasibility.h"
+
+/*
+ * Length of the synchronous busy period with every task released as late in
+ * its jitter window as possible. Returns FALSE if it grows past limit.
+ */
+static int busy_period(const task_set_t *set, U64_T limit, U64_T *length)
+{
+    U64_T w = 0, next;
+
+    for (U32_T i = 0; i < set->count; i++)
+        w += set->task[i].wcet;
+
+    for (;;)
+    {
+        next = 0;
+        for (U32_T i = 0; i < set->count; i++)
+        {
+            const task_t *t = &set->task[i];
+            next += ceil_div(w + t->jitter, t->period) * t->wcet;
+        }
+        if (next == w)
+        {
+            *length = w;
+            return TRUE;
+        }
+        if (next > limit)
+            return FALSE;
+        w = next;
+    }
+}
+
+static U64_T demand(const task_set_t *set, U64_T t)
+{
+    U64_T h = 0;
+    U32_T blocking = 0;
+
+    for (U32_T i = 0; i < set->count; i++)
+    {
+        const task_t *task = &set->task[i];
+        if (t + task->jitter >= task->deadline)
+        {
+            h += ((t + task->jitter - task->deadline) / task->period + 1) * task->wcet;
+            if (task->blocking > blocking)
+                blocking = task->blocking;
+        }
+    }
+    return h + blocking;
+}
+
+/*
+ * Returns TRUE if the set is EDF feasible. On failure *failTime is the first
+ * deadline that overflows, or 0 if the set was rejected before any deadline
+ * was checked.
+ *
+ * At U = 1 the busy period only ends if the demand ever catches up with the
+ * supply. Past max J the demand repeats with the hyperperiod H, so a busy
+ * period still running at H + max D + max J never ends and the set is
+ * rejected as unbounded.
+ */
+int edf_demand_feasibility(const task_set_t *set, U64_T *failTime)
+{
+    U64_T length, limit = ~0ULL;
+    int u;
+
+    *failTime = 0;
+    for (U32_T i = 0; i < set->count; i++)
+    {
+        if (set->task[i].jitter >= set->task[i].deadline)
+            return FALSE;
+    }
+
+    u = task_set_utilization_cmp(set, set->count);
+    if (u > 0)
+        return FALSE;
+    if (u == 0)
+    {
+        U64_T h = task_set_hyperperiod(set);
+        U64_T extra;
+        U32_T maxD = 0, maxJ = 0;
+
+        for (U32_T i = 0; i < set->count; i++)
+        {
+            if (set->task[i].deadline > maxD)
+                maxD = set->task[i].deadline;
+            if (set->task[i].jitter > maxJ)
+                maxJ = set->task[i].jitter;
+        }
+        extra = (U64_T)maxD + maxJ;
+        if (h != 0 && h <= ~0ULL - extra)
+            limit = h + extra;
+    }
+
+    if (!busy_period(set, limit, &length))
+    {
+        if (feasibility_verbose)
+            printf("EDF demand: U = 1 and the busy period does not end (past t=%llu)\n", limit);
+        return FALSE;
+    }
+
+    // Check h(t) at every absolute deadline d = k T_i + D_i - J_i inside the busy period.
+    for (U32_T i = 0; i < set->count; i++)
+    {
+        const task_t *t = &set->task[i];
+        for (U64_T d = t->deadline - t->jitter; d <= length; d += t->period)
+        {
+            if (demand(set, d) > d)
+            {
+                if (*failTime == 0 || d < *failTime)
+                    *failTime = d;
+                break;
+            }
+        }
+    }
+    return *failTime == 0 ? TRUE : FALSE;
+}
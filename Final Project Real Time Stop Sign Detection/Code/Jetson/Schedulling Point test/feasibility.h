@@ -0,0 +1,119 @@
+/*
+ * Feasibility analysis engine: task set model, loader and the exact tests.
+ * Author: Kiran Jojare, Ayswariya Kannan
+ * Course: ECEN 5623 Real-Time Operating Systems
+ * University: University of Colorado Boulder
+ *
+ * All analysis is done in integer arithmetic. Times are in whatever unit the
+ * task set uses (the TIVA firmware prints microseconds); sums that can grow
+ * beyond 32 bits are carried in U64_T.
+ */
+
+#ifndef FEASIBILITY_H
+#define FEASIBILITY_H
+
+#define TRUE 1
+#define FALSE 0
+#define U32_T unsigned int
+#define U64_T unsigned long long
+
+#define MAX_TASKS       128
+#define TASK_NAME_LEN   32
+
+// Priority assignment applied after loading.
+#define PRIO_FILE       0   // Keep file order, first line is the highest priority.
+#define PRIO_RM         1   // Rate monotonic: shorter period first.
+#define PRIO_DM         2   // Deadline monotonic: shorter deadline first.
+
+typedef struct
+{
+    char name[TASK_NAME_LEN];
+    U32_T wcet;         // C
+    U32_T period;       // T
+    U32_T deadline;     // D, relative to the nominal release
+    U32_T jitter;       // J, release jitter
+    U32_T blocking;     // B, worst case blocking by lower priority tasks
+} task_t;
+
+typedef struct
+{
+    U32_T count;
+    task_t task[MAX_TASKS];
+} task_set_t;
+
+// Result of fixed priority response time analysis for one task.
+typedef struct
+{
+    U64_T response;     // Worst case response time, including the task's own jitter
+    long long slack;    // D - R, negative when the deadline is missed
+    int feasible;
+} rta_result_t;
+
+// Parameters of a schedulability sweep (sweep.c).
+#define SWEEP_TESTS     5   // rm_lub, completion_time, scheduling_point, rta_dm, edf_demand
+
+typedef struct
+{
+    U32_T minTasks, maxTasks;       // Tasks per set, drawn uniformly
+    U32_T minPeriod, maxPeriod;     // Period range
+    int logPeriods;                 // Log-uniform instead of uniform periods
+    double minDeadlineRatio;        // D drawn in [ratio * T, T]; 1.0 gives D = T
+    double minUtil, maxUtil, stepUtil;
+    U32_T setsPerPoint;
+    U32_T threads;
+    unsigned long long seed;
+    const char *output;             // CSV file, NULL for stdout
+} sweep_config_t;
+
+// Schedule simulator (sim.c).
+#define SIM_RM          0
+#define SIM_DM          1
+#define SIM_EDF         2
+#define SIM_LLF         3
+#define SIM_POLICIES    4
+#define SIM_ALL         SIM_POLICIES   // Every policy, one after the other
+
+typedef struct
+{
+    U64_T horizon;                  // Jobs are released before this; 0 for one hyperperiod
+    U32_T switchCost;               // Context switch overhead of every dispatch
+    unsigned long long seed;        // Release jitter draws
+    U32_T ganttWidth;               // Columns of the printed Gantt chart, 0 for none
+    const char *jobsFile;           // Per-job CSV, NULL for none
+    const char *traceFile;          // Execution segments, NULL for none
+} sim_config_t;
+
+// feasibility_tests.c. The arrays must be in rate monotonic order.
+extern int feasibility_verbose;     // Print the work of the classic tests
+int completion_time_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+int scheduling_point_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+int rate_monotonic_least_upper_bound(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+
+// task_set.c
+int load_task_set(const char *path, task_set_t *set);
+void assign_priorities(task_set_t *set, int policy);
+void task_set_from_arrays(task_set_t *set, U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+U64_T task_set_hyperperiod(const task_set_t *set);
+int task_set_utilization_cmp(const task_set_t *set, U32_T count);
+void print_task_set(const task_set_t *set);
+
+// rta.c
+U64_T ceil_div(U64_T num, U64_T den);
+int response_time_analysis(const task_set_t *set, rta_result_t result[]);
+
+// edf_demand.c
+int edf_demand_feasibility(const task_set_t *set, U64_T *failTime);
+
+// sweep.c
+U64_T next_random(U64_T *state);
+int sweep_generate_task_set(const sweep_config_t *cfg, double utilization, U64_T k, task_set_t *set);
+int run_sweep(const sweep_config_t *cfg);
+
+// sched_point.c. Arrays in rate (or deadline) monotonic order, D <= T.
+int scheduling_point_feasibility_fast(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+int run_sched_point_bench(const sweep_config_t *cfg);
+
+// sim.c. Returns TRUE if no job missed its deadline.
+int run_simulation(const task_set_t *set, int policy, const sim_config_t *cfg);
+
+#endif
@@ -1,167 +1,354 @@
-/*
- * This code is used for demonstrating feasibility tests for real-time operating systems.
- * Author: Kiran Jojare, Ayswariya Kannan
- * Course: ECEN 5623 Real-Time Operating Systems
- * Reference: Code provided by Professor Sam Siewert
- * University: University of Colorado Boulder
- *
- * The code specifically applies the completion time test, scheduling point test, and
- * rate monotonic least upper bound test for example 2 from a series of examples.
- * These tests help in verifying the feasibility of scheduling real-time tasks under
- * fixed priority scheduling on a single core.
- */
-
-#include <math.h>
-#include <stdio.h>
-
-#define TRUE 1
-#define FALSE 0
-#define U32_T unsigned int
-
-// U = 0.9967
-U32_T ex2_period[] = {2, 5, 7, 13};
-U32_T ex2_wcet[] = {1, 1, 1, 2};
-
-int completion_time_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
-int scheduling_point_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
-int rate_monotonic_least_upper_bound(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
-int edf_feasibility(U32_T numServices, U32_T period[], U32_T wcet[]);
-int llf_feasibility(U32_T numServices, U32_T period[], U32_T wcet[]);
-
-int main(void)
-{ 
-    U32_T numServices = 4;
-    printf("************************************************\n");
-    printf("************************************************\n");
-    printf("******** Completion Test Feasibility Example\n");
-    printf("************************************************\n");
-    printf("************************************************\n\n");
-
-    printf("Ex-2 U=%4.2f%% (C1=1, C2=1, C3=1, C4=2; T1=2, T2=5, T3=7, T4=13; T=D): ",
-           ((1.0/2.0)*100.0 + (1.0/5.0)*100.0 + (1.0/7.0)*100.0 + (2.0/13.0)*100.0));
-
-    if(completion_time_feasibility(numServices, ex2_period, ex2_wcet, ex2_period) == TRUE)
-        printf("FEASIBLE\n");
-    else
-        printf("INFEASIBLE\n");
-
-    if(rate_monotonic_least_upper_bound(numServices, ex2_period, ex2_wcet, ex2_period) == TRUE)
-        printf("RM LUB FEASIBLE\n");
-    else
-        printf("RM LUB INFEASIBLE\n");
-
-    if(edf_feasibility(numServices, ex2_period, ex2_wcet) == TRUE)
-        printf("EDF FEASIBLE\n");
-    else
-        printf("EDF INFEASIBLE\n");
-
-    if(llf_feasibility(numServices, ex2_period, ex2_wcet) == TRUE)
-        printf("LLF FEASIBLE\n");
-    else
-        printf("LLF INFEASIBLE\n");
-
-    printf("************************************************\n");
-    printf("************************************************\n");
-    printf("******** Scheduling Point Feasibility Example\n");
-    printf("************************************************\n");
-    printf("************************************************\n\n");
-
-    printf("Ex-2 U=%4.2f%% (C1=1, C2=1, C3=1, C4=2; T1=2, T2=5, T3=7, T4=13; T=D): ",
-           ((1.0/2.0)*100.0 + (1.0/5.0)*100.0 + (1.0/7.0)*100.0 + (2.0/13.0)*100.0));
-
-    if(scheduling_point_feasibility(numServices, ex2_period, ex2_wcet, ex2_period) == TRUE)
-        printf("FEASIBLE\n");
-    else
-        printf("INFEASIBLE\n");
-
-    return 0;
-}
-
-int rate_monotonic_least_upper_bound(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
-{
-    double utility_sum = 0.0, lub;
-    printf("for %d, utility_sum = %lf\n", numServices, utility_sum);
-    for(int idx = 0; idx < numServices; idx++)
-    {
-        utility_sum += (double)wcet[idx] / period[idx];
-        printf("for %d, wcet=%lf, period=%lf, utility_sum = %lf\n", idx, (double)wcet[idx], (double)period[idx], utility_sum);
-    }
-    lub = numServices * (pow(2.0, 1.0 / numServices) - 1.0);
-    printf("utility_sum = %lf\n", utility_sum);
-    printf("LUB = %lf\n", lub);
-    return utility_sum <= lub ? TRUE : FALSE;
-}
-
-int completion_time_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
-{
-    for (int i = 0; i < numServices; i++)
-    {
-        U32_T an = 0, anext;
-        for (int j = 0; j <= i; j++)
-        {
-            an += wcet[j];
-        }
-        do
-        {
-            anext = wcet[i];
-            for (int j = 0; j < i; j++)
-            {
-                anext += ceil((double)an / period[j]) * wcet[j];
-            }
-            if (anext == an)
-                break;
-            an = anext;
-        } while (1);
-
-        if (an > deadline[i])
-            return FALSE;
-    }
-    return TRUE;
-}
-
-int scheduling_point_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
-{
-    int rc = TRUE;
-    for (int i = 0; i < numServices; i++)
-    {
-        int status = 0;
-        for (int k = 0; k <= i; k++)
-        {
-            for (int l = 1; l <= floor((double)period[i] / period[k]); l++)
-            {
-                U32_T temp = 0;
-                for (int j = 0; j <= i; j++)
-                {
-                    temp += wcet[j] * ceil((double)(l * period[k]) / period[j]);
-                }
-                if (temp <= (l * period[k]))
-                {
-                    status = 1;
-                    break;
-                }
-            }
-            if (status) break;
-        }
-        if (!status) rc = FALSE;
-    }
-    return rc;
-}
-
-int edf_feasibility(U32_T numServices, U32_T period[], U32_T wcet[]) {
-    double totalUtilization = 0.0;
-    for (int i = 0; i < numServices; i++) {
-        totalUtilization += (double)wcet[i] / period[i];
-    }
-    printf("EDF Total Utilization: %f\n", totalUtilization);
-    return totalUtilization <= 1.0 ? TRUE : FALSE;
-}
-
-int llf_feasibility(U32_T numServices, U32_T period[], U32_T wcet[]) {
-    double totalUtilization = 0.0;
-    for (int i = 0; i < numServices; i++) {
-        totalUtilization += (double)wcet[i] / period[i];
-    }
-    printf("LLF Total Utilization: %f\n", totalUtilization);
-    return totalUtilization <= 1.0 ? TRUE : FALSE;
-}
-
+/*
+ * This code is used for demonstrating feasibility tests for real-time operating systems.
+ * Author: Kiran Jojare, Ayswariya Kannan
+ * Course: ECEN 5623 Real-Time Operating Systems
+ * Reference: Code provided by Professor Sam Siewert
+ * University: University of Colorado Boulder
+ *
+ * The code specifically applies the completion time test, scheduling point test, and
+ * rate monotonic least upper bound test for example 2 from a series of examples.
+ * These tests help in verifying the feasibility of scheduling real-time tasks under
+ * fixed priority scheduling on a single core.
+ *
+ * Given a task set file it instead runs the analysis engine (rta.c, edf_demand.c):
+ * exact response time analysis with release jitter and blocking, and the EDF
+ * processor demand test, reporting response time and slack per task.
+ *
+ * Sweep mode (sweep.c) instead generates random task sets and writes the
+ * schedulable fraction per utilization point and test to a CSV file.
+ *
+ * Simulation mode (sim.c) plays the task set (example 2 without a file) under
+ * RM, DM, EDF or LLF and reports the observed response times and misses.
+ *
+ *     ./feasibility_tests                      textbook example 2
+ *     ./feasibility_tests [-p rm|dm|file] set  task set file, see task_set.c
+ *     ./feasibility_tests -s [sweep options]   see usage()
+ *     ./feasibility_tests -b [sweep options]   naive vs pruned scheduling point test
+ *     ./feasibility_tests -x policy [set]      schedule simulation, see usage()
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "feasibility.h"
+
+// U = 0.9967
+U32_T ex2_period[] = {2, 5, 7, 13};
+U32_T ex2_wcet[] = {1, 1, 1, 2};
+
+int edf_feasibility(U32_T numServices, U32_T period[], U32_T wcet[]);
+int llf_feasibility(U32_T numServices, U32_T period[], U32_T wcet[]);
+int analyse_task_set(task_set_t *set);
+
+int feasibility_verbose = TRUE;
+
+static task_set_t fileSet;
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-p rm|dm|file] [taskset]\n", prog);
+    fprintf(stderr, "       %s -s|-b [-n tasks|min-max] [-N sets] [-u min:max:step] [-T min:max] [-l]\n"
+                    "          [-d min_deadline_ratio] [-j threads] [-S seed] [-o out.csv]\n", prog);
+    fprintf(stderr, "       %s -x rm|dm|edf|llf|all [-H horizon] [-c switch_cost] [-S seed] [-G columns]\n"
+                    "          [-g trace.txt] [-o jobs.csv] [taskset]\n", prog);
+}
+
+int main(int argc, char *argv[])
+{ 
+    U32_T numServices = 4;
+    int policy = PRIO_DM;
+    int sweep = FALSE, bench = FALSE, simPolicy = -1;
+    int opt, ok = TRUE;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    sweep_config_t cfg =
+    {
+        .minTasks = 4, .maxTasks = 4,
+        .minPeriod = 10, .maxPeriod = 1000,
+        .logPeriods = FALSE,
+        .minDeadlineRatio = 1.0,
+        .minUtil = 0.05, .maxUtil = 1.0, .stepUtil = 0.05,
+        .setsPerPoint = 1000,
+        .threads = (cpus > 0) ? (U32_T)cpus : 1,
+        .seed = 1,
+        .output = NULL
+    };
+    sim_config_t sim = { .horizon = 0, .switchCost = 0, .ganttWidth = 0, .jobsFile = NULL, .traceFile = NULL };
+
+    while ((opt = getopt(argc, argv, "p:sbn:N:u:T:ld:j:S:o:x:H:c:g:G:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'p':
+                if (strcmp(optarg, "rm") == 0)
+                    policy = PRIO_RM;
+                else if (strcmp(optarg, "dm") == 0)
+                    policy = PRIO_DM;
+                else if (strcmp(optarg, "file") == 0)
+                    policy = PRIO_FILE;
+                else
+                    ok = FALSE;
+                break;
+            case 's': sweep = TRUE; break;
+            case 'b': bench = TRUE; break;
+            case 'n':
+                if (sscanf(optarg, "%u-%u", &cfg.minTasks, &cfg.maxTasks) == 1)
+                    cfg.maxTasks = cfg.minTasks;
+                break;
+            case 'N': cfg.setsPerPoint = (U32_T)strtoul(optarg, NULL, 10); break;
+            case 'u': ok = sscanf(optarg, "%lf:%lf:%lf", &cfg.minUtil, &cfg.maxUtil, &cfg.stepUtil) == 3; break;
+            case 'T': ok = sscanf(optarg, "%u:%u", &cfg.minPeriod, &cfg.maxPeriod) == 2; break;
+            case 'l': cfg.logPeriods = TRUE; break;
+            case 'd': cfg.minDeadlineRatio = atof(optarg); break;
+            case 'j': cfg.threads = (U32_T)strtoul(optarg, NULL, 10); break;
+            case 'S': cfg.seed = strtoull(optarg, NULL, 0); break;
+            case 'o': cfg.output = optarg; break;
+            case 'x':
+                if (strcmp(optarg, "rm") == 0)
+                    simPolicy = SIM_RM;
+                else if (strcmp(optarg, "dm") == 0)
+                    simPolicy = SIM_DM;
+                else if (strcmp(optarg, "edf") == 0)
+                    simPolicy = SIM_EDF;
+                else if (strcmp(optarg, "llf") == 0)
+                    simPolicy = SIM_LLF;
+                else if (strcmp(optarg, "all") == 0)
+                    simPolicy = SIM_ALL;
+                else
+                    ok = FALSE;
+                break;
+            case 'H': sim.horizon = strtoull(optarg, NULL, 0); break;
+            case 'c': sim.switchCost = (U32_T)strtoul(optarg, NULL, 10); break;
+            case 'g': sim.traceFile = optarg; break;
+            case 'G': sim.ganttWidth = (U32_T)strtoul(optarg, NULL, 10); break;
+            default: ok = FALSE; break;
+        }
+        if (!ok)
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (bench)
+    {
+        feasibility_verbose = FALSE;
+        return run_sched_point_bench(&cfg) == TRUE ? 0 : 1;
+    }
+
+    if (sweep)
+    {
+        feasibility_verbose = FALSE;
+        return run_sweep(&cfg) == TRUE ? 0 : 2;
+    }
+
+    if (simPolicy >= 0)
+    {
+        sim.seed = cfg.seed;
+        sim.jobsFile = cfg.output;
+        if (optind < argc)
+        {
+            if (load_task_set(argv[optind], &fileSet) != TRUE)
+                return 2;
+        }
+        else
+            task_set_from_arrays(&fileSet, numServices, ex2_period, ex2_wcet, ex2_period);
+        assign_priorities(&fileSet, policy);
+        return run_simulation(&fileSet, simPolicy, &sim) == TRUE ? 0 : 1;
+    }
+
+    if (optind < argc)
+    {
+        if (load_task_set(argv[optind], &fileSet) != TRUE)
+            return 2;
+        assign_priorities(&fileSet, policy);
+        printf("Task set %s (%u tasks)\n", argv[optind], fileSet.count);
+        return analyse_task_set(&fileSet) == TRUE ? 0 : 1;
+    }
+
+    printf("************************************************\n");
+    printf("************************************************\n");
+    printf("******** Completion Test Feasibility Example\n");
+    printf("************************************************\n");
+    printf("************************************************\n\n");
+
+    printf("Ex-2 U=%4.2f%% (C1=1, C2=1, C3=1, C4=2; T1=2, T2=5, T3=7, T4=13; T=D): ",
+           ((1.0/2.0)*100.0 + (1.0/5.0)*100.0 + (1.0/7.0)*100.0 + (2.0/13.0)*100.0));
+
+    if(completion_time_feasibility(numServices, ex2_period, ex2_wcet, ex2_period) == TRUE)
+        printf("FEASIBLE\n");
+    else
+        printf("INFEASIBLE\n");
+
+    if(rate_monotonic_least_upper_bound(numServices, ex2_period, ex2_wcet, ex2_period) == TRUE)
+        printf("RM LUB FEASIBLE\n");
+    else
+        printf("RM LUB INFEASIBLE\n");
+
+    if(edf_feasibility(numServices, ex2_period, ex2_wcet) == TRUE)
+        printf("EDF FEASIBLE\n");
+    else
+        printf("EDF INFEASIBLE\n");
+
+    if(llf_feasibility(numServices, ex2_period, ex2_wcet) == TRUE)
+        printf("LLF FEASIBLE\n");
+    else
+        printf("LLF INFEASIBLE\n");
+
+    printf("************************************************\n");
+    printf("************************************************\n");
+    printf("******** Scheduling Point Feasibility Example\n");
+    printf("************************************************\n");
+    printf("************************************************\n\n");
+
+    printf("Ex-2 U=%4.2f%% (C1=1, C2=1, C3=1, C4=2; T1=2, T2=5, T3=7, T4=13; T=D): ",
+           ((1.0/2.0)*100.0 + (1.0/5.0)*100.0 + (1.0/7.0)*100.0 + (2.0/13.0)*100.0));
+
+    if(scheduling_point_feasibility(numServices, ex2_period, ex2_wcet, ex2_period) == TRUE)
+        printf("FEASIBLE\n");
+    else
+        printf("INFEASIBLE\n");
+
+    printf("************************************************\n");
+    printf("************************************************\n");
+    printf("******** Response Time Analysis Example\n");
+    printf("************************************************\n");
+    printf("************************************************\n\n");
+
+    task_set_from_arrays(&fileSet, numServices, ex2_period, ex2_wcet, ex2_period);
+    analyse_task_set(&fileSet);
+
+    return 0;
+}
+
+/*
+ * Runs response time analysis and the EDF demand test on a task set that is
+ * already in priority order, and prints a per-task report.
+ */
+int analyse_task_set(task_set_t *set)
+{
+    static rta_result_t result[MAX_TASKS];
+    U64_T failTime;
+    int rtaOk, edfOk;
+
+    print_task_set(set);
+    printf("\n");
+
+    rtaOk = response_time_analysis(set, result);
+    printf("%-24s %10s %10s %10s\n", "name", "R", "slack", "");
+    for (U32_T i = 0; i < set->count; i++)
+    {
+        if (result[i].feasible)
+            printf("%-24s %10llu %10lld %10s\n", set->task[i].name, result[i].response, result[i].slack, "ok");
+        else
+            printf("%-24s %9llu+ %10s %10s\n", set->task[i].name, result[i].response, "-", "MISS");
+    }
+    printf("Fixed priority RTA: %s\n", rtaOk == TRUE ? "FEASIBLE" : "INFEASIBLE");
+
+    edfOk = edf_demand_feasibility(set, &failTime);
+    if (edfOk == TRUE)
+        printf("EDF processor demand: FEASIBLE\n");
+    else if (failTime != 0)
+        printf("EDF processor demand: INFEASIBLE (demand exceeds supply at t=%llu)\n", failTime);
+    else
+        printf("EDF processor demand: INFEASIBLE\n");
+
+    return (rtaOk == TRUE && edfOk == TRUE) ? TRUE : FALSE;
+}
+
+int rate_monotonic_least_upper_bound(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    double utility_sum = 0.0, lub;
+    if (feasibility_verbose)
+        printf("for %d, utility_sum = %lf\n", numServices, utility_sum);
+    for(int idx = 0; idx < numServices; idx++)
+    {
+        utility_sum += (double)wcet[idx] / period[idx];
+        if (feasibility_verbose)
+            printf("for %d, wcet=%lf, period=%lf, utility_sum = %lf\n", idx, (double)wcet[idx], (double)period[idx], utility_sum);
+    }
+    lub = numServices * (pow(2.0, 1.0 / numServices) - 1.0);
+    if (feasibility_verbose)
+    {
+        printf("utility_sum = %lf\n", utility_sum);
+        printf("LUB = %lf\n", lub);
+    }
+    return utility_sum <= lub ? TRUE : FALSE;
+}
+
+int completion_time_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    for (int i = 0; i < numServices; i++)
+    {
+        U64_T an = 0, anext;
+        for (int j = 0; j <= i; j++)
+        {
+            an += wcet[j];
+        }
+        do
+        {
+            anext = wcet[i];
+            for (int j = 0; j < i; j++)
+            {
+                anext += ceil_div(an, period[j]) * wcet[j];
+            }
+            if (anext == an)
+                break;
+            an = anext;
+            // Diverging (or already late); the deadline check below fails it.
+            if (an > deadline[i])
+                break;
+        } while (1);
+
+        if (an > deadline[i])
+            return FALSE;
+    }
+    return TRUE;
+}
+
+int scheduling_point_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    int rc = TRUE;
+    for (int i = 0; i < numServices; i++)
+    {
+        int status = 0;
+        for (int k = 0; k <= i; k++)
+        {
+            for (U32_T l = 1; l <= period[i] / period[k]; l++)
+            {
+                U64_T temp = 0;
+                for (int j = 0; j <= i; j++)
+                {
+                    temp += wcet[j] * ceil_div((U64_T)l * period[k], period[j]);
+                }
+                if (temp <= ((U64_T)l * period[k]))
+                {
+                    status = 1;
+                    break;
+                }
+            }
+            if (status) break;
+        }
+        if (!status) rc = FALSE;
+    }
+    return rc;
+}
+
+int edf_feasibility(U32_T numServices, U32_T period[], U32_T wcet[]) {
+    double totalUtilization = 0.0;
+    for (int i = 0; i < numServices; i++) {
+        totalUtilization += (double)wcet[i] / period[i];
+    }
+    printf("EDF Total Utilization: %f\n", totalUtilization);
+    return totalUtilization <= 1.0 ? TRUE : FALSE;
+}
+
+// LLF is optimal on a single preemptive processor, so its exact test is the EDF processor demand test.
+int llf_feasibility(U32_T numServices, U32_T period[], U32_T wcet[]) {
+    task_set_t set;
+    U64_T failTime;
+    task_set_from_arrays(&set, numServices, period, wcet, period);
+    return edf_demand_feasibility(&set, &failTime);
+}
+
@@ -0,0 +1,115 @@
+/*
+ * Exact fixed priority response time analysis.
+ * Author: Kiran Jojare, Ayswariya Kannan
+ * Course: ECEN 5623 Real-Time Operating Systems
+ * University: University of Colorado Boulder
+ *
+ * Task i (tasks are in priority order, index 0 highest) is analysed over its
+ * level-i busy period, one job q at a time (Tindell's formulation, so D > T
+ * is handled as well as D <= T):
+ *
+ *     w(q) = B_i + (q+1) C_i + sum_{j < i} ceil((w(q) + J_j) / T_j) C_j
+ *     R(q) = w(q) - q T_i + J_i
+ *
+ * The busy period ends at the first q with w(q) <= (q+1) T_i - J_i and
+ * R_i = max R(q). The iteration stops early as soon as a job misses D_i.
+ *
+ * Tindell's analysis assumes the level-i utilization is below 1. At exactly
+ * 1, with jitter or blocking, the busy period may never end. Past max J the
+ * demand repeats with the hyperperiod H, so q is capped at (H + max J) / T_i
+ * and a busy period still open there makes the task unschedulable.
+ */
+
+#include "feasibility.h"
+
+U64_T ceil_div(U64_T num, U64_T den)
+{
+    return (num + den - 1) / den;
+}
+
+static U64_T interference(const task_set_t *set, U32_T i, U64_T w)
+{
+    U64_T sum = 0;
+    for (U32_T j = 0; j < i; j++)
+    {
+        const task_t *hp = &set->task[j];
+        sum += ceil_div(w + hp->jitter, hp->period) * hp->wcet;
+    }
+    return sum;
+}
+
+static void analyse_task(const task_set_t *set, U32_T i, rta_result_t *result)
+{
+    const task_t *t = &set->task[i];
+    U64_T worst = 0;
+    U64_T w = 0;
+    U64_T maxJobs = ~0ULL;
+
+    // Above 1 the responses grow until a deadline is missed; below 1 the busy period ends.
+    if (task_set_utilization_cmp(set, i + 1) == 0)
+    {
+        U64_T h = task_set_hyperperiod(set);
+        U32_T maxJ = 0;
+
+        for (U32_T j = 0; j <= i; j++)
+        {
+            if (set->task[j].jitter > maxJ)
+                maxJ = set->task[j].jitter;
+        }
+        if (h != 0 && h <= ~0ULL - maxJ)
+            maxJobs = (h + maxJ) / t->period + 1;
+    }
+
+    result->feasible = TRUE;
+    for (U64_T q = 0; ; q++)
+    {
+        U64_T own = t->blocking + (q + 1) * t->wcet;
+        U64_T response;
+
+        if (q == maxJobs)
+        {
+            // The level-i busy period never ends.
+            result->feasible = FALSE;
+            break;
+        }
+
+        if (w < own)
+            w = own;
+        for (;;)
+        {
+            U64_T next = own + interference(set, i, w);
+            if (next == w)
+                break;
+            w = next;
+            // Job q already misses its deadline; no need to reach the fixed point.
+            if (w + t->jitter > q * t->period + t->deadline)
+                break;
+        }
+
+        response = w + t->jitter - q * t->period;
+        if (response > worst)
+            worst = response;
+        if (response > t->deadline)
+        {
+            result->feasible = FALSE;
+            break;
+        }
+        if (w + t->jitter <= (q + 1) * t->period)
+            break;
+    }
+
+    result->response = worst;
+    result->slack = (long long)t->deadline - (long long)worst;
+}
+
+int response_time_analysis(const task_set_t *set, rta_result_t result[])
+{
+    int rc = TRUE;
+    for (U32_T i = 0; i < set->count; i++)
+    {
+        analyse_task(set, i, &result[i]);
+        if (!result[i].feasible)
+            rc = FALSE;
+    }
+    return rc;
+}
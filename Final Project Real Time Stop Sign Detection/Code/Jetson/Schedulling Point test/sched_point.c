@@ -0,0 +1,217 @@
+/*
+ * Pruned scheduling point test and its benchmark against the naive version.
+ * Author: Kiran Jojare, Ayswariya Kannan
+ * Course: ECEN 5623 Real-Time Operating Systems
+ * University: University of Colorado Boulder
+ *
+ * scheduling_point_feasibility() checks every l * T_k <= T_i for every k <= i
+ * (Lehoczky, Sha and Ding), recomputing the full demand at each one. Bini and
+ * Buttazzo showed that a much smaller set is enough: task i is schedulable iff
+ * W_i(t) <= t for some t in P_{i-1}(D_i), where
+ *
+ *     P_0(t) = { t },  P_j(t) = P_{j-1}(floor(t / T_j) T_j) U P_{j-1}(t)
+ *
+ * D_i is tried first, since at moderate load it nearly always meets its
+ * demand. Otherwise the set is built bottom up (one split per higher priority
+ * task, merged and deduplicated, with points that cannot possibly pass pruned)
+ * and scanned from the smallest point with an early exit on the first one that
+ * meets its demand. Each demand is simply recomputed in integer arithmetic and
+ * stops summing as soon as it exceeds t.
+ *
+ * The naive version stays in feasibility_tests.c as the reference oracle; the
+ * benchmark (make bench) also checks that both agree on every task set.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "feasibility.h"
+
+typedef struct
+{
+    U64_T *point;
+    U32_T count, capacity;
+} point_set_t;
+
+static int reserve(point_set_t *set, U32_T count)
+{
+    if (count <= set->capacity)
+        return TRUE;
+    U32_T capacity = set->capacity ? set->capacity : 64;
+    while (capacity < count)
+        capacity *= 2;
+    U64_T *grown = realloc(set->point, capacity * sizeof(U64_T));
+    if (grown == NULL)
+        return FALSE;
+    set->point = grown;
+    set->capacity = capacity;
+    return TRUE;
+}
+
+/*
+ * Builds P_{i-1}(deadline), ascending and without duplicates, into the first
+ * half of the buffer. t -> floor(t / T_j) T_j is monotone, so each split of a
+ * sorted set is sorted too and the two are merged instead of sorted. Points
+ * below the sum of C_0..C_i are dropped: every task has at least one job
+ * released in [0, t), so no such t can meet its demand.
+ */
+static int build_points(point_set_t *set, U32_T i, U32_T period[], U64_T minPoint, U32_T deadline)
+{
+    set->count = 0;
+    if (!reserve(set, 2))
+        return FALSE;
+    set->point[set->count++] = deadline;
+
+    for (U32_T j = i; j-- > 0 && set->count > 0; )
+    {
+        U32_T n = set->count, a = 0, b = n, out = 0, split = n;
+
+        if (!reserve(set, 4 * n))
+            return FALSE;
+        U64_T *cur = set->point, *low = cur + n, *merged = cur + 2 * n;
+
+        for (U32_T p = 0; p < n; p++)
+        {
+            U64_T t = (cur[p] / period[j]) * period[j];
+            if (t >= minPoint && t != cur[p] && (split == n || t != low[split - n - 1]))
+                low[split++ - n] = t;
+        }
+
+        // Merge cur[0, n) with low[0, split - n).
+        while (a < n || b < split)
+        {
+            U64_T t;
+            if (b == split || (a < n && cur[a] <= low[b - n]))
+                t = cur[a++];
+            else
+                t = low[b++ - n];
+            if (out == 0 || merged[out - 1] != t)
+                merged[out++] = t;
+        }
+        memmove(cur, merged, out * sizeof(U64_T));
+        set->count = out;
+    }
+    return TRUE;
+}
+
+static int meets_demand(U32_T i, U32_T period[], U32_T wcet[], U64_T t)
+{
+    U64_T demand = wcet[i];
+    for (U32_T j = 0; j < i && demand <= t; j++)
+        demand += ceil_div(t, period[j]) * wcet[j];
+    return demand <= t;
+}
+
+int scheduling_point_feasibility_fast(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    static __thread point_set_t points;
+    U64_T minPoint = 0;
+
+    for (U32_T i = 0; i < numServices; i++)
+    {
+        int status = FALSE;
+
+        minPoint += wcet[i];
+        if (minPoint > deadline[i])
+            return FALSE;
+
+        // D_i itself is always in the set and is the point most likely to pass.
+        if (meets_demand(i, period, wcet, deadline[i]))
+            continue;
+
+        if (build_points(&points, i, period, minPoint, deadline[i]) != TRUE)
+        {
+            fprintf(stderr, "scheduling point: out of memory\n");
+            return FALSE;
+        }
+
+        for (U32_T p = 0; p + 1 < points.count && !status; p++)
+            status = meets_demand(i, period, wcet, points.point[p]);
+        if (!status)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * Runs both versions on the same random task sets (D = T, rate monotonic order) and reports the
+ * time each one takes. Returns FALSE if they ever disagree.
+ */
+int run_sched_point_bench(const sweep_config_t *cfg)
+{
+    U64_T sets = (U64_T)cfg->setsPerPoint;
+    U32_T points = (U32_T)((cfg->maxUtil - cfg->minUtil) / cfg->stepUtil + 1e-9) + 1;
+    task_set_t *set = malloc(sizeof(*set));
+    U32_T (*period)[MAX_TASKS] = malloc(points * sets * sizeof(*period));
+    U32_T (*wcet)[MAX_TASKS] = malloc(points * sets * sizeof(*wcet));
+    U32_T *count = malloc(points * sets * sizeof(*count));
+    char *valid = malloc(points * sets);
+    char *naive = malloc(points * sets);
+    U64_T total = 0, mismatches = 0, feasible = 0;
+    double t0, naiveTime, fastTime;
+
+    if (set == NULL || period == NULL || wcet == NULL || count == NULL || valid == NULL || naive == NULL)
+    {
+        fprintf(stderr, "bench: out of memory\n");
+        return FALSE;
+    }
+
+    // Generate first, so only the tests themselves are timed.
+    for (U64_T k = 0; k < points * sets; k++)
+    {
+        double utilization = cfg->minUtil + (k / sets) * cfg->stepUtil;
+        valid[k] = (char)sweep_generate_task_set(cfg, utilization, k, set);
+        if (!valid[k])
+            continue;
+        assign_priorities(set, PRIO_RM);
+        count[k] = set->count;
+        for (U32_T i = 0; i < set->count; i++)
+        {
+            period[k][i] = set->task[i].period;
+            wcet[k][i] = set->task[i].wcet;
+        }
+        total++;
+    }
+
+    t0 = now_seconds();
+    for (U64_T k = 0; k < points * sets; k++)
+        if (valid[k])
+            naive[k] = (char)scheduling_point_feasibility(count[k], period[k], wcet[k], period[k]);
+    naiveTime = now_seconds() - t0;
+
+    t0 = now_seconds();
+    for (U64_T k = 0; k < points * sets; k++)
+    {
+        if (!valid[k])
+            continue;
+        int fast = scheduling_point_feasibility_fast(count[k], period[k], wcet[k], period[k]);
+        if (fast != naive[k])
+            mismatches++;
+        feasible += fast ? 1 : 0;
+    }
+    fastTime = now_seconds() - t0;
+
+    printf("bench: %llu task sets, %u-%u tasks, T %u-%u (%s), %llu feasible\n",
+           total, cfg->minTasks, cfg->maxTasks, cfg->minPeriod, cfg->maxPeriod,
+           cfg->logPeriods ? "log-uniform" : "uniform", feasible);
+    printf("bench: naive scheduling point  %10.3f ms  (%8.3f us/set)\n", naiveTime * 1e3, naiveTime * 1e6 / total);
+    printf("bench: pruned scheduling point %10.3f ms  (%8.3f us/set)  speedup %.1fx\n",
+           fastTime * 1e3, fastTime * 1e6 / total, fastTime > 0 ? naiveTime / fastTime : 0.0);
+    printf("bench: %llu mismatches\n", mismatches);
+
+    free(naive);
+    free(valid);
+    free(count);
+    free(wcet);
+    free(period);
+    free(set);
+    return mismatches == 0 ? TRUE : FALSE;
+}
@@ -0,0 +1,559 @@
+/*
+ * Discrete-event schedule simulator for RM, DM, EDF and LLF.
+ * Author: Kiran Jojare, Ayswariya Kannan
+ * Course: ECEN 5623 Real-Time Operating Systems
+ * University: University of Colorado Boulder
+ *
+ * Plays a task set on one preemptive processor from a synchronous release at
+ * t = 0. Job k of task i is nominally released at k T_i, arrives up to J_i
+ * later (uniform draw, from the -S seed) and has its deadline at k T_i + D_i;
+ * response times are measured from the nominal release, as in rta.c. Jobs are
+ * released until the horizon (one hyperperiod by default) and the simulation
+ * then runs until every released job has completed, late or not.
+ *
+ * Time only advances from event to event: the next release, the end of the
+ * running job or of its context switch, and for LLF the instant a waiting
+ * job's laxity drops below the running one's. The cost is O(log n) per event,
+ * whatever the time unit, so hyperperiods of millions of ticks are cheap.
+ *
+ *   RM, DM  fixed priority, the task set order after assign_priorities()
+ *   EDF     earliest absolute deadline
+ *   LLF     least laxity, D - t - remaining work. A waiting job's laxity falls
+ *           with time while the running job's stays put, so waiting jobs are
+ *           kept ordered by their latest start time d - remaining instead.
+ *
+ * A job is only preempted by a strictly better one; ties keep the running
+ * job, then go to the earlier release and the lower task index. Every
+ * dispatch of another job than the one that ran last costs the switch
+ * overhead, spent before the job executes and never preempted. Under LLF a
+ * dispatched job also executes one time unit before laxity alone can preempt
+ * it again, otherwise two jobs with equal laxity and a switch overhead would
+ * hand the processor back and forth without either making progress. Blocking
+ * terms (B) are not simulated, since there are no shared resources.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "feasibility.h"
+
+#define SIM_NEVER       (~0ULL)
+#define SIM_NO_TASK     (~0U)
+#define MAX_GANTT_WIDTH 1000
+
+static const char *const policyNames[SIM_POLICIES] = { "RM", "DM", "EDF", "LLF" };
+
+typedef struct
+{
+    U32_T task;
+    U32_T preemptions;
+    U64_T job;          // Job number within its task
+    U64_T nominal;      // k T, response times are measured from here
+    U64_T release;      // Nominal release plus the jitter draw
+    U64_T deadline;     // Absolute deadline
+    U64_T remaining;    // Execution left
+    U64_T overhead;     // Context switch left before it executes again
+    U64_T start;        // First dispatch, SIM_NEVER before
+    long long key;      // Ready queue key, smaller runs first
+} sim_job_t;
+
+typedef struct
+{
+    U64_T jobs, misses, preemptions;
+    U64_T bestResponse, worstResponse, sumResponse;
+} sim_task_stats_t;
+
+typedef struct
+{
+    U64_T horizon;          // Releases stop here
+    U64_T end;              // Completion of the last job
+    U64_T busy, overhead;   // Time spent executing jobs and switching
+    U64_T jobs, misses, preemptions, switches;
+    sim_task_stats_t task[MAX_TASKS];
+} sim_result_t;
+
+typedef struct
+{
+    const task_set_t *set;
+    const sim_config_t *cfg;
+    int policy;
+    U64_T horizon;
+    sim_result_t *result;
+
+    sim_job_t *ready;                   // Binary heap on key
+    U32_T readyCount, readyCapacity;
+
+    U32_T pending[MAX_TASKS];           // Binary heap of tasks on their next release
+    U32_T pendingCount;
+    U64_T nextJob[MAX_TASKS];
+    U64_T nextRelease[MAX_TASKS];
+    U64_T random;
+
+    FILE *jobs, *trace;
+    char *gantt;                        // count rows of ganttWidth columns
+
+    int segOpen, segSwitch;             // Execution segment not yet written to the trace
+    U32_T segTask;
+    U64_T segJob, segStart, segEnd;
+} sim_state_t;
+
+// Latest start time, the LLF key: laxity plus the current time.
+static long long latest_start(const sim_job_t *job)
+{
+    return (long long)job->deadline - (long long)(job->remaining + job->overhead);
+}
+
+static long long waiting_key(const sim_state_t *s, const sim_job_t *job)
+{
+    switch (s->policy)
+    {
+        case SIM_EDF: return (long long)job->deadline;
+        case SIM_LLF: return latest_start(job);
+        default:      return job->task;
+    }
+}
+
+static int job_before(const sim_job_t *a, const sim_job_t *b)
+{
+    if (a->key != b->key)
+        return a->key < b->key;
+    if (a->nominal != b->nominal)
+        return a->nominal < b->nominal;
+    return a->task < b->task;
+}
+
+static void ready_push(sim_state_t *s, const sim_job_t *job)
+{
+    U32_T i;
+
+    if (s->readyCount == s->readyCapacity)
+    {
+        s->readyCapacity = s->readyCapacity ? 2 * s->readyCapacity : 64;
+        s->ready = realloc(s->ready, s->readyCapacity * sizeof(*s->ready));
+        if (s->ready == NULL)
+        {
+            fprintf(stderr, "sim: out of memory\n");
+            exit(2);
+        }
+    }
+
+    for (i = s->readyCount++; i > 0 && job_before(job, &s->ready[(i - 1) / 2]); i = (i - 1) / 2)
+        s->ready[i] = s->ready[(i - 1) / 2];
+    s->ready[i] = *job;
+}
+
+static sim_job_t ready_pop(sim_state_t *s)
+{
+    sim_job_t top = s->ready[0];
+    sim_job_t last = s->ready[--s->readyCount];
+    U32_T i = 0;
+
+    for (;;)
+    {
+        U32_T child = 2 * i + 1;
+        if (child >= s->readyCount)
+            break;
+        if (child + 1 < s->readyCount && job_before(&s->ready[child + 1], &s->ready[child]))
+            child++;
+        if (!job_before(&s->ready[child], &last))
+            break;
+        s->ready[i] = s->ready[child];
+        i = child;
+    }
+    if (s->readyCount > 0)
+        s->ready[i] = last;
+    return top;
+}
+
+static int pending_before(const sim_state_t *s, U32_T a, U32_T b)
+{
+    if (s->nextRelease[a] != s->nextRelease[b])
+        return s->nextRelease[a] < s->nextRelease[b];
+    return a < b;
+}
+
+static void pending_sift_down(sim_state_t *s, U32_T i)
+{
+    U32_T task = s->pending[i];
+
+    for (;;)
+    {
+        U32_T child = 2 * i + 1;
+        if (child >= s->pendingCount)
+            break;
+        if (child + 1 < s->pendingCount && pending_before(s, s->pending[child + 1], s->pending[child]))
+            child++;
+        if (!pending_before(s, s->pending[child], task))
+            break;
+        s->pending[i] = s->pending[child];
+        i = child;
+    }
+    s->pending[i] = task;
+}
+
+// Draws the arrival of the task's next job. FALSE once the task is past the horizon.
+static int schedule_next(sim_state_t *s, U32_T i, U64_T lastRelease)
+{
+    const task_t *t = &s->set->task[i];
+    U64_T nominal = s->nextJob[i] * t->period;
+    U64_T release = nominal;
+
+    if (t->jitter != 0)
+        release += next_random(&s->random) % ((U64_T)t->jitter + 1);
+    // Jobs of one task arrive in order even when J > T.
+    s->nextRelease[i] = (release > lastRelease) ? release : lastRelease;
+    return nominal < s->horizon;
+}
+
+// Releases the job of the task at the top of the pending heap.
+static void release_job(sim_state_t *s)
+{
+    U32_T i = s->pending[0];
+    const task_t *t = &s->set->task[i];
+    sim_job_t job;
+
+    memset(&job, 0, sizeof(job));
+    job.task = i;
+    job.job = s->nextJob[i]++;
+    job.nominal = job.job * t->period;
+    job.release = s->nextRelease[i];
+    job.deadline = job.nominal + t->deadline;
+    job.remaining = t->wcet;
+    job.start = SIM_NEVER;
+    job.key = waiting_key(s, &job);
+    ready_push(s, &job);
+
+    if (!schedule_next(s, i, job.release))
+        s->pending[0] = s->pending[--s->pendingCount];
+    if (s->pendingCount > 0)
+        pending_sift_down(s, 0);
+}
+
+static U32_T gantt_column(const sim_state_t *s, U64_T t)
+{
+    return (U32_T)((long double)t * s->cfg->ganttWidth / s->horizon);
+}
+
+static void gantt_mark(sim_state_t *s, U32_T task, U64_T start, U64_T end, char mark)
+{
+    char *row = &s->gantt[(size_t)task * s->cfg->ganttWidth];
+
+    if (start >= s->horizon)
+        return;
+    if (end > s->horizon)
+        end = s->horizon;
+    for (U32_T c = gantt_column(s, start); c <= gantt_column(s, end - 1); c++)
+    {
+        // Execution shows over a switch, a deadline miss over both.
+        if (row[c] == '.' || (row[c] == '+' && mark == '#') || mark == '!')
+            row[c] = mark;
+    }
+}
+
+static void flush_segment(sim_state_t *s)
+{
+    if (!s->segOpen)
+        return;
+    if (s->trace != NULL)
+        fprintf(s->trace, "%llu %llu %s %llu%s\n", s->segStart, s->segEnd, s->set->task[s->segTask].name,
+                s->segJob, s->segSwitch ? " cs" : "");
+    if (s->gantt != NULL)
+        gantt_mark(s, s->segTask, s->segStart, s->segEnd, s->segSwitch ? '+' : '#');
+    s->segOpen = FALSE;
+}
+
+// Adds [start, end) to the trace, merged with the previous segment when it simply continues it.
+static void add_segment(sim_state_t *s, const sim_job_t *job, U64_T start, U64_T end, int isSwitch)
+{
+    if (s->segOpen && s->segEnd == start && s->segTask == job->task && s->segJob == job->job &&
+        s->segSwitch == isSwitch)
+    {
+        s->segEnd = end;
+        return;
+    }
+    flush_segment(s);
+    s->segOpen = TRUE;
+    s->segSwitch = isSwitch;
+    s->segTask = job->task;
+    s->segJob = job->job;
+    s->segStart = start;
+    s->segEnd = end;
+}
+
+static void execute(sim_state_t *s, sim_job_t *job, U64_T now, U64_T until)
+{
+    U64_T dt = until - now;
+    U64_T cs = (dt < job->overhead) ? dt : job->overhead;
+
+    if (cs > 0)
+    {
+        add_segment(s, job, now, now + cs, TRUE);
+        job->overhead -= cs;
+        s->result->overhead += cs;
+        now += cs;
+        dt -= cs;
+    }
+    if (dt > 0)
+    {
+        add_segment(s, job, now, now + dt, FALSE);
+        job->remaining -= dt;
+        s->result->busy += dt;
+    }
+}
+
+static void complete_job(sim_state_t *s, const sim_job_t *job, U64_T now)
+{
+    sim_task_stats_t *st = &s->result->task[job->task];
+    U64_T response = now - job->nominal;
+    int missed = now > job->deadline;
+
+    st->jobs++;
+    st->sumResponse += response;
+    if (response > st->worstResponse)
+        st->worstResponse = response;
+    if (st->jobs == 1 || response < st->bestResponse)
+        st->bestResponse = response;
+    s->result->jobs++;
+    if (missed)
+    {
+        st->misses++;
+        s->result->misses++;
+        if (s->gantt != NULL)
+            gantt_mark(s, job->task, job->deadline, job->deadline + 1, '!');
+    }
+
+    if (s->jobs != NULL)
+        fprintf(s->jobs, "%s,%s,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%d,%u\n", policyNames[s->policy],
+                s->set->task[job->task].name, job->job, job->nominal, job->release, job->start, now, response,
+                job->deadline, missed, job->preemptions);
+}
+
+static int simulate_schedule(const task_set_t *set, int policy, const sim_config_t *cfg, sim_result_t *result,
+                             FILE *jobs, FILE *trace, char *gantt)
+{
+    sim_state_t s;
+    sim_job_t run;
+    int running = FALSE, progressed = FALSE;
+    U32_T lastTask = SIM_NO_TASK;
+    U64_T lastJob = 0, now = 0;
+
+    memset(&s, 0, sizeof(s));
+    memset(result, 0, sizeof(*result));
+    s.set = set;
+    s.cfg = cfg;
+    s.policy = policy;
+    s.result = result;
+    s.horizon = (cfg->horizon != 0) ? cfg->horizon : task_set_hyperperiod(set);
+    s.random = cfg->seed;
+    s.jobs = jobs;
+    s.trace = trace;
+    s.gantt = gantt;
+    if (s.horizon == 0)
+    {
+        fprintf(stderr, "sim: the hyperperiod does not fit in 64 bits, give a horizon with -H\n");
+        return FALSE;
+    }
+    result->horizon = s.horizon;
+
+    for (U32_T i = 0; i < set->count; i++)
+    {
+        schedule_next(&s, i, 0);
+        s.pending[s.pendingCount++] = i;
+    }
+    for (U32_T i = s.pendingCount / 2; i-- > 0;)
+        pending_sift_down(&s, i);
+
+    for (;;)
+    {
+        U64_T next, end, overhead;
+
+        while (s.pendingCount > 0 && s.nextRelease[s.pending[0]] <= now)
+            release_job(&s);
+
+        // Preemption: never during a context switch, and under LLF not before the job has run.
+        if (running && s.readyCount > 0 && run.overhead == 0 && (policy != SIM_LLF || progressed))
+        {
+            run.key = (policy == SIM_LLF) ? latest_start(&run) : run.key;
+            if (run.key > s.ready[0].key)
+            {
+                run.preemptions++;
+                result->task[run.task].preemptions++;
+                result->preemptions++;
+                ready_push(&s, &run);
+                running = FALSE;
+            }
+        }
+
+        if (!running && s.readyCount > 0)
+        {
+            run = ready_pop(&s);
+            running = TRUE;
+            progressed = FALSE;
+            if (run.task != lastTask || run.job != lastJob)
+            {
+                run.overhead = cfg->switchCost;
+                result->switches++;
+                lastTask = run.task;
+                lastJob = run.job;
+            }
+            if (run.start == SIM_NEVER)
+                run.start = now;
+        }
+
+        next = (s.pendingCount > 0) ? s.nextRelease[s.pending[0]] : SIM_NEVER;
+        if (!running)
+        {
+            if (next == SIM_NEVER)
+                break;
+            // Idle until the next release; the next job pays for the switch back.
+            lastTask = SIM_NO_TASK;
+            now = next;
+            continue;
+        }
+
+        end = now + run.overhead + ((run.overhead > 0) ? 0 : run.remaining);
+        if (end < next)
+            next = end;
+        if (policy == SIM_LLF && run.overhead == 0 && s.readyCount > 0)
+        {
+            // The running job's latest start grows by one per time unit; the best waiting one stays put.
+            long long gap = s.ready[0].key - latest_start(&run);
+            U64_T cross = now + (U64_T)((gap > 0) ? gap : 0) + 1;
+            if (cross < next)
+                next = cross;
+        }
+
+        overhead = run.overhead;
+        execute(&s, &run, now, next);
+        if (overhead == 0)
+            progressed = TRUE;
+        now = next;
+
+        if (run.overhead == 0 && run.remaining == 0)
+        {
+            complete_job(&s, &run, now);
+            running = FALSE;
+        }
+    }
+
+    flush_segment(&s);
+    result->end = now;
+    free(s.ready);
+    return TRUE;
+}
+
+static void print_result(const task_set_t *set, int policy, const sim_config_t *cfg, const sim_result_t *result,
+                         const rta_result_t *rta)
+{
+    U64_T span = (result->end > 0) ? result->end : 1;
+
+    printf("%s: horizon %llu%s, switch overhead %u\n", policyNames[policy], result->horizon,
+           (cfg->horizon == 0) ? " (hyperperiod)" : "", cfg->switchCost);
+    printf("%-24s %10s %10s %10s %10s %10s %10s %10s\n", "name", "jobs", "misses", "R best", "R avg", "R worst",
+           "preempted", rta != NULL ? "R bound" : "");
+    for (U32_T i = 0; i < set->count; i++)
+    {
+        const sim_task_stats_t *st = &result->task[i];
+
+        printf("%-24s %10llu %10llu %10llu %10.1f %10llu %10llu", set->task[i].name, st->jobs, st->misses,
+               st->bestResponse, st->jobs ? (double)st->sumResponse / st->jobs : 0.0, st->worstResponse,
+               st->preemptions);
+        if (rta == NULL)
+            printf("\n");
+        else if (!rta[i].feasible)
+            printf(" %9llu+\n", rta[i].response);
+        else
+            // Without overhead the simulated worst case can never exceed the analysis.
+            printf(" %10llu%s\n", rta[i].response,
+                   (cfg->switchCost == 0 && st->worstResponse > rta[i].response) ? " exceeded" : "");
+    }
+    printf("%s: %llu of %llu jobs missed, %llu preemptions, %llu switches, busy %.2f%%, overhead %.2f%%, "
+           "last job done at %llu\n\n", policyNames[policy], result->misses, result->jobs, result->preemptions,
+           result->switches, 100.0 * result->busy / span, 100.0 * result->overhead / span, result->end);
+}
+
+static void print_gantt(const task_set_t *set, int policy, const sim_config_t *cfg, U64_T horizon, const char *gantt)
+{
+    printf("%s Gantt, 0 .. %llu, %.2f time units per column ('#' runs, '+' switch, '!' missed deadline)\n",
+           policyNames[policy], horizon, (double)horizon / cfg->ganttWidth);
+    for (U32_T i = 0; i < set->count; i++)
+        printf("%-12.12s |%.*s|\n", set->task[i].name, (int)cfg->ganttWidth, &gantt[(size_t)i * cfg->ganttWidth]);
+    printf("\n");
+}
+
+/*
+ * Simulates the task set under one policy, or all four when policy is
+ * SIM_ALL, and prints a per-task report (with the RTA bound for RM and DM).
+ * Returns TRUE if no job missed its deadline.
+ */
+int run_simulation(const task_set_t *set, int policy, const sim_config_t *cfg)
+{
+    static task_set_t ordered;
+    static sim_result_t result[SIM_POLICIES];
+    static rta_result_t rta[MAX_TASKS];
+    FILE *jobs = NULL, *trace = NULL;
+    char *gantt = NULL;
+    int ok = TRUE, first = (policy == SIM_ALL) ? 0 : policy, last = (policy == SIM_ALL) ? SIM_POLICIES - 1 : policy;
+
+    if (cfg->ganttWidth > MAX_GANTT_WIDTH)
+    {
+        fprintf(stderr, "sim: at most %d Gantt columns\n", MAX_GANTT_WIDTH);
+        return FALSE;
+    }
+    if (cfg->jobsFile != NULL && (jobs = fopen(cfg->jobsFile, "w")) == NULL)
+    {
+        perror(cfg->jobsFile);
+        return FALSE;
+    }
+    if (cfg->traceFile != NULL && (trace = fopen(cfg->traceFile, "w")) == NULL)
+    {
+        perror(cfg->traceFile);
+        return FALSE;
+    }
+    if (jobs != NULL)
+        fprintf(jobs, "policy,task,job,nominal,release,start,finish,response,deadline,missed,preemptions\n");
+    if (cfg->ganttWidth > 0)
+        gantt = malloc((size_t)set->count * cfg->ganttWidth);
+
+    for (int p = first; p <= last; p++)
+    {
+        int fixed = (p == SIM_RM || p == SIM_DM);
+
+        ordered = *set;
+        if (fixed)
+        {
+            assign_priorities(&ordered, (p == SIM_RM) ? PRIO_RM : PRIO_DM);
+            response_time_analysis(&ordered, rta);
+        }
+        if (gantt != NULL)
+            memset(gantt, '.', (size_t)set->count * cfg->ganttWidth);
+        if (trace != NULL)
+            fprintf(trace, "# %s: start end task job [cs]\n", policyNames[p]);
+
+        if (simulate_schedule(&ordered, p, cfg, &result[p], jobs, trace, gantt) != TRUE)
+        {
+            ok = FALSE;
+            break;
+        }
+        print_result(&ordered, p, cfg, &result[p], fixed ? rta : NULL);
+        if (gantt != NULL)
+            print_gantt(&ordered, p, cfg, result[p].horizon, gantt);
+        if (result[p].misses != 0)
+            ok = FALSE;
+    }
+
+    if (policy == SIM_ALL && first < SIM_POLICIES)
+    {
+        printf("%-8s %10s %12s %12s %12s\n", "policy", "misses", "preemptions", "switches", "last done");
+        for (int p = 0; p < SIM_POLICIES; p++)
+            printf("%-8s %10llu %12llu %12llu %12llu\n", policyNames[p], result[p].misses, result[p].preemptions,
+                   result[p].switches, result[p].end);
+    }
+
+    free(gantt);
+    if (trace != NULL)
+        fclose(trace);
+    if (jobs != NULL)
+        fclose(jobs);
+    return ok;
+}
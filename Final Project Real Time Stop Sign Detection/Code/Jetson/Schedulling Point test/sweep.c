@@ -0,0 +1,258 @@
+/*
+ * Schedulability sweep over randomly generated task sets.
+ * Author: Kiran Jojare, Ayswariya Kannan
+ * Course: ECEN 5623 Real-Time Operating Systems
+ * University: University of Colorado Boulder
+ *
+ * For every utilization point the sweep generates a batch of synthetic task
+ * sets (UUniFast utilizations, uniform or log-uniform periods, optional
+ * constrained deadlines), runs each feasibility test on them and writes the
+ * fraction found schedulable to a CSV file, one row per utilization point.
+ *
+ * The scheduling point column uses the pruned test (sched_point.c), which
+ * unlike the naive one is exact for D < T as well.
+ *
+ * Task sets are spread over a pthread pool in chunks. Task set k of a run is
+ * always generated from seed + k, so results do not depend on the number of
+ * threads.
+ */
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "feasibility.h"
+
+#define SWEEP_CHUNK     256
+
+typedef struct
+{
+    const sweep_config_t *cfg;
+    U32_T points;               // Number of utilization points
+    U64_T totalSets;            // points * setsPerPoint
+    U64_T next;                 // Next task set index handed out
+    U64_T (*accepted)[SWEEP_TESTS];
+    pthread_mutex_t lock;
+} sweep_state_t;
+
+static const char *const testNames[SWEEP_TESTS] =
+{
+    "rm_lub", "completion_time", "scheduling_point", "rta_dm", "edf_demand"
+};
+
+// splitmix64: small, fast and good enough to seed and drive UUniFast (and the jitter draws of sim.c).
+U64_T next_random(U64_T *state)
+{
+    U64_T z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Uniform in (0, 1).
+static double next_unit(U64_T *state)
+{
+    return ((next_random(state) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+static U32_T random_period(const sweep_config_t *cfg, U64_T *state)
+{
+    double x = next_unit(state);
+    if (cfg->logPeriods)
+        return (U32_T)llround(exp(log((double)cfg->minPeriod) + x * (log((double)cfg->maxPeriod) - log((double)cfg->minPeriod))));
+    return cfg->minPeriod + (U32_T)(x * (cfg->maxPeriod - cfg->minPeriod + 1));
+}
+
+/*
+ * Generates task set index k. Returns FALSE for the (rare) sets whose rounded
+ * WCETs do not fit their periods; they are counted as not schedulable.
+ */
+int sweep_generate_task_set(const sweep_config_t *cfg, double utilization, U64_T k, task_set_t *set)
+{
+    U64_T state = cfg->seed + k;
+    U32_T n = cfg->minTasks;
+    double remaining = utilization;
+
+    if (cfg->maxTasks > cfg->minTasks)
+        n += (U32_T)(next_random(&state) % (cfg->maxTasks - cfg->minTasks + 1));
+
+    set->count = n;
+    for (U32_T i = 0; i < n; i++)
+    {
+        task_t *t = &set->task[i];
+        double u;
+
+        // UUniFast (Bini and Buttazzo): unbiased utilizations summing to the target.
+        if (i < n - 1)
+        {
+            double next = remaining * pow(next_unit(&state), 1.0 / (n - i - 1));
+            u = remaining - next;
+            remaining = next;
+        }
+        else
+        {
+            u = remaining;
+        }
+
+        snprintf(t->name, TASK_NAME_LEN, "T%u", i + 1);
+        t->period = random_period(cfg, &state);
+        t->wcet = (U32_T)llround(u * t->period);
+        if (t->wcet == 0)
+            t->wcet = 1;
+        if (t->wcet > t->period)
+            return FALSE;
+        t->deadline = t->period;
+        if (cfg->minDeadlineRatio < 1.0)
+        {
+            double ratio = cfg->minDeadlineRatio + next_unit(&state) * (1.0 - cfg->minDeadlineRatio);
+            t->deadline = (U32_T)llround(ratio * t->period);
+            if (t->deadline < t->wcet)
+                t->deadline = t->wcet;
+        }
+        t->jitter = 0;
+        t->blocking = 0;
+    }
+    return TRUE;
+}
+
+static void evaluate(task_set_t *set, rta_result_t result[], int accepted[SWEEP_TESTS])
+{
+    U32_T period[MAX_TASKS], wcet[MAX_TASKS], deadline[MAX_TASKS];
+    U64_T failTime;
+    int implicit = TRUE;
+
+    // The classic tests assume rate monotonic order; the LUB also needs D = T.
+    assign_priorities(set, PRIO_RM);
+    for (U32_T i = 0; i < set->count; i++)
+    {
+        period[i] = set->task[i].period;
+        wcet[i] = set->task[i].wcet;
+        deadline[i] = set->task[i].deadline;
+        if (deadline[i] != period[i])
+            implicit = FALSE;
+    }
+
+    accepted[0] = implicit && rate_monotonic_least_upper_bound(set->count, period, wcet, deadline);
+    accepted[1] = completion_time_feasibility(set->count, period, wcet, deadline);
+    accepted[2] = scheduling_point_feasibility_fast(set->count, period, wcet, deadline);
+
+    assign_priorities(set, PRIO_DM);
+    accepted[3] = response_time_analysis(set, result);
+    accepted[4] = edf_demand_feasibility(set, &failTime);
+}
+
+static void *sweep_worker(void *arg)
+{
+    sweep_state_t *st = arg;
+    const sweep_config_t *cfg = st->cfg;
+    U64_T (*local)[SWEEP_TESTS] = calloc(st->points, sizeof(*local));
+    task_set_t *set = malloc(sizeof(*set));
+    rta_result_t *result = malloc(MAX_TASKS * sizeof(*result));
+
+    if (local == NULL || set == NULL || result == NULL)
+    {
+        fprintf(stderr, "sweep: out of memory\n");
+        exit(2);
+    }
+
+    for (;;)
+    {
+        U64_T begin, end;
+
+        pthread_mutex_lock(&st->lock);
+        begin = st->next;
+        st->next = (begin + SWEEP_CHUNK < st->totalSets) ? begin + SWEEP_CHUNK : st->totalSets;
+        end = st->next;
+        pthread_mutex_unlock(&st->lock);
+
+        if (begin >= end)
+            break;
+
+        for (U64_T k = begin; k < end; k++)
+        {
+            U32_T point = (U32_T)(k / cfg->setsPerPoint);
+            double utilization = cfg->minUtil + point * cfg->stepUtil;
+            int accepted[SWEEP_TESTS];
+
+            if (sweep_generate_task_set(cfg, utilization, k, set) != TRUE)
+                continue;
+            evaluate(set, result, accepted);
+            for (int t = 0; t < SWEEP_TESTS; t++)
+                local[point][t] += accepted[t] ? 1 : 0;
+        }
+    }
+
+    pthread_mutex_lock(&st->lock);
+    for (U32_T p = 0; p < st->points; p++)
+        for (int t = 0; t < SWEEP_TESTS; t++)
+            st->accepted[p][t] += local[p][t];
+    pthread_mutex_unlock(&st->lock);
+
+    free(result);
+    free(set);
+    free(local);
+    return NULL;
+}
+
+int run_sweep(const sweep_config_t *cfg)
+{
+    sweep_state_t st;
+    pthread_t *threads;
+    FILE *out;
+
+    if (cfg->minTasks == 0 || cfg->maxTasks < cfg->minTasks || cfg->maxTasks > MAX_TASKS ||
+        cfg->minPeriod == 0 || cfg->maxPeriod < cfg->minPeriod || cfg->stepUtil <= 0.0 ||
+        cfg->maxUtil < cfg->minUtil || cfg->setsPerPoint == 0 || cfg->threads == 0)
+    {
+        fprintf(stderr, "sweep: invalid configuration\n");
+        return FALSE;
+    }
+
+    memset(&st, 0, sizeof(st));
+    st.cfg = cfg;
+    st.points = (U32_T)floor((cfg->maxUtil - cfg->minUtil) / cfg->stepUtil + 1e-9) + 1;
+    st.totalSets = (U64_T)st.points * cfg->setsPerPoint;
+    st.accepted = calloc(st.points, sizeof(*st.accepted));
+    threads = calloc(cfg->threads, sizeof(*threads));
+    pthread_mutex_init(&st.lock, NULL);
+    if (st.accepted == NULL || threads == NULL)
+    {
+        fprintf(stderr, "sweep: out of memory\n");
+        return FALSE;
+    }
+
+    fprintf(stderr, "sweep: %u points x %u sets, %u-%u tasks, T %u-%u (%s), %u threads\n",
+            st.points, cfg->setsPerPoint, cfg->minTasks, cfg->maxTasks, cfg->minPeriod, cfg->maxPeriod,
+            cfg->logPeriods ? "log-uniform" : "uniform", cfg->threads);
+
+    for (U32_T i = 0; i < cfg->threads; i++)
+        pthread_create(&threads[i], NULL, sweep_worker, &st);
+    for (U32_T i = 0; i < cfg->threads; i++)
+        pthread_join(threads[i], NULL);
+
+    out = (cfg->output != NULL) ? fopen(cfg->output, "w") : stdout;
+    if (out == NULL)
+    {
+        perror(cfg->output);
+        return FALSE;
+    }
+    fprintf(out, "utilization,sets");
+    for (int t = 0; t < SWEEP_TESTS; t++)
+        fprintf(out, ",%s", testNames[t]);
+    fprintf(out, "\n");
+    for (U32_T p = 0; p < st.points; p++)
+    {
+        fprintf(out, "%.4f,%u", cfg->minUtil + p * cfg->stepUtil, cfg->setsPerPoint);
+        for (int t = 0; t < SWEEP_TESTS; t++)
+            fprintf(out, ",%.6f", (double)st.accepted[p][t] / cfg->setsPerPoint);
+        fprintf(out, "\n");
+    }
+    if (out != stdout)
+        fclose(out);
+
+    pthread_mutex_destroy(&st.lock);
+    free(threads);
+    free(st.accepted);
+    return TRUE;
+}
@@ -0,0 +1,200 @@
+/*
+ * Task set loader and helpers for the feasibility analysis engine.
+ * Author: Kiran Jojare, Ayswariya Kannan
+ * Course: ECEN 5623 Real-Time Operating Systems
+ * University: University of Colorado Boulder
+ *
+ * Task set files have one task per line:
+ *
+ *     name C T [D [J [B]]]
+ *
+ * D defaults to T, J and B to 0. Everything after a '#' is a comment, so the
+ * task set dump printed by the TIVA firmware at the end of a run can be
+ * loaded as is.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "feasibility.h"
+
+int load_task_set(const char *path, task_set_t *set)
+{
+    char line[256];
+    U32_T lineNo = 0;
+    FILE *fp = fopen(path, "r");
+
+    if (fp == NULL)
+    {
+        perror(path);
+        return FALSE;
+    }
+
+    set->count = 0;
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        task_t t;
+        char *comment = strchr(line, '#');
+        int fields;
+
+        lineNo++;
+        if (comment != NULL)
+            *comment = '\0';
+
+        memset(&t, 0, sizeof(t));
+        fields = sscanf(line, "%31s %u %u %u %u %u", t.name, &t.wcet, &t.period, &t.deadline, &t.jitter, &t.blocking);
+        if (fields <= 0)
+            continue;
+        if (fields < 3)
+        {
+            fprintf(stderr, "%s:%u: expected \"name C T [D [J [B]]]\"\n", path, lineNo);
+            fclose(fp);
+            return FALSE;
+        }
+        if (fields < 4)
+            t.deadline = t.period;
+
+        if (t.period == 0 || t.wcet == 0 || t.deadline == 0)
+        {
+            fprintf(stderr, "%s:%u: C, T and D must be positive\n", path, lineNo);
+            fclose(fp);
+            return FALSE;
+        }
+        if (set->count == MAX_TASKS)
+        {
+            fprintf(stderr, "%s:%u: more than %d tasks\n", path, lineNo, MAX_TASKS);
+            fclose(fp);
+            return FALSE;
+        }
+        set->task[set->count++] = t;
+    }
+
+    fclose(fp);
+    if (set->count == 0)
+    {
+        fprintf(stderr, "%s: no tasks\n", path);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static U32_T priority_key(const task_t *t, int policy)
+{
+    return (policy == PRIO_RM) ? t->period : t->deadline;
+}
+
+// Stable insertion sort, so equal keys keep their file order.
+void assign_priorities(task_set_t *set, int policy)
+{
+    if (policy == PRIO_FILE)
+        return;
+
+    for (U32_T i = 1; i < set->count; i++)
+    {
+        task_t t = set->task[i];
+        U32_T j = i;
+        while (j > 0 && priority_key(&set->task[j - 1], policy) > priority_key(&t, policy))
+        {
+            set->task[j] = set->task[j - 1];
+            j--;
+        }
+        set->task[j] = t;
+    }
+}
+
+void task_set_from_arrays(task_set_t *set, U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    memset(set, 0, sizeof(*set));
+    set->count = numServices;
+    for (U32_T i = 0; i < numServices; i++)
+    {
+        snprintf(set->task[i].name, TASK_NAME_LEN, "S%u", i + 1);
+        set->task[i].wcet = wcet[i];
+        set->task[i].period = period[i];
+        set->task[i].deadline = deadline[i];
+    }
+}
+
+static U64_T gcd(U64_T a, U64_T b)
+{
+    while (b != 0)
+    {
+        U64_T t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// LCM of all periods, or 0 if it does not fit in 64 bits.
+U64_T task_set_hyperperiod(const task_set_t *set)
+{
+    U64_T h = 1;
+    for (U32_T i = 0; i < set->count; i++)
+    {
+        U64_T step = set->task[i].period / gcd(h, set->task[i].period);
+        if (h > ~0ULL / step)
+            return 0;
+        h *= step;
+    }
+    return h;
+}
+
+/*
+ * Utilization of the first count tasks against 1: negative, 0 or positive.
+ * Exact with a reduced fraction; falls back to long double only when the
+ * common denominator no longer fits in 64 bits.
+ */
+int task_set_utilization_cmp(const task_set_t *set, U32_T count)
+{
+    U64_T num = 0, den = 1;
+    long double u = 0.0L;
+    int exact = TRUE;
+
+    for (U32_T i = 0; i < count; i++)
+    {
+        const task_t *t = &set->task[i];
+        u += (long double)t->wcet / t->period;
+        if (exact)
+        {
+            U64_T g = gcd(den, t->period);
+            U64_T scale = t->period / g;
+            U64_T newDen, newNum;
+
+            if (den > ~0ULL / scale || num > ~0ULL / scale)
+            {
+                exact = FALSE;
+                continue;
+            }
+            newDen = den * scale;
+            newNum = num * scale;
+            if ((U64_T)t->wcet * (den / g) > ~0ULL - newNum)
+            {
+                exact = FALSE;
+                continue;
+            }
+            num = newNum + (U64_T)t->wcet * (den / g);
+            den = newDen;
+            g = gcd(num, den);
+            num /= g;
+            den /= g;
+        }
+    }
+
+    if (!exact)
+    {
+        if (feasibility_verbose)
+            printf("Utilization compared in floating point (periods too large for an exact fraction)\n");
+        return (u > 1.0L) - (u < 1.0L);
+    }
+    return (num > den) - (num < den);
+}
+
+void print_task_set(const task_set_t *set)
+{
+    printf("%-24s %10s %10s %10s %10s %10s\n", "name", "C", "T", "D", "J", "B");
+    for (U32_T i = 0; i < set->count; i++)
+    {
+        const task_t *t = &set->task[i];
+        printf("%-24s %10u %10u %10u %10u %10u\n", t->name, t->wcet, t->period, t->deadline, t->jitter, t->blocking);
+    }
+}
@@ -1,107 +1,148 @@
-/*
-    FreeRTOS V7.0.2 - Copyright (C) 2011 Real Time Engineers Ltd.
-
-
-    ***************************************************************************
-     *                                                                       *
-     *    FreeRTOS tutorial books are available in pdf and paperback.        *
-     *    Complete, revised, and edited pdf reference manuals are also       *
-     *    available.                                                         *
-     *                                                                       *
-     *    Purchasing FreeRTOS documentation will not only help you, by       *
-     *    ensuring you get running as quickly as possible and with an        *
-     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
-     *    the FreeRTOS project to continue with its mission of providing     *
-     *    professional grade, cross platform, de facto standard solutions    *
-     *    for microcontrollers - completely free of charge!                  *
-     *                                                                       *
-     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
-     *                                                                       *
-     *    Thank you for using FreeRTOS, and thank you for your support!      *
-     *                                                                       *
-    ***************************************************************************
-
-
-    This file is part of the FreeRTOS distribution.
-
-    FreeRTOS is free software; you can redistribute it and/or modify it under
-    the terms of the GNU General Public License (version 2) as published by the
-    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
-    >>>NOTE<<< The modification to the GPL is included to allow you to
-    distribute a combined work that includes FreeRTOS without being obliged to
-    provide the source code for proprietary components outside of the FreeRTOS
-    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
-    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
-    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
-    more details. You should have received a copy of the GNU General Public
-    License and the FreeRTOS license exception along with FreeRTOS; if not it
-    can be viewed here: http://www.freertos.org/a00114.html and also obtained
-    by writing to Richard Barry, contact details for whom are available on the
-    FreeRTOS WEB site.
-
-    1 tab == 4 spaces!
-
-    http://www.FreeRTOS.org - Documentation, latest information, license and
-    contact details.
-
-    http://www.SafeRTOS.com - A version that is certified for use in safety
-    critical systems.
-
-    http://www.OpenRTOS.com - Commercial support, development, porting,
-    licensing and training services.
-*/
-
-#ifndef FREERTOS_CONFIG_H
-#define FREERTOS_CONFIG_H
-
-/*-----------------------------------------------------------
- * Application specific definitions.
- *
- * These definitions should be adjusted for your particular hardware and
- * application requirements.
- *
- * THESE PARAMETERS ARE DESCRIBED WITHIN THE 'CONFIGURATION' SECTION OF THE
- * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE.
- *
- * See http://www.freertos.org/a00110.html.
- *----------------------------------------------------------*/
-
-#define configUSE_PREEMPTION                1
-#define configUSE_IDLE_HOOK                 0
-#define configUSE_TICK_HOOK                 0
-#define configCPU_CLOCK_HZ                  ( ( unsigned long ) 50000000 )
-#define configTICK_RATE_HZ                  ( ( portTickType ) 1000 )
-#define configMINIMAL_STACK_SIZE            ( ( unsigned short ) 200 )
-#define configTOTAL_HEAP_SIZE               ( ( size_t ) ( 30000 ) )
-#define configMAX_TASK_NAME_LEN             ( 12 )
-#define configUSE_TRACE_FACILITY            1
-#define configUSE_16_BIT_TICKS              0
-#define configIDLE_SHOULD_YIELD             0
-#define configUSE_CO_ROUTINES               0
-#define configUSE_MUTEXES                   1
-#define configUSE_RECURSIVE_MUTEXES         1
-#define configCHECK_FOR_STACK_OVERFLOW      2
-
-#define configMAX_PRIORITIES                16
-#define configMAX_CO_ROUTINE_PRIORITIES     ( 2 )
-#define configQUEUE_REGISTRY_SIZE           10
-
-/* Set the following definitions to 1 to include the API function, or zero
-to exclude the API function. */
-
-#define INCLUDE_vTaskPrioritySet            1
-#define INCLUDE_uxTaskPriorityGet           1
-#define INCLUDE_vTaskDelete                 1
-#define INCLUDE_vTaskCleanUpResources       0
-#define INCLUDE_vTaskSuspend                1
-#define INCLUDE_vTaskDelayUntil             1
-#define INCLUDE_vTaskDelay                  1
-#define INCLUDE_uxTaskGetStackHighWaterMark 1
-
-/* Be ENORMOUSLY careful if you want to modify these two values and make sure
- * you read http://www.freertos.org/a00110.html#kernel_priority first!
- */
-#define configKERNEL_INTERRUPT_PRIORITY         ( 7 << 5 )    /* Priority 7, or 0xE0 as only the top three bits are implemented.  This is the lowest priority. */
-#define configMAX_SYSCALL_INTERRUPT_PRIORITY     ( 5 << 5 )  /* Priority 5, or 0xA0 as only the top three bits are implemented. */
-
-#endif /* FREERTOS_CONFIG_H */
+/*
+    FreeRTOS V7.0.2 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Application specific definitions.
+ *
+ * These definitions should be adjusted for your particular hardware and
+ * application requirements.
+ *
+ * THESE PARAMETERS ARE DESCRIBED WITHIN THE 'CONFIGURATION' SECTION OF THE
+ * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE.
+ *
+ * See http://www.freertos.org/a00110.html.
+ *----------------------------------------------------------*/
+
+#define configUSE_PREEMPTION                1
+#define configUSE_IDLE_HOOK                 0
+#define configUSE_TICK_HOOK                 1     /* Drives the sequencer, see sequencer.h. */
+#define configCPU_CLOCK_HZ                  ( ( unsigned long ) 50000000 )
+#define configTICK_RATE_HZ                  ( ( portTickType ) 1000 )
+#define configMINIMAL_STACK_SIZE            ( ( unsigned short ) 200 )
+#define configMAX_TASK_NAME_LEN             ( 12 )
+#define configUSE_TRACE_FACILITY            1
+#define configUSE_16_BIT_TICKS              0
+#define configIDLE_SHOULD_YIELD             0
+#define configUSE_CO_ROUTINES               0
+#define configUSE_MUTEXES                   1
+#define configUSE_RECURSIVE_MUTEXES         1
+#define configCHECK_FOR_STACK_OVERFLOW      2
+#define configUSE_APPLICATION_TASK_TAG      1
+#define configGENERATE_RUN_TIME_STATS       1
+
+/* 2 = tickless idle with the sequencer aware hook in tickless_idle.c, which
+ * needs TIMING_USE_DWT 0 in service_timing.h. 0 = tick every millisecond. */
+#define configUSE_TICKLESS_IDLE             2
+
+/* 1 = every task, queue and semaphore is created with the static API on
+ * buffers reserved at link time, and the heap is not used at all (needs
+ * FreeRTOS V9.0.0 or later). 0 = everything comes from the heap_2 region. */
+#define configSUPPORT_STATIC_ALLOCATION     0
+
+#if configSUPPORT_STATIC_ALLOCATION == 1
+#define configSUPPORT_DYNAMIC_ALLOCATION    0
+/* heap_2.c is still part of the project; keep its region at a token size. */
+#define configTOTAL_HEAP_SIZE               ( ( size_t ) ( 16 ) )
+#else
+#define configSUPPORT_DYNAMIC_ALLOCATION    1
+#define configTOTAL_HEAP_SIZE               ( ( size_t ) ( 24000 ) )
+#endif
+
+#define configMAX_PRIORITIES                16
+#define configMAX_CO_ROUTINE_PRIORITIES     ( 2 )
+#define configQUEUE_REGISTRY_SIZE           10
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+
+#define INCLUDE_vTaskPrioritySet            1
+#define INCLUDE_uxTaskPriorityGet           1
+#define INCLUDE_vTaskDelete                 1
+#define INCLUDE_vTaskCleanUpResources       0
+#define INCLUDE_vTaskSuspend                1
+#define INCLUDE_vTaskDelayUntil             1
+#define INCLUDE_vTaskDelay                  1
+#define INCLUDE_uxTaskGetStackHighWaterMark 1
+
+/* Be ENORMOUSLY careful if you want to modify these two values and make sure
+ * you read http://www.freertos.org/a00110.html#kernel_priority first!
+ */
+#define configKERNEL_INTERRUPT_PRIORITY         ( 7 << 5 )    /* Priority 7, or 0xE0 as only the top three bits are implemented.  This is the lowest priority. */
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY     ( 5 << 5 )  /* Priority 5, or 0xA0 as only the top three bits are implemented. */
+
+/* Per-service execution time accounting (service_timing.c). Sequenced services
+ * carry their index + 1 in the application task tag, every other task 0. */
+extern void ServiceTimingSwitchedIn(unsigned long tag);
+extern void ServiceTimingSwitchedOut(unsigned long tag);
+
+/* Run time statistics of every task (runtime_stats.c), clocked at 1 MHz by
+ * WTIMER0A. The switch in hook also counts switches by kernel task number. */
+extern void RuntimeStatsTimerInit(void);
+extern unsigned long RuntimeStatsCounter(void);
+extern void RuntimeStatsSwitchedIn(unsigned long taskNumber);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    RuntimeStatsTimerInit()
+#define portGET_RUN_TIME_COUNTER_VALUE()            RuntimeStatsCounter()
+
+#if configUSE_TICKLESS_IDLE == 2
+extern void TicklessSuppressTicksAndSleep(uint32_t expectedIdleTime);
+#define portSUPPRESS_TICKS_AND_SLEEP(xExpectedIdleTime) TicklessSuppressTicksAndSleep(xExpectedIdleTime)
+#endif
+
+#define traceTASK_SWITCHED_IN()     do { ServiceTimingSwitchedIn((unsigned long)pxCurrentTCB->pxTaskTag); \
+                                         RuntimeStatsSwitchedIn((unsigned long)pxCurrentTCB->uxTCBNumber); } while (0)
+#define traceTASK_SWITCHED_OUT()    ServiceTimingSwitchedOut((unsigned long)pxCurrentTCB->pxTaskTag)
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,199 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: admission.c
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Completion time admission test for the sequenced services. See
+ * admission.h.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "sequencer.h"
+#include "admission.h"
+
+#define ADMISSION_TICK_UNITS    (1UL << ADMISSION_TICK_SHIFT)
+#define ADMISSION_TICK_CYCLES   (configCPU_CLOCK_HZ / SEQ_TICK_HZ)
+
+// Cycles to time units: the product with ceil(2^32 / ADMISSION_TICK_CYCLES) is in 2^-32 ticks.
+// Both the scale and the final shift round up, so C is never underestimated.
+#define ADMISSION_CYCLE_SCALE   ((uint32_t)((0xFFFFFFFFULL + ADMISSION_TICK_CYCLES) / ADMISSION_TICK_CYCLES))
+
+// Every deadline in units must fit in 32 bits.
+typedef char admissionDeadlineCheck[(ADMISSION_TICK_SHIFT <= 16) ? 1 : -1];
+
+static AdmissionWcetFn s_measured = NULL;
+static AdmissionBlockingFn s_blocking = NULL;
+static uint32_t s_bound[SEQ_MAX_SERVICES];      // Response bound of the last accepted set, in units.
+
+/**
+ * Cycles to time units, rounded up.
+ */
+static uint32_t CyclesToUnits(uint32_t cycles) {
+    return (uint32_t)(((uint64_t)cycles * ADMISSION_CYCLE_SCALE + (1ULL << (32 - ADMISSION_TICK_SHIFT)) - 1) >> (32 - ADMISSION_TICK_SHIFT));
+}
+
+/**
+ * Execution time of service id in time units, at least one.
+ */
+static uint32_t WcetUnits(uint32_t id) {
+    uint32_t cycles = (s_measured != NULL) ? s_measured(id) : 0;
+    uint32_t units;
+
+    if (cycles == 0) {
+        cycles = (uint32_t)SequencerService(id)->wcetUs * (configCPU_CLOCK_HZ / 1000000);
+    }
+    cycles += cycles >> ADMISSION_WCET_MARGIN_SHIFT;
+    units = CyclesToUnits(cycles);
+    return (units == 0) ? 1 : units;
+}
+
+/**
+ * Blocking of service id by lower priority tasks in time units.
+ */
+static uint32_t BlockingUnits(uint32_t id) {
+    uint32_t us = (s_blocking != NULL) ? s_blocking(id) : 0;
+
+    if (us < ADMISSION_BLOCKING_US) {
+        us = ADMISSION_BLOCKING_US;
+    }
+    return CyclesToUnits(us * (configCPU_CLOCK_HZ / 1000000));
+}
+
+/**
+ * True if service j can delay service i: a higher or equal priority, or under EDF an earlier
+ * deadline (deadline monotonic, ties to the lower table index).
+ */
+static bool Interferes(uint32_t j, uint32_t i) {
+    const ServiceConfig* a = SequencerService(j);
+    const ServiceConfig* b = SequencerService(i);
+
+    if (j == i) {
+        return false;
+    }
+#if SEQ_USE_EDF == 1
+    return (a->deadline < b->deadline) || (a->deadline == b->deadline && j < i);
+#else
+    return a->priority >= b->priority;
+#endif
+}
+
+/**
+ * Completion time test of service i against the enabled services that interfere with it: the
+ * least w with w = Bi + Ci + sum(ceil(w / Tj) * Cj), iterated from the larger of Bi plus the sum of
+ * the C's and the previous bound. Returns false if w passes the deadline or the iteration bound is
+ * reached.
+ */
+static bool ResponseBound(uint32_t i, const bool enabled[], const uint32_t wcet[], uint32_t* bound) {
+    uint32_t deadline = (uint32_t)SequencerService(i)->deadline << ADMISSION_TICK_SHIFT;
+    uint32_t count = SequencerServiceCount();
+    uint64_t own = (uint64_t)BlockingUnits(i) + wcet[i];
+    uint64_t w = own;
+    uint32_t iteration, j;
+
+    for (j = 0; j < count; j++) {
+        if (enabled[j] && Interferes(j, i)) {
+            w += wcet[j];
+        }
+    }
+    if (s_bound[i] > w) {
+        w = s_bound[i];
+    }
+
+    for (iteration = 0; iteration < ADMISSION_MAX_ITERATIONS; iteration++) {
+        uint64_t next = own;
+
+        if (w > deadline) {
+            return false;
+        }
+        for (j = 0; j < count; j++) {
+            if (enabled[j] && Interferes(j, i)) {
+                uint32_t period = (uint32_t)SequencerService(j)->period << ADMISSION_TICK_SHIFT;
+                next += (uint64_t)(((uint32_t)w - 1) / period + 1) * wcet[j];
+            }
+        }
+        if (next == w) {
+            *bound = (uint32_t)w;
+            return true;
+        }
+        w = next;
+    }
+    return false;
+}
+
+void AdmissionInit(AdmissionWcetFn measured, AdmissionBlockingFn blocking) {
+    uint32_t i;
+
+    s_measured = measured;
+    s_blocking = blocking;
+    for (i = 0; i < SEQ_MAX_SERVICES; i++) {
+        s_bound[i] = 0;
+    }
+}
+
+AdmissionResult AdmissionRequest(uint32_t id, bool enable, uint32_t* culprit) {
+    bool enabled[SEQ_MAX_SERVICES];
+    uint32_t wcet[SEQ_MAX_SERVICES];
+    uint32_t bound[SEQ_MAX_SERVICES];
+    uint32_t count = SequencerServiceCount();
+    uint32_t i;
+
+    *culprit = ADMISSION_NO_CULPRIT;
+    if (id >= count || (SequencerService(id)->flags & SEQ_SERVICE_OPTIONAL) == 0) {
+        return ADMISSION_INVALID;
+    }
+
+    if (!enable) {
+        // A smaller task set is always feasible, but the bounds are no longer valid starting points.
+        SequencerSetEnabled(id, false);
+        for (i = 0; i < count; i++) {
+            s_bound[i] = 0;
+        }
+        return ADMISSION_ACCEPTED;
+    }
+    if (SequencerEnabled(id)) {
+        return ADMISSION_ACCEPTED;
+    }
+
+    for (i = 0; i < count; i++) {
+        enabled[i] = (i == id) || SequencerEnabled(i);
+        wcet[i] = WcetUnits(i);
+    }
+
+    // Only the new service and the ones it can delay see a different interference set.
+    for (i = 0; i < count; i++) {
+        if (enabled[i] && (i == id || Interferes(id, i))) {
+            if (!ResponseBound(i, enabled, wcet, &bound[i])) {
+                *culprit = i;
+                return ADMISSION_REJECTED;
+            }
+        }
+    }
+
+    for (i = 0; i < count; i++) {
+        if (enabled[i] && (i == id || Interferes(id, i))) {
+            s_bound[i] = bound[i];
+        }
+    }
+    SequencerSetEnabled(id, true);
+    return ADMISSION_ACCEPTED;
+}
+
+uint32_t AdmissionBoundUs(uint32_t id) {
+    if (id >= SEQ_MAX_SERVICES) {
+        return 0;
+    }
+    return (uint32_t)(((uint64_t)s_bound[id] * SEQ_TICK_US + ADMISSION_TICK_UNITS - 1) >> ADMISSION_TICK_SHIFT);
+}
@@ -0,0 +1,97 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: admission.h
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Online admission control for the sequenced services. Before a service is
+ * enabled at run time, the completion time test of the feasibility
+ * analyzer (completion_time_feasibility() in "Schedulling Point test") is
+ * run on the task set it would create, and the change is refused if any
+ * enabled service could then miss its deadline.
+ *
+ * The on-target test is a fixed point port: integer only, no division in
+ * the loop other than one 32-bit divide per interference term, and a fixed
+ * iteration bound, so a request costs at most ADMISSION_MAX_ITERATIONS *
+ * SEQ_MAX_SERVICES^2 ceil-divides (a few tens of microseconds here). Times
+ * are in 1/2^ADMISSION_TICK_SHIFT of a sequencer tick; T and D come from
+ * the service table and C is the longest execution time measured so far
+ * (ServiceConfig.wcetUs until the service has run), plus a safety margin of
+ * 1/2^ADMISSION_WCET_MARGIN_SHIFT, rounded up.
+ *
+ * Blocking by lower priority tasks enters the recurrence as B, the longest
+ * a service has been seen waiting for the console (ConsoleBlockingUs(), the
+ * B column of the task set printed at the end of a run), and never less
+ * than ADMISSION_BLOCKING_US, which covers the short sections run with
+ * interrupts masked.
+ *
+ * The test is incremental: only the requested service and the services it
+ * can delay are checked, and each iteration starts from the response bound
+ * of the last accepted set, which can only have grown.
+ *
+ * Interference follows the scheduling mode. With fixed priorities every
+ * service of the same or a higher priority delays a service, which also
+ * covers round robin between equal priorities. With SEQ_USE_EDF the test
+ * is run in deadline monotonic order: a task set schedulable under DM is
+ * schedulable under EDF, so the test stays safe, only more pessimistic
+ * than an EDF demand test.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#ifndef __ADMISSION_H__
+#define __ADMISSION_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Fixed point time unit: 2^ADMISSION_TICK_SHIFT units per sequencer tick.
+#define ADMISSION_TICK_SHIFT        16
+
+// Measured execution times are inflated by C / 2^ADMISSION_WCET_MARGIN_SHIFT (25 %).
+#define ADMISSION_WCET_MARGIN_SHIFT 2
+
+// Least blocking assumed for every service, in microseconds.
+#define ADMISSION_BLOCKING_US       100
+
+// Completion time iterations per service before the test gives up and rejects.
+#define ADMISSION_MAX_ITERATIONS    32
+
+// Culprit value when no service is to blame.
+#define ADMISSION_NO_CULPRIT        0xFF
+
+typedef enum {
+    ADMISSION_ACCEPTED = 0,     // Change applied.
+    ADMISSION_REJECTED = 1,     // The grown task set fails the test; nothing changed.
+    ADMISSION_INVALID = 2,      // No such service, or not flagged SEQ_SERVICE_OPTIONAL.
+} AdmissionResult;
+
+// Longest execution time measured for a service, in cycles, or 0 if it has not run yet.
+typedef uint32_t (*AdmissionWcetFn)(uint32_t id);
+
+// Longest a service has been blocked by lower priority tasks, in microseconds.
+typedef uint32_t (*AdmissionBlockingFn)(uint32_t id);
+
+// Call after SequencerInit(). Either function may be NULL.
+void AdmissionInit(AdmissionWcetFn measured, AdmissionBlockingFn blocking);
+
+// Enables or disables service id, which must be a SEQ_SERVICE_OPTIONAL row, so the services the
+// link and the motors depend on can never be switched off. Disabling an optional service is always
+// accepted. Enabling is applied only if every
+// enabled service, the new one included, still meets its deadline; otherwise *culprit is set to
+// the first service that fails. Not reentrant: call from one task only.
+AdmissionResult AdmissionRequest(uint32_t id, bool enable, uint32_t* culprit);
+
+// Response time bound of service id found by the last accepted request that checked it, in
+// microseconds (0 if it has not been checked).
+uint32_t AdmissionBoundUs(uint32_t id);
+
+#endif // __ADMISSION_H__
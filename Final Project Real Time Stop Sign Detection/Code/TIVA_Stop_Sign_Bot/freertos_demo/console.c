@@ -0,0 +1,164 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: console.c
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * UART0 console gatekeeper and blocking time measurement. See console.h.
+ *
+ * Each caller first tries to get the queue slot (or the mutex) without
+ * waiting. Only if that fails does it read the time base, wait, and
+ * charge the wait to its service. The common case therefore costs one
+ * queue copy and no timing at all. A measured wait also includes any
+ * preemption by higher priority tasks during it, so it is an upper bound
+ * on the blocking itself.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "utils/uartstdio.h"
+#include "utils/ustdlib.h"
+#include "priorities.h"
+#include "sequencer.h"
+#include "service_timing.h"
+#include "console.h"
+
+typedef struct {
+    uint16_t len;                       // Characters in text, without the terminating zero.
+    char text[CONSOLE_LINE_BYTES];
+} ConsoleLine;
+
+volatile ConsoleStats g_consoleStats = {0};
+
+static QueueHandle_t s_lines = NULL;                        // Lines waiting for the gatekeeper.
+static SemaphoreHandle_t s_uartMutex = NULL;                // UART0 between the gatekeeper and raw writers.
+static SemaphoreHandle_t s_formatMutex = NULL;              // s_format between the tasks calling ConsolePrintf().
+static ConsoleLine s_format;                                // Line being formatted, kept off the callers' stacks.
+static volatile uint32_t s_blockMax[SEQ_MAX_SERVICES];      // Worst wait of each service, in cycles.
+
+#if configSUPPORT_STATIC_ALLOCATION == 1
+static uint8_t s_lineStorage[CONSOLE_QUEUE_DEPTH * sizeof(ConsoleLine)];
+static StaticQueue_t s_linesBuffer;
+static StaticSemaphore_t s_uartMutexBuffer;
+static StaticSemaphore_t s_formatMutexBuffer;
+static StaticTask_t s_taskBuffer;
+static StackType_t s_stack[CONSOLE_STACK_WORDS];
+#endif
+
+// Charges a wait that started at start to the calling task, if it is a sequenced service.
+static void RecordWait(uint32_t start) {
+    uint32_t waited = TimingNow() - start;
+    uint32_t tag = (uint32_t)(uintptr_t)xTaskGetApplicationTaskTag(NULL);
+
+    g_consoleStats.waits++;
+    if (tag >= 1 && tag <= SEQ_MAX_SERVICES && !SequencerAborted() && waited > s_blockMax[tag - 1]) {
+        s_blockMax[tag - 1] = waited;
+    }
+}
+
+/**
+ * Gatekeeper: the only task writing text to UART0. One line at a time, holding the UART
+ * mutex only for the line itself so telemetry frames can go out in between.
+ */
+static void ConsoleTask(void* pvParameters) {
+    static ConsoleLine line;
+
+    while (1) {
+        if (xQueueReceive(s_lines, &line, portMAX_DELAY) == pdPASS) {
+            xSemaphoreTake(s_uartMutex, portMAX_DELAY);
+            UARTwrite(line.text, line.len);
+            xSemaphoreGive(s_uartMutex);
+        }
+    }
+}
+
+bool ConsoleInit(void) {
+#if configSUPPORT_STATIC_ALLOCATION == 1
+    s_lines = xQueueCreateStatic(CONSOLE_QUEUE_DEPTH, sizeof(ConsoleLine), s_lineStorage, &s_linesBuffer);
+    s_uartMutex = xSemaphoreCreateMutexStatic(&s_uartMutexBuffer);
+    s_formatMutex = xSemaphoreCreateMutexStatic(&s_formatMutexBuffer);
+    if (s_lines == NULL || s_uartMutex == NULL || s_formatMutex == NULL) {
+        return false;
+    }
+    return xTaskCreateStatic(ConsoleTask, "Console", CONSOLE_STACK_WORDS, NULL,
+                             tskIDLE_PRIORITY + PRIORITY_CONSOLE_TASK, s_stack, &s_taskBuffer) != NULL;
+#else
+    s_lines = xQueueCreate(CONSOLE_QUEUE_DEPTH, sizeof(ConsoleLine));
+    s_uartMutex = xSemaphoreCreateMutex();
+    s_formatMutex = xSemaphoreCreateMutex();
+    if (s_lines == NULL || s_uartMutex == NULL || s_formatMutex == NULL) {
+        return false;
+    }
+    return xTaskCreate(ConsoleTask, "Console", CONSOLE_STACK_WORDS, NULL,
+                       tskIDLE_PRIORITY + PRIORITY_CONSOLE_TASK, NULL) == pdTRUE;
+#endif
+}
+
+/**
+ * Formats into one static line rather than on the caller's stack, which for most tasks is only
+ * 128 words. The format mutex is separate from the UART mutex: a caller may wait for queue space
+ * while holding it, and the gatekeeper needs the UART mutex to make that space.
+ */
+void ConsolePrintf(const char* format, ...) {
+    va_list args;
+    int n;
+
+    if (xSemaphoreTake(s_formatMutex, 0) != pdPASS) {
+        uint32_t start = TimingNow();
+        xSemaphoreTake(s_formatMutex, portMAX_DELAY);
+        RecordWait(start);
+    }
+
+    va_start(args, format);
+    n = uvsnprintf(s_format.text, sizeof(s_format.text), format, args);
+    va_end(args);
+
+    // uvsnprintf returns the length the whole line would have had.
+    if (n >= 0) {
+        if (n >= (int)sizeof(s_format.text)) {
+            n = sizeof(s_format.text) - 1;
+            g_consoleStats.truncated++;
+        }
+        s_format.len = (uint16_t)n;
+
+        if (xQueueSend(s_lines, &s_format, 0) != pdPASS) {
+            uint32_t start = TimingNow();
+            xQueueSend(s_lines, &s_format, portMAX_DELAY);
+            RecordWait(start);
+        }
+        g_consoleStats.lines++;
+    }
+
+    xSemaphoreGive(s_formatMutex);
+}
+
+void ConsoleTake(void) {
+    if (xSemaphoreTake(s_uartMutex, 0) != pdPASS) {
+        uint32_t start = TimingNow();
+        xSemaphoreTake(s_uartMutex, portMAX_DELAY);
+        RecordWait(start);
+    }
+}
+
+void ConsoleGive(void) {
+    xSemaphoreGive(s_uartMutex);
+}
+
+uint32_t ConsoleBlockingUs(uint32_t id) {
+    return (id < SEQ_MAX_SERVICES) ? TimingCyclesToUs(s_blockMax[id]) : 0;
+}
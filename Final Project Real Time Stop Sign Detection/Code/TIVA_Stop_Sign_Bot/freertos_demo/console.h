@@ -0,0 +1,77 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: console.h
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Single-owner access to the UART0 console.
+ *
+ * Text goes through a gatekeeper task. ConsolePrintf() formats a line
+ * into a queue item and returns; the gatekeeper, at the lowest
+ * application priority, is the only task that writes text to UART0. A
+ * service therefore never waits for a lower priority task to finish
+ * printing, which is where the old binary semaphore allowed unbounded
+ * priority inversion. A service can only block when the queue is full,
+ * or while another task is formatting: the line is built in one static
+ * buffer under a second mutex, so callers with small stacks do not need
+ * room for it.
+ *
+ * Raw binary writers (the telemetry task) take ConsoleTake() around each
+ * frame. That is a mutex with priority inheritance, shared only with
+ * the gatekeeper, so frames and lines never interleave on the wire.
+ *
+ * Every wait is timed with the service timing time base and the worst
+ * case is kept per sequenced service, counting only while the sequencer
+ * runs. ConsoleBlockingUs() feeds the B column of the task set printed
+ * at the end of a run, for the response time analysis.
+ *
+ * Lines from different tasks can interleave with each other, but a line
+ * is never split.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#ifndef __CONSOLE_H__
+#define __CONSOLE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Longest line, including the terminating zero; longer ones are truncated.
+#define CONSOLE_LINE_BYTES      128
+
+// Lines the gatekeeper can hold before ConsolePrintf() blocks.
+#define CONSOLE_QUEUE_DEPTH     8
+
+#define CONSOLE_STACK_WORDS     128
+
+typedef struct {
+    uint32_t lines;         // Lines queued.
+    uint32_t truncated;     // Lines cut at CONSOLE_LINE_BYTES.
+    uint32_t waits;         // Calls that had to wait, for the queue or a mutex.
+} ConsoleStats;
+
+extern volatile ConsoleStats g_consoleStats;
+
+// Creates the queue, the mutexes and the gatekeeper task. Call once before the scheduler starts.
+bool ConsoleInit(void);
+
+// Formats one line (uartstdio format) for the gatekeeper. Task context only.
+void ConsolePrintf(const char* format, ...);
+
+// Exclusive raw access to UART0 for binary output. Task context only.
+void ConsoleTake(void);
+void ConsoleGive(void);
+
+// Worst case time service id waited for the console while the sequencer ran.
+uint32_t ConsoleBlockingUs(uint32_t id);
+
+#endif // __CONSOLE_H__
@@ -0,0 +1,113 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: event_channel.c
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Lock-free single-publisher event channel. See event_channel.h.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "event_channel.h"
+
+#if (EVENT_CHANNEL_DEPTH & (EVENT_CHANNEL_DEPTH - 1)) != 0
+#error "EVENT_CHANNEL_DEPTH must be a power of two"
+#endif
+
+#define EVENT_CHANNEL_MASK  (EVENT_CHANNEL_DEPTH - 1)
+
+void EventChannelInit(EventChannel* channel) {
+    uint32_t i;
+
+    channel->head = 0;
+    for (i = 0; i < EVENT_CHANNEL_DEPTH; i++) {
+        channel->slots[i].seq = 0;
+    }
+}
+
+/**
+ * Publishes a copy of *event; its seq field is ignored and assigned here.
+ * Must only be called from one context (the link decoder).
+ * The slot is marked busy while its fields are written, and the new head is
+ * advertised only after the slot carries its final sequence number.
+ */
+void EventChannelPublish(EventChannel* channel, const ChannelEvent* event) {
+    uint32_t seq = channel->head + 1;
+    EventSlot* slot = &channel->slots[seq & EVENT_CHANNEL_MASK];
+
+    slot->seq = 0;
+    slot->timestamp = event->timestamp;
+    slot->type = event->type;
+    slot->value = event->value;
+    slot->linkSeq = event->linkSeq;
+    slot->sourceTime = event->sourceTime;
+    slot->rxTime = event->rxTime;
+    slot->seq = seq;
+
+    channel->head = seq;
+}
+
+/**
+ * Attaches a subscriber to a channel. It receives events published from now on.
+ */
+void EventSubscriberInit(EventSubscriber* subscriber, EventChannel* channel) {
+    subscriber->channel = channel;
+    subscriber->next = channel->head + 1;
+    subscriber->missed = 0;
+}
+
+/**
+ * Returns the next event for this subscriber, oldest first.
+ * Returns false when the subscriber has seen everything published so far.
+ */
+bool EventChannelReceive(EventSubscriber* subscriber, ChannelEvent* event) {
+    EventChannel* channel = subscriber->channel;
+
+    for (;;) {
+        uint32_t head = channel->head;
+        EventSlot* slot;
+        uint32_t seqBefore, seqAfter;
+
+        if ((int32_t)(head - subscriber->next) < 0) {
+            return false;
+        }
+
+        // Skip forward if the publisher has already recycled the slots we wanted.
+        if ((head - subscriber->next) >= EVENT_CHANNEL_DEPTH) {
+            uint32_t oldest = head - EVENT_CHANNEL_DEPTH + 1;
+            subscriber->missed += oldest - subscriber->next;
+            subscriber->next = oldest;
+        }
+
+        slot = &channel->slots[subscriber->next & EVENT_CHANNEL_MASK];
+        seqBefore = slot->seq;
+        event->timestamp = slot->timestamp;
+        event->type = slot->type;
+        event->value = slot->value;
+        event->linkSeq = slot->linkSeq;
+        event->sourceTime = slot->sourceTime;
+        event->rxTime = slot->rxTime;
+        seqAfter = slot->seq;
+
+        if (seqBefore == subscriber->next && seqAfter == subscriber->next) {
+            event->seq = subscriber->next;
+            subscriber->next++;
+            return true;
+        }
+
+        // The slot was overwritten while we read it; count it and retry with a fresh head.
+        subscriber->missed++;
+        subscriber->next++;
+    }
+}
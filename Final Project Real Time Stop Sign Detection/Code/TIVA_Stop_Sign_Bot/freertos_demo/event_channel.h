@@ -0,0 +1,80 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: event_channel.h
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Single-publisher, multi-subscriber event channel used to fan detection
+ * commands out to every service.
+ *
+ * The publisher writes each event into the next slot of a small ring and
+ * stamps it with a monotonically increasing sequence number. Every
+ * subscriber keeps its own cursor (the sequence number it wants next), so
+ * reading an event never consumes it for anyone else. Slots carry their
+ * sequence number in a seqlock fashion: a reader that is lapped by the
+ * publisher sees the mismatch and counts the event as missed rather than
+ * returning torn data. Neither side disables interrupts or the scheduler.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#ifndef __EVENT_CHANNEL_H__
+#define __EVENT_CHANNEL_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Number of events a subscriber may fall behind before it misses one.
+// Must be a power of two.
+#define EVENT_CHANNEL_DEPTH     8
+
+// Event types.
+#define EVENT_DETECTION         0x01    // value = DETECTION_STOP / DETECTION_CLEAR.
+
+// One published event.
+typedef struct {
+    uint32_t seq;           // Channel sequence number, assigned on publish.
+    uint32_t timestamp;     // Tick count when the event was published.
+    uint8_t type;           // EVENT_xxx.
+    uint8_t value;          // Type specific value.
+    uint8_t linkSeq;        // Sequence number of the UART frame that carried it.
+    uint32_t sourceTime;    // Jetson capture time of the frame it came from (us, Jetson clock).
+    uint32_t rxTime;        // TimingNowUs() when the UART frame was decoded.
+} ChannelEvent;
+
+typedef struct {
+    volatile uint32_t seq;          // Sequence number held by the slot, 0 while being written.
+    volatile uint32_t timestamp;
+    volatile uint8_t type;
+    volatile uint8_t value;
+    volatile uint8_t linkSeq;
+    volatile uint32_t sourceTime;
+    volatile uint32_t rxTime;
+} EventSlot;
+
+typedef struct {
+    volatile uint32_t head;                 // Sequence number of the newest event.
+    EventSlot slots[EVENT_CHANNEL_DEPTH];
+} EventChannel;
+
+typedef struct {
+    EventChannel* channel;  // Channel this subscriber reads.
+    uint32_t next;          // Sequence number of the next event to deliver.
+    uint32_t missed;        // Events overwritten before this subscriber read them.
+} EventSubscriber;
+
+void EventChannelInit(EventChannel* channel);
+void EventChannelPublish(EventChannel* channel, const ChannelEvent* event);
+
+void EventSubscriberInit(EventSubscriber* subscriber, EventChannel* channel);
+bool EventChannelReceive(EventSubscriber* subscriber, ChannelEvent* event);
+
+#endif // __EVENT_CHANNEL_H__
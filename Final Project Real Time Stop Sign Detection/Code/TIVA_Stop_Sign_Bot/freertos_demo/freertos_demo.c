@@ -1,839 +1,977 @@
-/***********************************************************************
- * ==========================================================================
- *
- * File: freertes_demo.c
- *
- * Author: Kiran Jojare, Ayswariya Kannan
- *
- * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
- *
- * Description:
- * This file contains the implementation of a stop sign detection system
- * for a robotic vehicle controlled by the TIVA TM4C123GH6PM microcontroller,
- * utilizing FreeRTOS for task management. The project aims to demonstrate
- * real-time detection of stop signs, enabling the vehicle to make autonomous
- * navigation decisions.
- *
- * The code utilizes hardware interfacing examples provided by TIVAWare and
- * is designed to handle tasks such as image acquisition from a camera module,
- * image processing to detect stop signs, and motor control for vehicle movement.
- *
- * References:
- * - TIVAWare demo examples for initial hardware configuration and basic examples.
- * - UART communication on TM4C123: https://github.com/Reddimus/UARTcommunication-TM4C123
- * - PWM Control for TM4C123: https://github.com/Mohammed-AhmedAF/PWMController_TM4C123
- * - MotorLib Embedded for TIVA: https://github.com/GrandviewIoT/MotorLib_Embedded
- *
- *
- * Subject: ECEN - 5623 Real Time Operating Systems
- *
- * Professor: Tim Scherr
- *
- * University: University of Colorado, Boulder
- *
- * Academic Year: [2023-2024]
- *
- * ==========================================================================
- ***********************************************************************/
-
-
-#include <stdbool.h>
-#include <stdint.h>
-#include "FreeRTOS.h"          // Include main header for FreeRTOS.
-#include "FreeRTOSConfig.h"    // Include FreeRTOS configuration settings.
-#include "task.h"              // Include for task management utilities.
-#include "queue.h"             // Include for queue management utilities.
-#include "semphr.h"            // Include for semaphore management utilities.
-#include "timers.h"            // Include for software timer utilities.
-#include "inc/hw_types.h"      // Hardware specific header file to interact with the lower level hardware specific functions.
-#include "inc/hw_memmap.h"     // Header file defining the memory map of the TIVA microcontroller.
-#include "driverlib/sysctl.h"  // Include system control driver for system and clock control utilities.
-#include "driverlib/interrupt.h" // Include for NVIC interrupt controller utilities.
-#include "driverlib/timer.h"   // Include for hardware timer utilities.
-#include "driverlib/gpio.h"    // Include for GPIO pin control utilities.
-#include "driverlib/uart.h"    // Include for UART communication utilities.
-#include "driverlib/pin_map.h" // Include for GPIO pin configuration that maps to specific functions.
-#include "utils/uartstdio.h"   // Include for using UART functions for standard input and output.
-#include "inc/hw_ints.h"       // Include for definitions of interrupt assignments.
-#include "driverlib/rom.h"     // Include for ROM utility functions.
-#include "driverlib/pwm.h"     // Include for Pulse Width Modulation signal generation utilities.
-#include "driverlib/pin_map.h" // Include to define alternate functions for GPIO pins.
-
-// Define constants for use in timing analysis and other features.
-#define TIMING_ANALYSIS         1
-#define FIBONACCI_ITERATIONS    5000 // Define the number of Fibonacci sequence iterations for test purposes.
-#define MAX_SERVICE_EXECUTIONS  100  // Assuming a maximum of 180 executions for demonstration purposes.
-
-// UART and motor configuration settings
-#define MOTOR1_GPIO_PERIPH       SYSCTL_PERIPH_GPIOB
-#define MOTOR1_GPIO_BASE         GPIO_PORTB_BASE
-#define MOTOR1_PIN_A1            GPIO_PIN_0
-#define MOTOR1_PIN_A2            GPIO_PIN_1
-
-#define MOTOR2_GPIO_PERIPH       SYSCTL_PERIPH_GPIOC
-#define MOTOR2_GPIO_BASE         GPIO_PORTC_BASE
-#define MOTOR2_PIN_B1            GPIO_PIN_6           // Motor 2 Pin B1 connected to PC6
-#define MOTOR2_PIN_B2            GPIO_PIN_7           // Motor 2 Pin B2 connected to PC7
-
-#define PWM_FREQUENCY           20000  // Set PWM frequency in Hz.
-
-#define UART1_RX_PERIPH         SYSCTL_PERIPH_UART1
-#define UART1_RX_BASE           UART1_BASE
-#define UART1_RX_PORT_PERIPH    SYSCTL_PERIPH_GPIOC
-#define UART1_RX_PORT_BASE      GPIO_PORTC_BASE
-#define UART1_RX_PIN            GPIO_PIN_4
-#define UART1_RX_PIN_CONF       GPIO_PC4_U1RX
-
-#define UART2_TX_PERIPH         SYSCTL_PERIPH_UART2
-#define UART2_TX_BASE           UART2_BASE
-#define UART2_TX_PORT_PERIPH    SYSCTL_PERIPH_GPIOD
-#define UART2_TX_PORT_BASE      GPIO_PORTD_BASE
-#define UART2_TX_PIN            GPIO_PIN_7
-#define UART2_TX_PIN_CONF       GPIO_PD7_U2TX
-
-#define UART2_BAUDRATE          (115200)    // Set baud rate for UART.
-
-// System clock rate definition.
-#define SYSTEM_CLOCK            50000000U   // System clock rate in Hz.
-
-// LED configuration details.
-#define LED_PERIPH              SYSCTL_PERIPH_GPIOF
-#define LED_PORT                GPIO_PORTF_BASE
-#define LED_PIN                 GPIO_PIN_2  // Blue LED on TIVA boards.
-
-#define BYTES_PER_TRANS         8  // Define number of bytes per UART transmission.
-
-// Flags to indicate whether a service should be aborted.
-static bool abortS1=false, abortS2=false, abortS3=false, abortS4=false;
-
- //////////////////////////////////////////////////////////////////////////
- ///////////////////    Function Declarations     /////////////////////////
- //////////////////////////////////////////////////////////////////////////
-
- // System configuration functions.
- void SystemConfig();          // Configures the overall system settings, like clock and power.
- void GPIOConfig();            // Configures the general purpose input/output pins for the system.
- void UART0Config(void);       // Configures UART0 for serial communication.
- void TimerConfig();           // Sets up the hardware timers for timing and delays.
- void SemaphoresConfig(void);  // Initializes semaphores used for task synchronization.
- void TaskConfig();            // Sets up and creates FreeRTOS tasks.
-
- // ISR's and UART Function Prototypes
- void ConfigureUARTJetson(void);   // Sets up UART communication for a specific device, like a Jetson board.
- void UART1IntHandler(void);       // Interrupt handler for UART1, processes UART1 communication interrupts.
- void UART2IntHandler(void);       // Interrupt handler for UART2, handles interrupts from UART2.
-
- // Motor Function Prototypes
- void ConfigurePWM(uint32_t pwmPeriod);    // Configures PWM settings for motor control.
- void ConfigureMotorGPIO(void);            // Sets up GPIO for motor control.
- void MotorForward(void);                  // Commands motors to drive forward.
- void MotorReverse(void);                  // Commands motors to reverse direction.
- void MotorStop(void);                     // Stops the motors.
- void MotorStart(void);                    // Starts the motors.
-
- // Task Function Prototypes
- void CameraUARTService1(void *pvParameters);  // FreeRTOS task function for handling UART communication.
- void Motor1Service2(void *pvParameters);      // Task function for controlling Motor 1.
- void Motor2Service3(void *pvParameters);      // Task function for controlling Motor 2.
- void DiagnosticsLEDService4(void *pvParameters); // Task function for LED diagnostics.
-
- // Declaration of Semaphore Handles
- SemaphoreHandle_t semaphore1, semaphore2, semaphore3, semaphore4; // Semaphores for synchronizing tasks and ISR.
-
- volatile TickType_t maxExecutionTimeS1 = 0; // Tracks maximum execution time for service 1.
- volatile TickType_t maxExecutionTimeS2 = 0; // Tracks maximum execution time for service 2.
- volatile TickType_t maxExecutionTimeS3 = 0; // Tracks maximum execution time for service 3.
- volatile TickType_t maxExecutionTimeS4 = 0; // Tracks maximum execution time for service 4.
-
- SemaphoreHandle_t semaphoreUART; // Semaphore for UART communication synchronization.
-
- // Global Shared Data Between ISR and Service 1 of CameraUARTService
- volatile uint8_t lastReceivedByte;  // Last byte received from UART, shared globally.
- volatile bool newDataAvailable = false;  // Flag to indicate new data is available from UART.
-
- int seqCnt = 0;  // Counter used for sequencing in ISRs or timed events.
-
- // Data structure for tracking service execution timing.
- typedef struct {
-     TickType_t* startTime;      // Array of start times for each execution.
-     TickType_t* endTime;        // Array of end times for each execution.
-     uint32_t serviceCount;      // Number of times the service has been executed.
-     TickType_t wcet;            // Worst-case execution time.
- } ServiceData;
-
- // Initialize ServiceData for Service 1
- ServiceData serviceData1 = {0};
- ServiceData serviceData2 = {0};
- ServiceData serviceData3 = {0};
- ServiceData serviceData4 = {0};
-
- uint32_t idx = 0, jdx = 1;
- uint32_t fib = 0, fib0 = 0, fib1 = 1;  // Variables for Fibonacci calculation.
-
- #define FIB_TEST(seqCnt, iterCnt)   \
-  for(idx=0; idx < iterCnt; idx++)   \
-  {                                  \
-      fib = fib0 + fib1;             \
-      while(jdx < seqCnt)            \
-      {                              \
-          fib0 = fib1;               \
-          fib1 = fib;                \
-          fib = fib0 + fib1;         \
-          jdx++;                     \
-  }                                  \
- }
-
- // Initializes service data for dynamic allocation of timing data.
- void InitServiceData(ServiceData* serviceData, uint32_t maxExecutions) {
-     serviceData->startTime = pvPortMalloc(maxExecutions * sizeof(TickType_t));
-     serviceData->endTime = pvPortMalloc(maxExecutions * sizeof(TickType_t));
-     serviceData->serviceCount = 0;
-     serviceData->wcet = 0;
- }
-
- // Deinitializes service data, freeing allocated memory.
- void DeinitServiceData(ServiceData* serviceData) {
-     vPortFree(serviceData->startTime);
-     vPortFree(serviceData->endTime);
- }
-
-#ifdef DEBUG
-void __error__(char *pcFilename, uint32_t ui32Line) { }
-#endif
-
-void vApplicationStackOverflowHook(xTaskHandle *pxTask, char *pcTaskName)
-{
-    while (1)
-    {
-    }
-}
-
-void Timer0AInterruptHandler(void) {
-
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-
-    // Clear the timer interrupt.
-    TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
-
-    // Increment the sequencer count.
-    seqCnt++;
-
-    // Check if it's time to abort all tasks.
-    // run for total of 10 seconds
-    if (seqCnt >= 1000) {
-        // Set abort flags for all tasks.
-        abortS1 = true; abortS2 = true; abortS3 = true;abortS4 = true;
-
-        // Release semaphores to unblock tasks for clean up.
-        xSemaphoreGiveFromISR(semaphore1, &xHigherPriorityTaskWoken);
-        xSemaphoreGiveFromISR(semaphore2, &xHigherPriorityTaskWoken);
-        xSemaphoreGiveFromISR(semaphore3, &xHigherPriorityTaskWoken);
-        xSemaphoreGiveFromISR(semaphore4, &xHigherPriorityTaskWoken);
-
-        MotorStop();
-
-    } else {
-        // Service_1 - 5 Hz, every 50nd Sequencer loop
-        if ((seqCnt % 20) == 0) {
-            if(xSemaphoreGiveFromISR(semaphore1, &xHigherPriorityTaskWoken) != pdTRUE) {
-                // Handle error
-                UARTprintf("Semaphore give for Service 1 failed!\n");
-            }
-        }
-
-        // Service_2 - 100 Hz, every 1th Sequencer loop
-        if ((seqCnt % 1) == 0) {
-            if(xSemaphoreGiveFromISR(semaphore2, &xHigherPriorityTaskWoken) != pdTRUE) {
-                // Handle error
-                UARTprintf("Semaphore give for Service 2 failed!\n");
-            }
-        }
-
-        // Service_3 -100 Hz, every 1th Sequencer loop
-        if ((seqCnt % 1) == 0) {
-            if(xSemaphoreGiveFromISR(semaphore3, &xHigherPriorityTaskWoken) != pdTRUE) {
-                // Handle error
-                UARTprintf("Semaphore give for Service 3 failed!\n");
-            }
-        }
-
-        // Service_4 - 4 Hz, every 50th Sequencer loop
-        if ((seqCnt % 25) == 0) {
-            if(xSemaphoreGiveFromISR(semaphore4, &xHigherPriorityTaskWoken) != pdTRUE) {
-                // Handle error
-                UARTprintf("Semaphore give for Service 4 failed!\n");
-            }
-        }
-
-    }
-
-    // Toggle the LED as a visual heartbeat indicator.
-    // GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_2, ~GPIOPinRead(GPIO_PORTF_BASE, GPIO_PIN_2));
-
-    // Force a context switch if xHigherPriorityTaskWoken was set to true.
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-}
-
-//////////////////////////////////////////////////////////////////////////
-///////////////////       Main Entry Point       /////////////////////////
-//////////////////////////////////////////////////////////////////////////
-
-int main(void)
-{
-    SystemConfig();
-
-    GPIOConfig();
-
-    SemaphoresConfig();
-
-    UART0Config();
-
-    // Initialize PWM and GPIO configurations
-    uint32_t pwmPeriod = ROM_SysCtlClockGet() / PWM_FREQUENCY;
-    ConfigurePWM(pwmPeriod);
-    ConfigureMotorGPIO();
-
-    // Start the motor system
-    MotorStart();
-
-    // Drive the motor forward
-    MotorForward();
-
-    //Giving initial semaphore
-    xSemaphoreGive(semaphoreUART);
-
-    UARTprintf("STOP SIGN DETECTION BOT RUNNING.............\n");
-
-    TimerConfig();
-
-    TaskConfig();
-
-    ConfigureUARTJetson();
-
-    vTaskStartScheduler();
-
-    while (1)
-    {
-        // Main loop does nothing but sleep
-        // SysCtlSleep();
-
-        ;
-    }
-}
-
-//////////////////////////////////////////////////////////////////////////
-///////////////////    Function Definitions      /////////////////////////
-//////////////////////////////////////////////////////////////////////////
-
-/**
- * Configures the system clock for the microcontroller.
- */
-void SystemConfig()
-{
-    // Set the system clock to 50 MHz from PLL with a crystal reference of 16 MHz
-    SysCtlClockSet(SYSCTL_SYSDIV_4 | SYSCTL_USE_PLL | SYSCTL_XTAL_16MHZ | SYSCTL_OSC_MAIN);
-}
-
-/**
- * Configures general-purpose input/output settings for the system, particularly for LEDs.
- */
-void GPIOConfig()
-{
-    // The following code is commented out but when enabled, it would:
-    // Enable the GPIO port for the LED (PF2)
-    // SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
-
-    // Configure the GPIO pin for the LED as an output
-    // GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_2);
-}
-
-/**
- * Configures UART0 for basic serial communication.
- */
-void UART0Config(void)
-{
-    // Enable GPIO Peripheral for UART0 pins and UART0 itself
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
-
-    // Configure the GPIO pins for UART mode
-    GPIOPinConfigure(GPIO_PA0_U0RX);  // Configure PA0 as UART0 RX
-    GPIOPinConfigure(GPIO_PA1_U0TX);  // Configure PA1 as UART0 TX
-    GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
-
-    // Set UART clock source and configure the UART for 115200 baud rate
-    // UART_CLOCK_PIOSC is often used to avoid conflicts with the system clock used by SysCtlClockSet
-    UARTClockSourceSet(UART0_BASE, UART_CLOCK_PIOSC);
-    UARTStdioConfig(0, 115200, 16000000); // Use internal 16MHz oscillator for UART
-}
-
-/**
- * Configures the system timer to trigger an interrupt at a frequency of 100 Hz.
- */
-void TimerConfig()
-{
-    // Enable Timer 0 peripheral
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER0);
-
-    // Enable processor interrupts
-    IntMasterEnable();
-
-    // Configure Timer0 as a 32-bit timer in periodic mode
-    TimerConfigure(TIMER0_BASE, TIMER_CFG_PERIODIC);
-
-    // Calculate and set the timer load value for a 100 Hz frequency
-    uint32_t timerLoad = (SysCtlClockGet() / 100) - 1; // System clock divided by frequency, minus one for zero-based index
-    TimerLoadSet(TIMER0_BASE, TIMER_A, timerLoad);
-
-    // Enable the specific Timer0A interrupt
-    IntEnable(INT_TIMER0A);
-    TimerIntEnable(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
-
-    // Register the interrupt handler for Timer0A
-    TimerIntRegister(TIMER0_BASE, TIMER_A, Timer0AInterruptHandler);
-
-    // Start Timer0A
-    TimerEnable(TIMER0_BASE, TIMER_A);
-}
-
-/**
- * Initializes semaphores used for synchronizing tasks and interrupts.
- */
-void SemaphoresConfig(void) {
-    // Create binary semaphores for task synchronization and error check
-    semaphore1 = xSemaphoreCreateBinary();
-    if (semaphore1 == NULL) { UARTprintf("Error: Failed to create Semaphore 1\n"); }
-
-    semaphore2 = xSemaphoreCreateBinary();
-    if (semaphore2 == NULL) { UARTprintf("Error: Failed to create Semaphore 2\n"); }
-
-    semaphore3 = xSemaphoreCreateBinary();
-    if (semaphore3 == NULL) { UARTprintf("Error: Failed to create Semaphore 3\n"); }
-
-    semaphore4 = xSemaphoreCreateBinary();
-    if (semaphore4 == NULL) { UARTprintf("Error: Failed to create Semaphore 4\n"); }
-
-    semaphoreUART = xSemaphoreCreateBinary();
-    if (semaphoreUART == NULL) { UARTprintf("Error: Failed to create UART Semaphore\n"); }
-}
-
-/**
- * Configures and creates tasks.
- */
-void TaskConfig()
-{
-    BaseType_t status;
-
-    // Create a task for handling UART communication with the camera module
-    status = xTaskCreate(CameraUARTService1, "CameraUARTService1", 100, NULL, configMAX_PRIORITIES - 2, NULL);
-    if (status != pdTRUE) { UARTprintf("Error: Failed to create Camera UART Service 1\n"); }
-
-    // Create a task for controlling Motor 1
-    status = xTaskCreate(Motor1Service2, "Motor1Service2", 128, NULL, configMAX_PRIORITIES - 1, NULL);
-    if (status != pdTRUE) { UARTprintf("Error: Failed to create Motor 1 Service 2\n"); }
-
-    // Create a task for controlling Motor 2
-    status = xTaskCreate(Motor2Service3, "Motor2Service3", 128, NULL, configMAX_PRIORITIES - 1, NULL);
-    if (status != pdTRUE) { UARTprintf("Error: Failed to create Motor 2 Service 3\n"); }
-
-    // Create a task for managing diagnostic LEDs
-    status = xTaskCreate(DiagnosticsLEDService4, "DiagnosticsLEDService4", 128, NULL, configMAX_PRIORITIES - 3, NULL);
-    if (status != pdTRUE) { UARTprintf("Error: Failed to create Diagnostics LED Service 4\n"); }
-}
-/**
- * Configures UART peripherals for communication with Jetson (or other UART devices).
- * This function sets up UART1 for receiving data and UART2 for transmitting data.
- */
-void ConfigureUARTJetson(void) {
-    // Enable UART1 and UART2 peripherals to ensure they are powered and ready for configuration.
-    SysCtlPeripheralEnable(UART1_RX_PERIPH);
-    SysCtlPeripheralEnable(UART1_RX_PORT_PERIPH);
-    SysCtlPeripheralEnable(UART2_TX_PERIPH);
-    SysCtlPeripheralEnable(UART2_TX_PORT_PERIPH);
-
-    // Configure the pin associated with UART1_RX for UART functionality.
-    GPIOPinConfigure(UART1_RX_PIN_CONF);
-    GPIOPinTypeUART(UART1_RX_PORT_BASE, UART1_RX_PIN);
-
-    // Configure the pin associated with UART2_TX for UART functionality.
-    GPIOPinConfigure(UART2_TX_PIN_CONF);
-    GPIOPinTypeUART(UART2_TX_PORT_BASE, UART2_TX_PIN);
-
-    // Set up UART1 for reception at 115200 baud, 8 data bits, 1 stop bit, and no parity.
-    UARTConfigSetExpClk(UART1_RX_BASE, SysCtlClockGet(), 115200,
-                        (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
-    UARTIntEnable(UART1_RX_BASE, UART_INT_RX);
-    UARTEnable(UART1_RX_BASE);
-
-    // Set up UART2 for transmission at 115200 baud, 8 data bits, 1 stop bit, and no parity.
-    UARTConfigSetExpClk(UART2_TX_BASE, SysCtlClockGet(), 115200,
-                        (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
-    UARTEnable(UART2_TX_BASE);
-
-    // Register and enable interrupt handler for UART1_RX to handle incoming data.
-    UARTIntRegister(UART1_RX_BASE, UART1IntHandler);
-    IntEnable(INT_UART1);
-
-    // Register and enable interrupt handler for UART2_TX (optional here, not utilized in this function).
-    UARTIntRegister(UART2_TX_BASE, UART2IntHandler);
-    IntEnable(INT_UART2);
-}
-
-/**
- * Interrupt handler for UART1. This function processes incoming data as soon as it is available.
- */
-void UART1IntHandler(void) {
-    // Get the current interrupt status and clear it.
-    uint32_t ui32Status = UARTIntStatus(UART1_RX_BASE, true);
-    UARTIntClear(UART1_RX_BASE, ui32Status);
-
-    // Continue reading data while characters are available in the UART buffer.
-    while (UARTCharsAvail(UART1_RX_BASE)) {
-        // Read the incoming byte and store it globally.
-        lastReceivedByte = UARTCharGet(UART1_RX_BASE);
-        newDataAvailable = true;  // Flag to indicate new data is ready to be processed.
-    }
-}
-
-/**
- * Placeholder for UART2 interrupt handler. Currently, it does nothing but is required for completeness.
- */
-void UART2IntHandler(void) {
-    // Currently empty, as no specific functionality is implemented for UART2 TX interrupts.
-}
-
-/**
- * Configures PWM (Pulse Width Modulation) for controlling motor speed.
- * This function sets up PWM generators for two motors.
- * @param pwmPeriod The period of the PWM signal, which determines the frequency.
- */
-void ConfigurePWM(uint32_t pwmPeriod) {
-    // Set the PWM clock divider to 1 for full speed.
-    ROM_SysCtlPWMClockSet(SYSCTL_PWMDIV_1);
-
-    // Enable the PWM peripherals for motor control.
-    ROM_SysCtlPeripheralEnable(SYSCTL_PERIPH_PWM1); // PWM1 for Motor 1
-    ROM_SysCtlPeripheralEnable(SYSCTL_PERIPH_PWM0); // PWM0 for Motor 2
-
-    // Enable the GPIO peripherals that the PWM pins are multiplexed on.
-    ROM_SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF); // GPIOF for Motor 1
-    ROM_SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOB); // GPIOB for Motor 2
-
-    // Set the specific pins to be used as PWM outputs.
-    ROM_GPIOPinTypePWM(GPIO_PORTF_BASE, GPIO_PIN_0); // PF0 for Motor 1
-    ROM_GPIOPinTypePWM(GPIO_PORTB_BASE, GPIO_PIN_4); // PB4 for Motor 2
-
-    // Configure pin muxing for PWM output on these pins.
-    ROM_GPIOPinConfigure(GPIO_PF0_M1PWM4); // PF0 as M1PWM4 for Motor 1
-    ROM_GPIOPinConfigure(GPIO_PB4_M0PWM2); // PB4 as M0PWM2 for Motor 2
-
-    // Configure and enable PWM generator for Motor 1.
-    ROM_PWMGenConfigure(PWM1_BASE, PWM_GEN_2, PWM_GEN_MODE_DOWN | PWM_GEN_MODE_NO_SYNC);
-    ROM_PWMGenPeriodSet(PWM1_BASE, PWM_GEN_2, pwmPeriod);
-    ROM_PWMPulseWidthSet(PWM1_BASE, PWM_OUT_4, pwmPeriod / 2);  // Set to 50% duty cycle
-    ROM_PWMOutputState(PWM1_BASE, PWM_OUT_4_BIT, true);
-    ROM_PWMGenEnable(PWM1_BASE, PWM_GEN_2);
-
-    // Configure and enable PWM generator for Motor 2.
-    ROM_PWMGenConfigure(PWM0_BASE, PWM_GEN_1, PWM_GEN_MODE_DOWN | PWM_GEN_MODE_NO_SYNC);
-    ROM_PWMGenPeriodSet(PWM0_BASE, PWM_GEN_1, pwmPeriod);
-    ROM_PWMPulseWidthSet(PWM0_BASE, PWM_OUT_2, pwmPeriod / 2);  // Set to 50% duty cycle
-    ROM_PWMOutputState(PWM0_BASE, PWM_OUT_2_BIT, true);
-    ROM_PWMGenEnable(PWM0_BASE, PWM_GEN_1);
-}
-
-/**
- * Configures GPIOs for motor control, setting up pins as output for controlling motor direction.
- */
-void ConfigureMotorGPIO(void) {
-    // Enable the GPIO peripheral for Motor 1 and configure its pins as outputs.
-    ROM_SysCtlPeripheralEnable(MOTOR1_GPIO_PERIPH);
-    ROM_GPIOPinTypeGPIOOutput(MOTOR1_GPIO_BASE, MOTOR1_PIN_A1 | MOTOR1_PIN_A2);
-    ROM_GPIOPinWrite(MOTOR1_GPIO_BASE, MOTOR1_PIN_A1 | MOTOR1_PIN_A2, 0); // Initialize pins to low.
-
-    // Enable the GPIO peripheral for Motor 2 and configure its pins as outputs.
-    ROM_SysCtlPeripheralEnable(MOTOR2_GPIO_PERIPH);
-    ROM_GPIOPinTypeGPIOOutput(MOTOR2_GPIO_BASE, MOTOR2_PIN_B1 | MOTOR2_PIN_B2);
-    ROM_GPIOPinWrite(MOTOR2_GPIO_BASE, MOTOR2_PIN_B1 | MOTOR2_PIN_B2, 0); // Initialize pins to low.
-}
-
-
-/**
- * Sets the direction of both motors to forward.
- * Motor 1 and Motor 2 are configured to rotate forward by setting appropriate GPIO outputs.
- */
-void MotorForward(void) {
-    // Set Motor 1 to move forward by activating one pin and deactivating the other.
-    ROM_GPIOPinWrite(MOTOR1_GPIO_BASE, MOTOR1_PIN_A1, MOTOR1_PIN_A1);  // Activate Motor 1 Pin A1
-    ROM_GPIOPinWrite(MOTOR1_GPIO_BASE, MOTOR1_PIN_A2, 0);             // Deactivate Motor 1 Pin A2
-
-    // Set Motor 2 to move forward by activating one pin and deactivating the other.
-    ROM_GPIOPinWrite(MOTOR2_GPIO_BASE, MOTOR2_PIN_B1, MOTOR2_PIN_B1);  // Activate Motor 2 Pin B1
-    ROM_GPIOPinWrite(MOTOR2_GPIO_BASE, MOTOR2_PIN_B2, 0);              // Deactivate Motor 2 Pin B2
-}
-
-/**
- * Sets the direction of both motors to reverse.
- * Motor 1 and Motor 2 are configured to rotate in the reverse direction by setting appropriate GPIO outputs.
- */
-void MotorReverse(void) {
-    // Set Motor 1 to move in reverse by activating one pin and deactivating the other.
-    ROM_GPIOPinWrite(MOTOR1_GPIO_BASE, MOTOR1_PIN_A2, MOTOR1_PIN_A2);  // Activate Motor 1 Pin A2
-    ROM_GPIOPinWrite(MOTOR1_GPIO_BASE, MOTOR1_PIN_A1, 0);              // Deactivate Motor 1 Pin A1
-
-    // Set Motor 2 to move in reverse by activating one pin and deactivating the other.
-    ROM_GPIOPinWrite(MOTOR2_GPIO_BASE, MOTOR2_PIN_B2, MOTOR2_PIN_B2);  // Activate Motor 2 Pin B2
-    ROM_GPIOPinWrite(MOTOR2_GPIO_BASE, MOTOR2_PIN_B1, 0);              // Deactivate Motor 2 Pin B1
-}
-
-/**
- * Stops both motors by setting both control pins of each motor to low.
- * This function ensures that both motors are in a stopped state with no voltage difference across the motor terminals.
- */
-void MotorStop(void) {
-    // Stop Motor 1 by setting both control pins low.
-    ROM_GPIOPinWrite(MOTOR1_GPIO_BASE, MOTOR1_PIN_A1 | MOTOR1_PIN_A2, 0);
-
-    // Stop Motor 2 by setting both control pins low.
-    ROM_GPIOPinWrite(MOTOR2_GPIO_BASE, MOTOR2_PIN_B1 | MOTOR2_PIN_B2, 0);
-}
-
-/**
- * Starts or restarts the motors by first ensuring they are stopped and then setting them to move forward.
- * This function can be used to safely start the motors during system initialization or after an emergency stop.
- */
-void MotorStart(void) {
-    // Ensure that both motors are stopped before starting.
-    MotorStop();
-
-    // Optionally start the motors moving forward. Uncomment the next line to enable this behavior.
-    // MotorForward();  // Uncomment to start motors in forward direction by default
-}
-
-
-//////////////////////////////////////////////////////////////////////////
-////////////////    Task Function Definitions      ///////////////////////
-//////////////////////////////////////////////////////////////////////////
-
-void CameraUARTService1(void* pvParameters) {
-    uint32_t estimatedMaxExecutions = 20; // Adjust based on expected maximum
-    InitServiceData(&serviceData1, estimatedMaxExecutions);
-
-    while (!abortS1) {
-        if (xSemaphoreTake(semaphore1, portMAX_DELAY) == pdPASS) {
-            serviceData1.startTime[serviceData1.serviceCount] = xTaskGetTickCount();
-
-            if (newDataAvailable) {
-                taskENTER_CRITICAL();
-                uint8_t data = lastReceivedByte;  // Copy to local variable to minimize time in critical section
-                newDataAvailable = false;
-                taskEXIT_CRITICAL();
-
-                TickType_t currentTime = xTaskGetTickCount();
-                UARTprintf("[%u ms] [CameraUARTService1] Received Byte: 0x%02X\n", currentTime, data);
-
-                switch(data) {
-                    case 0xAA:
-                        UARTprintf("[%u ms] [CameraUARTService1] Alert: STOP Sign Detected - Vehicle HALTED\n", currentTime);
-                        break;
-                    case 0x00:
-                        UARTprintf("[%u ms] [CameraUARTService1] Info: Path Clear - Vehicle Continuing\n", currentTime);
-                        break;
-                    default:
-                        UARTprintf("[%u ms] [CameraUARTService1] Warning: Unknown Command 0x%02X - No Action Taken\n", currentTime, data);
-                        break;
-                }
-            }
-
-            serviceData1.endTime[serviceData1.serviceCount] = xTaskGetTickCount();
-            serviceData1.serviceCount++;
-
-            TickType_t executionTime = serviceData1.endTime[serviceData1.serviceCount - 1] - serviceData1.startTime[serviceData1.serviceCount - 1];
-            if (executionTime > serviceData1.wcet) {
-                serviceData1.wcet = executionTime;
-            }
-        }
-    }
-
-    if (xSemaphoreTake(semaphoreUART, portMAX_DELAY) == pdPASS) {
-#if TIMING_ANALYSIS==1
-        int i = 0;
-        for (i = 0; i < serviceData1.serviceCount; i++) {
-            UARTprintf("[%u ms] [CameraUARTService1] Execution %u - Start: %u ms, End: %u ms, Execution Time: %u ms\n",
-                        xTaskGetTickCount(), i + 1, serviceData1.startTime[i], serviceData1.endTime[i], serviceData1.endTime[i] - serviceData1.startTime[i]);
-        }
-#endif
-        UARTprintf("[%u ms] [CameraUARTService1] Summary: Total Executions: %u, WCET: %u ms\n",
-                    xTaskGetTickCount(), serviceData1.serviceCount, serviceData1.wcet);
-
-        xSemaphoreGive(semaphoreUART);
-    }
-
-    DeinitServiceData(&serviceData1);
-    vTaskDelete(NULL);
-}
-
-void Motor1Service2(void* pvParameters) {
-    uint32_t estimatedMaxExecutions = 20; // Adjust based on expected maximum
-    InitServiceData(&serviceData2, estimatedMaxExecutions);
-
-    while (!abortS2) {
-        if (xSemaphoreTake(semaphore2, portMAX_DELAY) == pdPASS) {
-            serviceData2.startTime[serviceData2.serviceCount] = xTaskGetTickCount();
-
-            if (newDataAvailable) {
-                taskENTER_CRITICAL();
-                uint8_t command = lastReceivedByte;
-                newDataAvailable = false;
-                taskEXIT_CRITICAL();
-
-                TickType_t currentTime = xTaskGetTickCount();
-                if (command == 0xAA) {  // If STOP sign detected
-                    MotorStop();  // Stop the motor
-                    UARTprintf("[%u ms] STOP Sign Detected - Motor Stopped.\n", currentTime);
-                } else if (command == 0x00) {  // If STOP sign cleared
-                    MotorForward();  // Resume the motor forward
-                    UARTprintf("[%u ms] [Motor1Service2] Path Clear - Motor Resumed Forward.\n", currentTime);
-                }
-            }
-
-            serviceData2.endTime[serviceData2.serviceCount] = xTaskGetTickCount();
-            serviceData2.serviceCount++;
-
-            TickType_t executionTime = serviceData2.endTime[serviceData2.serviceCount - 1] - serviceData2.startTime[serviceData2.serviceCount - 1];
-            if (executionTime > serviceData2.wcet) {
-                serviceData2.wcet = executionTime;
-            }
-        }
-    }
-
-    if (xSemaphoreTake(semaphoreUART, portMAX_DELAY) == pdPASS) {
-#if TIMING_ANALYSIS==1
-        int i = 0;
-        for (i = 0; i < serviceData2.serviceCount; i++) {
-            UARTprintf("[%u ms] [Motor1Service2] Execution %u - Start: %u ms, End: %u ms, Execution Time: %u ms\n",
-                        xTaskGetTickCount(), i + 1, serviceData2.startTime[i], serviceData2.endTime[i], serviceData2.endTime[i] - serviceData2.startTime[i]);
-        }
-#endif
-        UARTprintf("[%u ms] [Motor1Service2] Summary: Total Executions: %u, WCET: %u ms\n",
-                    xTaskGetTickCount(), serviceData2.serviceCount, serviceData2.wcet);
-
-        xSemaphoreGive(semaphoreUART);
-    }
-
-    DeinitServiceData(&serviceData2);
-    vTaskDelete(NULL);
-}
-
-
-
-void Motor2Service3(void* pvParameters) {
-    uint32_t estimatedMaxExecutions = 20; // Adjust based on expected maximum
-    InitServiceData(&serviceData3, estimatedMaxExecutions);
-
-    while (!abortS3) {
-        if (xSemaphoreTake(semaphore3, portMAX_DELAY) == pdPASS) {
-            serviceData3.startTime[serviceData3.serviceCount] = xTaskGetTickCount();
-
-            if (newDataAvailable) {
-                taskENTER_CRITICAL();
-                uint8_t command = lastReceivedByte;
-                newDataAvailable = false;
-                taskEXIT_CRITICAL();
-
-                TickType_t currentTime = xTaskGetTickCount();
-                if (command == 0xAA) {  // If STOP sign detected
-                    MotorStop();  // Stop the motor
-                    UARTprintf("[%u ms] [Motor2Service3] STOP Sign Detected - Motor Stopped.\n", currentTime);
-                } else if (command == 0x00) {  // If STOP sign cleared
-                    MotorForward();  // Resume the motor forward
-                    UARTprintf("[%u ms] [Motor2Service3] Path Clear - Motor Resumed Forward.\n", currentTime);
-                }
-            }
-            // FIB_TEST(47, 2000); // Placeholder for the actual workload
-
-            serviceData3.endTime[serviceData3.serviceCount] = xTaskGetTickCount();
-            serviceData3.serviceCount++;
-
-            TickType_t executionTime = serviceData3.endTime[serviceData3.serviceCount - 1] - serviceData3.startTime[serviceData3.serviceCount - 1];
-            if (executionTime > serviceData3.wcet) {
-                serviceData3.wcet = executionTime;
-            }
-        }
-    }
-
-    if (xSemaphoreTake(semaphoreUART, portMAX_DELAY) == pdPASS) {
-#if TIMING_ANALYSIS==1
-        int i = 0;
-        for (i = 0; i < serviceData3.serviceCount; i++) {
-            UARTprintf("[%u ms] [Motor2Service3] Execution %u - Start: %u ms, End: %u ms, Execution Time: %u ms\n",
-                        xTaskGetTickCount(), i + 1, serviceData3.startTime[i], serviceData3.endTime[i], serviceData3.endTime[i] - serviceData3.startTime[i]);
-        }
-#endif
-        UARTprintf("[%u ms] [Motor2Service3] Summary: Total Executions: %u, WCET: %u ms\n",
-                    xTaskGetTickCount(), serviceData3.serviceCount, serviceData3.wcet);
-
-        xSemaphoreGive(semaphoreUART);
-    }
-
-    DeinitServiceData(&serviceData3);
-    vTaskDelete(NULL);
-}
-
-void DiagnosticsLEDService4(void* pvParameters) {
-    uint32_t estimatedMaxExecutions = 20; // Adjust based on expected maximum
-    InitServiceData(&serviceData4, estimatedMaxExecutions);
-
-    // Initialize the blue LED
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
-    GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_2);
-
-    while (!abortS4) {
-        if (xSemaphoreTake(semaphore4, portMAX_DELAY) == pdPASS) {
-            serviceData4.startTime[serviceData4.serviceCount] = xTaskGetTickCount();
-            // FIB_TEST(47, 2000); // Placeholder for the actual workload
-
-            if (newDataAvailable) {
-                taskENTER_CRITICAL();
-                uint8_t command = lastReceivedByte;  // Copy to local variable to minimize time in critical section
-                newDataAvailable = false;
-                taskEXIT_CRITICAL();
-
-                if (command == 0xAA) {
-                    GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_2, GPIO_PIN_2);  // Turn on the blue LED
-                    UARTprintf("[%u ms] [DiagnosticsLEDService4] Received Command AA: Blue LED ON\n", xTaskGetTickCount());
-                } else if (command == 0x00) {
-                    GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_2, 0);  // Turn off the blue LED
-                    UARTprintf("[%u ms] [DiagnosticsLEDService4] Received Command 00: Blue LED OFF\n", xTaskGetTickCount());
-                }
-            }
-
-            serviceData4.endTime[serviceData4.serviceCount] = xTaskGetTickCount();
-            serviceData4.serviceCount++;
-
-            // Calculate WCET dynamically
-            TickType_t executionTime = serviceData4.endTime[serviceData4.serviceCount - 1] - serviceData4.startTime[serviceData4.serviceCount - 1];
-            if (executionTime > serviceData4.wcet) {
-                serviceData4.wcet = executionTime;
-            }
-        }
-    }
-
-    if (xSemaphoreTake(semaphoreUART, portMAX_DELAY) == pdPASS) {
-#if TIMING_ANALYSIS==1
-        int i = 0;
-        for (i = 0; i < serviceData4.serviceCount; i++) {
-            UARTprintf("[%u ms] [DiagnosticsLEDService4] Execution %u - Start: %u ms, End: %u ms, Execution Time: %u ms\n",
-                        xTaskGetTickCount(), i + 1, serviceData4.startTime[i], serviceData4.endTime[i], serviceData4.endTime[i] - serviceData4.startTime[i]);
-        }
-#endif
-        UARTprintf("[%u ms] [DiagnosticsLEDService4] Summary: Total Executions: %u, WCET: %u ms\n",
-                    xTaskGetTickCount(), serviceData4.serviceCount, serviceData4.wcet);
-
-        xSemaphoreGive(semaphoreUART);
-    }
-
-    // Clean up
-    DeinitServiceData(&serviceData4);
-    vTaskDelete(NULL);
-}
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: freertes_demo.c
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * This file contains the implementation of a stop sign detection system
+ * for a robotic vehicle controlled by the TIVA TM4C123GH6PM microcontroller,
+ * utilizing FreeRTOS for task management. The project aims to demonstrate
+ * real-time detection of stop signs, enabling the vehicle to make autonomous
+ * navigation decisions.
+ *
+ * The code utilizes hardware interfacing examples provided by TIVAWare and
+ * is designed to handle tasks such as image acquisition from a camera module,
+ * image processing to detect stop signs, and motor control for vehicle movement.
+ *
+ * References:
+ * - TIVAWare demo examples for initial hardware configuration and basic examples.
+ * - UART communication on TM4C123: https://github.com/Reddimus/UARTcommunication-TM4C123
+ * - PWM Control for TM4C123: https://github.com/Mohammed-AhmedAF/PWMController_TM4C123
+ * - MotorLib Embedded for TIVA: https://github.com/GrandviewIoT/MotorLib_Embedded
+ *
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * Professor: Tim Scherr
+ *
+ * University: University of Colorado, Boulder
+ *
+ * Academic Year: [2023-2024]
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"          // Include main header for FreeRTOS.
+#include "FreeRTOSConfig.h"    // Include FreeRTOS configuration settings.
+#include "task.h"              // Include for task management utilities.
+#include "queue.h"             // Include for queue management utilities.
+#include "semphr.h"            // Include for semaphore management utilities.
+#include "timers.h"            // Include for software timer utilities.
+#include "inc/hw_types.h"      // Hardware specific header file to interact with the lower level hardware specific functions.
+#include "inc/hw_memmap.h"     // Header file defining the memory map of the TIVA microcontroller.
+#include "driverlib/sysctl.h"  // Include system control driver for system and clock control utilities.
+#include "driverlib/interrupt.h" // Include for NVIC interrupt controller utilities.
+#include "driverlib/timer.h"   // Include for hardware timer utilities.
+#include "driverlib/gpio.h"    // Include for GPIO pin control utilities.
+#include "driverlib/uart.h"    // Include for UART communication utilities.
+#include "driverlib/pin_map.h" // Include for GPIO pin configuration that maps to specific functions.
+#include "utils/uartstdio.h"   // Include for using UART functions for standard input and output.
+#include "inc/hw_ints.h"       // Include for definitions of interrupt assignments.
+#include "driverlib/rom.h"     // Include for ROM utility functions.
+#include "driverlib/pwm.h"     // Include for Pulse Width Modulation signal generation utilities.
+#include "driverlib/pin_map.h" // Include to define alternate functions for GPIO pins.
+#include "uart_link.h"         // Include for the framed, CRC checked Jetson link.
+#include "event_channel.h"     // Include for fan-out of detection events to the services.
+#include "priorities.h"        // Include for task priorities.
+#include "sequencer.h"         // Include for the table-driven service sequencer.
+#include "service_timing.h"    // Include for cycle accurate service timing.
+#include "trace_store.h"       // Include for the fixed size timing trace of each service.
+#include "telemetry.h"         // Include for binary telemetry from the service bodies.
+#include "motor_control.h"     // Include for atomic two-wheel motor commands and brake ramps.
+#include "console.h"           // Include for the UART0 console gatekeeper.
+#include "runtime_stats.h"     // Include for per-task CPU, stack and context switch statistics.
+#include "tickless_idle.h"     // Include for the sequencer aware tickless idle.
+#include "admission.h"         // Include for admission control of services enabled at run time.
+
+// Define constants for use in timing analysis and other features.
+#define TIMING_ANALYSIS         1
+#define FIBONACCI_ITERATIONS    5000 // Define the number of Fibonacci sequence iterations for test purposes.
+#define MAX_SERVICE_EXECUTIONS  100  // Assuming a maximum of 180 executions for demonstration purposes.
+
+// Sequenced services, in service table order.
+#define SERVICE_1               0
+#define SERVICE_2               1
+#define SERVICE_3               2
+#define SERVICE_4               3
+#define NUM_SERVICES            4
+
+// Stack sizes, in words, of the tasks created outside the sequencer.
+#define LOGGER_STACK_WORDS      128
+#define TELEMETRY_STACK_WORDS   128
+
+// UART and motor configuration settings (motor pins are in motor_control.h)
+#define PWM_FREQUENCY           20000  // Set PWM frequency in Hz.
+
+// Response to a STOP: 1 = ramp the duty down along MOTOR_STOP_PROFILE, 0 = stop at once.
+#define MOTOR_BRAKE_RAMP        0
+#define MOTOR_STOP_PROFILE      MOTOR_PROFILE_S_CURVE
+
+// 1 = the UART1 ISR stops the motors as soon as a STOP frame is complete; the services then
+// only acknowledge and log it. 0 = the motor services stop them at their next release.
+#define UART_FAST_STOP          1
+#define FAST_STOP_STAMPS        8   // STOPs the ISR can stamp ahead of Service 1; a power of two.
+
+#define UART1_RX_PERIPH         SYSCTL_PERIPH_UART1
+#define UART1_RX_BASE           UART1_BASE
+#define UART1_RX_PORT_PERIPH    SYSCTL_PERIPH_GPIOC
+#define UART1_RX_PORT_BASE      GPIO_PORTC_BASE
+#define UART1_RX_PIN            GPIO_PIN_4
+#define UART1_RX_PIN_CONF       GPIO_PC4_U1RX
+
+#define UART2_TX_PERIPH         SYSCTL_PERIPH_UART2
+#define UART2_TX_BASE           UART2_BASE
+#define UART2_TX_PORT_PERIPH    SYSCTL_PERIPH_GPIOD
+#define UART2_TX_PORT_BASE      GPIO_PORTD_BASE
+#define UART2_TX_PIN            GPIO_PIN_7
+#define UART2_TX_PIN_CONF       GPIO_PD7_U2TX
+
+#define UART2_BAUDRATE          (115200)    // Set baud rate for UART.
+
+// System clock rate definition.
+#define SYSTEM_CLOCK            50000000U   // System clock rate in Hz.
+
+// LED configuration details.
+#define LED_PERIPH              SYSCTL_PERIPH_GPIOF
+#define LED_PORT                GPIO_PORTF_BASE
+#define LED_PIN                 GPIO_PIN_2  // Blue LED on TIVA boards.
+
+// The static creation API (configSUPPORT_STATIC_ALLOCATION) first appeared in FreeRTOS V9.0.0.
+#if configSUPPORT_STATIC_ALLOCATION == 1 && (!defined(tskKERNEL_VERSION_MAJOR) || tskKERNEL_VERSION_MAJOR < 9)
+#error "configSUPPORT_STATIC_ALLOCATION needs FreeRTOS V9.0.0 or later"
+#endif
+
+ //////////////////////////////////////////////////////////////////////////
+ ///////////////////    Function Declarations     /////////////////////////
+ //////////////////////////////////////////////////////////////////////////
+
+ // System configuration functions.
+ void SystemConfig();          // Configures the overall system settings, like clock and power.
+ void GPIOConfig();            // Configures the general purpose input/output pins for the system.
+ void UART0Config(void);       // Configures UART0 for serial communication.
+ void TaskConfig();            // Sets up and creates FreeRTOS tasks.
+
+ // ISR's and UART Function Prototypes
+ void ConfigureUARTJetson(void);   // Sets up UART communication for a specific device, like a Jetson board.
+ void UART1IntHandler(void);       // Interrupt handler for UART1, processes UART1 communication interrupts.
+ void UART2IntHandler(void);       // Interrupt handler for UART2, handles interrupts from UART2.
+ void SendSyncReply(const UARTLinkFrame* frame, uint32_t rxTime);            // Answers a Jetson clock sync request.
+ void SendActuationAck(uint8_t service, const ChannelEvent* event, uint32_t actuatedTime); // Reports a motor command to the Jetson.
+ void SendServiceReply(const UARTLinkFrame* frame);   // Answers a Jetson request to enable or disable a service.
+ uint32_t ServiceWcetCycles(uint32_t id);  // Longest measured execution time of a service, for admission control.
+ void FastStopFromISR(const UARTLinkFrame* frame);  // UART1 ISR fast path: stops the motors on a STOP frame.
+
+ // Motor Function Prototypes (the motor commands themselves are in motor_control.h)
+ void MotorStart(void);                    // Starts the motors.
+ void MotorStopCommand(void);              // Carries out a STOP: a brake ramp or an immediate stop.
+ bool MotorResumeCommand(void);            // Carries out a CLEAR unless a newer STOP is already applied.
+
+ // Task Function Prototypes
+ void CameraUARTService1(void *pvParameters);  // FreeRTOS task function for handling UART communication.
+ void Motor1Service2(void *pvParameters);      // Task function for controlling Motor 1.
+ void Motor2Service3(void *pvParameters);      // Task function for controlling Motor 2.
+ void DiagnosticsLEDService4(void *pvParameters); // Task function for LED diagnostics.
+ void OverrunLoggerTask(void *pvParameters);   // Low priority task reporting sequencer overruns.
+
+ // Service table. Periods, offsets and deadlines are in sequencer ticks (10 ms); the sequencer
+ // creates one task per row and releases it from the FreeRTOS tick hook. The WCET column (us) is
+ // what admission control assumes for a service that has not run yet. Only optional services can be
+ // switched on and off over the link.
+ const ServiceConfig serviceTable[] = {
+     // name                      entry                   period offset           deadline stack priority                          wcet flags
+     { "CameraUARTService1",      CameraUARTService1,     1,     SEQ_OFFSET_AUTO, 1,       128,  PRIORITY_CAMERA_UART_SERVICE,     500, 0 },
+     { "Motor1Service2",          Motor1Service2,         1,     SEQ_OFFSET_AUTO, 1,       128,  PRIORITY_MOTOR1_SERVICE,          200, 0 },
+     { "Motor2Service3",          Motor2Service3,         1,     SEQ_OFFSET_AUTO, 1,       128,  PRIORITY_MOTOR2_SERVICE,          200, 0 },
+     { "DiagnosticsLEDService4",  DiagnosticsLEDService4, 25,    SEQ_OFFSET_AUTO, 25,      128,  PRIORITY_DIAGNOSTICS_LED_SERVICE, 200, SEQ_SERVICE_OPTIONAL },
+ };
+
+ // Compile time check that the table matches the SERVICE_x indices.
+ typedef char serviceTableSizeCheck[(sizeof(serviceTable) / sizeof(serviceTable[0]) == NUM_SERVICES) ? 1 : -1];
+
+ TaskHandle_t overrunLoggerHandle; // Task reporting overruns flagged by the sequencer.
+
+#if configSUPPORT_STATIC_ALLOCATION == 1
+ // Control blocks and stacks of the tasks created by TaskConfig and of the idle task.
+ StaticTask_t overrunLoggerTCB, telemetryTCB, statsTCB, idleTCB;
+ StackType_t overrunLoggerStack[LOGGER_STACK_WORDS];
+ StackType_t telemetryStack[TELEMETRY_STACK_WORDS];
+ StackType_t statsStack[RUNTIME_STATS_STACK_WORDS];
+ StackType_t idleStack[configMINIMAL_STACK_SIZE];
+#endif
+
+ // Detection events published by Service 1 (link decoder). Every other service holds its
+ // own subscriber cursor, so each one sees every command exactly once.
+ EventChannel detectionChannel;
+ EventSubscriber motor1Subscriber, motor2Subscriber, ledSubscriber;
+
+ // STOPs carried out by the UART1 ISR fast path. The ISR counts and stamps every STOP frame and
+ // Service 1 counts the same frames as it decodes them. While the counts differ, the motors have
+ // been stopped by a frame that no service has seen yet.
+ typedef struct {
+     uint32_t rxTime;        // TimingNowUs() when the frame was complete.
+     uint32_t actuatedTime;  // TimingNowUs() after the motor command.
+ } FastStopStamp;
+
+ volatile FastStopStamp fastStopStamps[FAST_STOP_STAMPS];
+ volatile uint32_t fastStops = 0;       // Written by the UART1 ISR only.
+ volatile uint32_t decodedStops = 0;    // Written by Service 1 only.
+
+ // Timing trace of each service: the most recent samples plus running statistics.
+ // Statically allocated so memory use is fixed at link time and recording never allocates.
+ TraceStore serviceData1;
+ TraceStore serviceData2;
+ TraceStore serviceData3;
+ TraceStore serviceData4;
+
+ uint32_t idx = 0, jdx = 1;
+ uint32_t fib = 0, fib0 = 0, fib1 = 1;  // Variables for Fibonacci calculation.
+
+ #define FIB_TEST(seqCnt, iterCnt)   \
+  for(idx=0; idx < iterCnt; idx++)   \
+  {                                  \
+      fib = fib0 + fib1;             \
+      while(jdx < seqCnt)            \
+      {                              \
+          fib0 = fib1;               \
+          fib1 = fib;                \
+          fib = fib0 + fib1;         \
+          jdx++;                     \
+  }                                  \
+ }
+
+ // Closes the timing window of one job and adds its sample to the service trace.
+ void RecordServiceTiming(TraceStore* serviceData, uint32_t id, const TimingJob* job) {
+     TimingSample sample;
+
+     ServiceTimingJobEnd(id, job, &sample);
+     TraceStoreAdd(serviceData, &sample);
+ }
+
+ // Prints the retained samples and the timing statistics of a service, in microseconds.
+ void PrintServiceTiming(const char* name, const TraceStore* serviceData) {
+     uint32_t count = serviceData->count;
+#if TIMING_ANALYSIS==1
+     uint32_t i;
+     uint32_t retained = TraceStoreRetained(serviceData);
+     for (i = 0; i < retained; i++) {
+         const TimingSample* sample = TraceStoreSample(serviceData, i);
+         ConsolePrintf("[%u ms] [%s] Execution %u - Response: %u us, Elapsed: %u us, Execution Time: %u us\n",
+                       xTaskGetTickCount(), name, count - retained + i + 1, TimingCyclesToUs(sample->response),
+                       TimingCyclesToUs(sample->elapsed), TimingCyclesToUs(sample->execution));
+     }
+#endif
+     if (count == 0) {
+         return;
+     }
+     ConsolePrintf("[%u ms] [%s] Execution Time: Min: %u us, Mean: %u us, Max (WCET): %u us, Jitter: %u us\n",
+                   xTaskGetTickCount(), name, TimingCyclesToUs(serviceData->execution.min),
+                   TimingCyclesToUs(TraceStatMean(&serviceData->execution, count)),
+                   TimingCyclesToUs(serviceData->execution.max), TimingCyclesToUs(TraceStatJitter(&serviceData->execution, count)));
+     ConsolePrintf("[%u ms] [%s] Response Time: Min: %u us, Mean: %u us, Max (WCRT): %u us, Jitter: %u us\n",
+                   xTaskGetTickCount(), name, TimingCyclesToUs(serviceData->response.min),
+                   TimingCyclesToUs(TraceStatMean(&serviceData->response, count)),
+                   TimingCyclesToUs(serviceData->response.max), TimingCyclesToUs(TraceStatJitter(&serviceData->response, count)));
+ }
+
+#ifdef DEBUG
+void __error__(char *pcFilename, uint32_t ui32Line) { }
+#endif
+
+/**
+ * A task overran its stack: nothing it touches can be trusted from here on. Stop the motors and
+ * report the task once, polling UART0 directly since no task can print any more.
+ */
+void vApplicationStackOverflowHook(xTaskHandle *pxTask, char *pcTaskName)
+{
+    IntMasterDisable();
+    MotorStop();
+    UARTprintf("Error: Stack overflow in %s\n", pcTaskName);
+    while (1)
+    {
+    }
+}
+
+#if configSUPPORT_STATIC_ALLOCATION == 1
+/**
+ * Hands the kernel the idle task's control block and stack, which it would otherwise take from the heap.
+ */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    *ppxIdleTaskTCBBuffer = &idleTCB;
+    *ppxIdleTaskStackBuffer = idleStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+#endif
+
+/**
+ * Runs on every FreeRTOS tick. The kernel tick is the only periodic time base: one sequencer tick
+ * is SEQ_KERNEL_TICKS of them, which lets tickless idle sleep straight to the next release.
+ */
+void vApplicationTickHook(void) {
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    // Release every service that is due this tick, as described by the service table.
+    if (!SequencerKernelTickFromISR(&xHigherPriorityTaskWoken)) {
+        // The run is over (SEQ_RUN_TICKS): keep the motors stopped.
+        MotorStop();
+    }
+
+    // Toggle the LED as a visual heartbeat indicator.
+    // GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_2, ~GPIOPinRead(GPIO_PORTF_BASE, GPIO_PIN_2));
+
+    // Force a context switch if xHigherPriorityTaskWoken was set to true.
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+//////////////////////////////////////////////////////////////////////////
+///////////////////       Main Entry Point       /////////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+int main(void)
+{
+    SystemConfig();
+
+    // Start the cycle counter used to time the services
+    TimingInit();
+
+    GPIOConfig();
+
+    // Attach the subscribers before any service can publish.
+    EventChannelInit(&detectionChannel);
+    EventSubscriberInit(&motor1Subscriber, &detectionChannel);
+    EventSubscriberInit(&motor2Subscriber, &detectionChannel);
+    EventSubscriberInit(&ledSubscriber, &detectionChannel);
+
+    UART0Config();
+
+    // Binary telemetry rings, drained to UART0 by the telemetry task
+    TelemetryInit();
+
+    // Initialize PWM, GPIO and brake ramp configurations
+    uint32_t pwmPeriod = ROM_SysCtlClockGet() / PWM_FREQUENCY;
+    MotorControlInit(pwmPeriod);
+
+    // Start the motor system
+    MotorStart();
+
+    // Drive the motor forward
+    MotorForward();
+
+    UARTprintf("STOP SIGN DETECTION BOT RUNNING.............\n");
+
+    TaskConfig();
+
+    ConfigureUARTJetson();
+
+    vTaskStartScheduler();
+
+    while (1)
+    {
+        // Main loop does nothing but sleep
+        // SysCtlSleep();
+
+        ;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+///////////////////    Function Definitions      /////////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * Configures the system clock for the microcontroller.
+ */
+void SystemConfig()
+{
+    // Set the system clock to 50 MHz from PLL with a crystal reference of 16 MHz
+    SysCtlClockSet(SYSCTL_SYSDIV_4 | SYSCTL_USE_PLL | SYSCTL_XTAL_16MHZ | SYSCTL_OSC_MAIN);
+}
+
+/**
+ * Configures general-purpose input/output settings for the system, particularly for LEDs.
+ */
+void GPIOConfig()
+{
+    // The following code is commented out but when enabled, it would:
+    // Enable the GPIO port for the LED (PF2)
+    // SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
+
+    // Configure the GPIO pin for the LED as an output
+    // GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_2);
+}
+
+/**
+ * Configures UART0 for basic serial communication.
+ */
+void UART0Config(void)
+{
+    // Enable GPIO Peripheral for UART0 pins and UART0 itself
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
+
+    // Configure the GPIO pins for UART mode
+    GPIOPinConfigure(GPIO_PA0_U0RX);  // Configure PA0 as UART0 RX
+    GPIOPinConfigure(GPIO_PA1_U0TX);  // Configure PA1 as UART0 TX
+    GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
+
+    // Set UART clock source and configure the UART for 115200 baud rate
+    // UART_CLOCK_PIOSC is often used to avoid conflicts with the system clock used by SysCtlClockSet
+    UARTClockSourceSet(UART0_BASE, UART_CLOCK_PIOSC);
+    UARTStdioConfig(0, 115200, 16000000); // Use internal 16MHz oscillator for UART
+}
+
+/**
+ * Configures and creates tasks.
+ */
+void TaskConfig()
+{
+    BaseType_t status;
+
+    // Create one task per row of the service table
+    if (!SequencerInit(serviceTable, NUM_SERVICES)) { UARTprintf("Error: Failed to create sequenced services\n"); }
+    AdmissionInit(ServiceWcetCycles, ConsoleBlockingUs);
+
+    // Create the console gatekeeper, the only task printing to UART0 once the scheduler runs
+    if (!ConsoleInit()) { UARTprintf("Error: Failed to create Console Task\n"); }
+
+    // Create the low priority task that reports overruns flagged by the sequencer
+#if configSUPPORT_STATIC_ALLOCATION == 1
+    overrunLoggerHandle = xTaskCreateStatic(OverrunLoggerTask, "OverrunLogger", LOGGER_STACK_WORDS, NULL,
+                                            tskIDLE_PRIORITY + PRIORITY_LOGGER_TASK, overrunLoggerStack, &overrunLoggerTCB);
+    status = (overrunLoggerHandle != NULL) ? pdTRUE : pdFALSE;
+#else
+    status = xTaskCreate(OverrunLoggerTask, "OverrunLogger", LOGGER_STACK_WORDS, NULL, tskIDLE_PRIORITY + PRIORITY_LOGGER_TASK, &overrunLoggerHandle);
+#endif
+    if (status != pdTRUE) { UARTprintf("Error: Failed to create Overrun Logger Task\n"); }
+    SequencerSetOverrunTask(overrunLoggerHandle);
+
+    // Create the low priority task that drains the binary telemetry rings to UART0
+#if configSUPPORT_STATIC_ALLOCATION == 1
+    status = (xTaskCreateStatic(TelemetryTask, "Telemetry", TELEMETRY_STACK_WORDS, NULL, tskIDLE_PRIORITY + PRIORITY_TELEMETRY_TASK,
+                                telemetryStack, &telemetryTCB) != NULL) ? pdTRUE : pdFALSE;
+#else
+    status = xTaskCreate(TelemetryTask, "Telemetry", TELEMETRY_STACK_WORDS, NULL, tskIDLE_PRIORITY + PRIORITY_TELEMETRY_TASK, NULL);
+#endif
+    if (status != pdTRUE) { UARTprintf("Error: Failed to create Telemetry Task\n"); }
+
+    // Create the low priority task that reports CPU share, stack headroom and switches of every task
+#if configSUPPORT_STATIC_ALLOCATION == 1
+    status = (xTaskCreateStatic(RuntimeStatsTask, "Stats", RUNTIME_STATS_STACK_WORDS, NULL, tskIDLE_PRIORITY + PRIORITY_STATS_TASK,
+                                statsStack, &statsTCB) != NULL) ? pdTRUE : pdFALSE;
+#else
+    status = xTaskCreate(RuntimeStatsTask, "Stats", RUNTIME_STATS_STACK_WORDS, NULL, tskIDLE_PRIORITY + PRIORITY_STATS_TASK, NULL);
+#endif
+    if (status != pdTRUE) { UARTprintf("Error: Failed to create Stats Task\n"); }
+}
+
+/**
+ * Configures UART peripherals for communication with Jetson (or other UART devices).
+ * This function sets up UART1 for receiving data and UART2 for transmitting data.
+ */
+void ConfigureUARTJetson(void) {
+    // Enable UART1 and UART2 peripherals to ensure they are powered and ready for configuration.
+    SysCtlPeripheralEnable(UART1_RX_PERIPH);
+    SysCtlPeripheralEnable(UART1_RX_PORT_PERIPH);
+    SysCtlPeripheralEnable(UART2_TX_PERIPH);
+    SysCtlPeripheralEnable(UART2_TX_PORT_PERIPH);
+
+    // Configure the pin associated with UART1_RX for UART functionality.
+    GPIOPinConfigure(UART1_RX_PIN_CONF);
+    GPIOPinTypeUART(UART1_RX_PORT_BASE, UART1_RX_PIN);
+
+    // Configure the pin associated with UART2_TX for UART functionality.
+    GPIOPinConfigure(UART2_TX_PIN_CONF);
+    GPIOPinTypeUART(UART2_TX_PORT_BASE, UART2_TX_PIN);
+
+    // Set up UART1 for reception at 115200 baud, 8 data bits, 1 stop bit, and no parity.
+    UARTConfigSetExpClk(UART1_RX_BASE, SysCtlClockGet(), 115200,
+                        (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
+#if UART_FAST_STOP==1
+    // Interrupt on every byte, so the end of a STOP frame is seen at once rather than after the FIFO
+    // trigger level or the 32 bit receive timeout (about 280 us); the ISR then stops the motors itself.
+    UARTFIFODisable(UART1_RX_BASE);
+    UARTLinkSetFastHandler(FastStopFromISR);
+#else
+    // Use the 16 byte RX FIFO: interrupt at half full, and on receive timeout for the tail of a burst.
+    UARTFIFOEnable(UART1_RX_BASE);
+    UARTFIFOLevelSet(UART1_RX_BASE, UART_FIFO_TX4_8, UART_FIFO_RX4_8);
+#endif
+    UARTIntEnable(UART1_RX_BASE, UART_INT_RX | UART_INT_RT);
+    UARTEnable(UART1_RX_BASE);
+
+    // Set up UART2 for transmission at 115200 baud, 8 data bits, 1 stop bit, and no parity.
+    // Sync replies and actuation acknowledgements go back to the Jetson through the link transmit ring.
+    UARTConfigSetExpClk(UART2_TX_BASE, SysCtlClockGet(), 115200,
+                        (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
+    UARTFIFOEnable(UART2_TX_BASE);
+    UARTFIFOLevelSet(UART2_TX_BASE, UART_FIFO_TX2_8, UART_FIFO_RX4_8);
+    UARTLinkTxInit(UART2_TX_BASE);
+    UARTEnable(UART2_TX_BASE);
+
+    // Register and enable interrupt handler for UART1_RX to handle incoming data.
+    UARTIntRegister(UART1_RX_BASE, UART1IntHandler);
+    IntEnable(INT_UART1);
+
+    // Register and enable interrupt handler for UART2_TX, which refills the TX FIFO from the link transmit ring.
+    UARTIntRegister(UART2_TX_BASE, UART2IntHandler);
+    IntEnable(INT_UART2);
+}
+
+/**
+ * Interrupt handler for UART1. Moves every byte waiting in the RX FIFO into the link receive ring;
+ * frame decoding is left to CameraUARTService1 so the ISR stays short. With UART_FAST_STOP, the
+ * link also hands every complete frame to FastStopFromISR from here.
+ */
+void UART1IntHandler(void) {
+    // Get the current interrupt status and clear it.
+    uint32_t ui32Status = UARTIntStatus(UART1_RX_BASE, true);
+    UARTIntClear(UART1_RX_BASE, ui32Status);
+
+    // Drain the hardware FIFO into the ring buffer.
+    UARTLinkRxFromISR(UART1_RX_BASE);
+}
+
+/**
+ * Interrupt handler for UART2. Tops the TX FIFO up from the link transmit ring whenever it drains
+ * to its trigger level; the interrupt is only enabled while frames are waiting.
+ */
+void UART2IntHandler(void) {
+    uint32_t ui32Status = UARTIntStatus(UART2_TX_BASE, true);
+    UARTIntClear(UART2_TX_BASE, ui32Status);
+
+    UARTLinkTxFromISR();
+}
+
+/**
+ * Starts or restarts the motors by first ensuring they are stopped and then setting them to move forward.
+ * This function can be used to safely start the motors during system initialization or after an emergency stop.
+ */
+void MotorStart(void) {
+    // Ensure that both motors are stopped before starting.
+    MotorStop();
+
+    // Optionally start the motors moving forward. Uncomment the next line to enable this behavior.
+    // MotorForward();  // Uncomment to start motors in forward direction by default
+}
+
+/**
+ * UART1 ISR fast path: stops the motors the moment a valid STOP frame is complete, and stamps
+ * the receive and actuation times for Service 1 to acknowledge. Runs above the FreeRTOS syscall
+ * priority, so it only touches the motor registers and the stamp ring.
+ * @param frame A CRC-checked frame from the ISR's own link parser.
+ */
+void FastStopFromISR(const UARTLinkFrame* frame) {
+    if (frame->len >= 2 && frame->payload[0] == UART_LINK_MSG_DETECTION && frame->payload[1] == DETECTION_STOP) {
+        volatile FastStopStamp* stamp = &fastStopStamps[fastStops & (FAST_STOP_STAMPS - 1)];
+
+        stamp->rxTime = TimingNowUs();
+        MotorStopCommand();
+        stamp->actuatedTime = TimingNowUs();
+        fastStops++;
+    }
+}
+
+/**
+ * Carries out a STOP from the Jetson on both motors. Both motor services call it; while a
+ * ramp runs, or once the motors are stopped, a repeat changes nothing.
+ */
+void MotorStopCommand(void) {
+#if MOTOR_BRAKE_RAMP==1
+    MotorBrake(MOTOR_STOP_PROFILE);
+#else
+    MotorStop();
+#endif
+}
+
+/**
+ * Carries out a CLEAR from the Jetson: both motors forward, unless the fast path has already
+ * stopped them on a newer STOP that Service 1 has not decoded yet. The check and the motor
+ * command run with interrupts masked, so the ISR cannot stop the motors in between.
+ * @return true if the motors were resumed.
+ */
+bool MotorResumeCommand(void) {
+#if UART_FAST_STOP==1
+    bool masked = IntMasterDisable();
+    bool resume = (fastStops == decodedStops);
+
+    if (resume) {
+        MotorForward();
+    }
+    if (!masked) {
+        IntMasterEnable();
+    }
+    return resume;
+#else
+    MotorForward();
+    return true;
+#endif
+}
+
+
+/**
+ * Answers a clock sync request with the Jetson's send time echoed and the TIVA receive and reply
+ * times, so the Jetson can work out the offset between the two clocks from the round trip.
+ * @param frame The decoded UART_LINK_MSG_SYNC_REQUEST frame.
+ * @param rxTime TimingNowUs() when the frame was decoded.
+ */
+void SendSyncReply(const UARTLinkFrame* frame, uint32_t rxTime) {
+    uint8_t payload[14];
+
+    payload[0] = UART_LINK_MSG_SYNC_REPLY;
+    payload[1] = frame->payload[1];
+    UARTLinkPut32(&payload[2], UARTLinkGet32(&frame->payload[2]));
+    UARTLinkPut32(&payload[6], rxTime);
+    UARTLinkPut32(&payload[10], TimingNowUs());
+    UARTLinkSend(payload, sizeof(payload));
+}
+
+/**
+ * Acknowledges a motor command to the Jetson, carrying the capture time of the frame that caused it,
+ * when the TIVA decoded it and when the motor command was written.
+ * @param service Sequencer index of the motor service that acted.
+ * @param event The detection event it acted on.
+ * @param actuatedTime TimingNowUs() right after the motor write.
+ */
+void SendActuationAck(uint8_t service, const ChannelEvent* event, uint32_t actuatedTime) {
+    uint8_t payload[16];
+
+    payload[0] = UART_LINK_MSG_ACTUATION;
+    payload[1] = event->linkSeq;
+    payload[2] = event->value;
+    payload[3] = service;
+    UARTLinkPut32(&payload[4], event->sourceTime);
+    UARTLinkPut32(&payload[8], event->rxTime);
+    UARTLinkPut32(&payload[12], actuatedTime);
+    UARTLinkSend(payload, sizeof(payload));
+}
+
+/**
+ * Answers a Jetson request to enable or disable a service. A service is only enabled if admission
+ * control finds that every enabled service still meets its deadline; the reply carries the verdict,
+ * the service that would have failed and the response time bound of the requested service.
+ * @param frame The decoded service request.
+ */
+void SendServiceReply(const UARTLinkFrame* frame) {
+    static const char* const verdicts[] = { "accepted", "rejected", "invalid" };
+    uint8_t payload[9];
+    uint32_t culprit;
+    uint8_t id = frame->payload[1];
+    bool enable = (frame->payload[2] != 0);
+    AdmissionResult result = AdmissionRequest(id, enable, &culprit);
+    uint32_t bound = (result == ADMISSION_ACCEPTED && enable) ? AdmissionBoundUs(id) : 0;
+
+    payload[0] = UART_LINK_MSG_SERVICE_REPLY;
+    payload[1] = id;
+    payload[2] = enable ? 1 : 0;
+    payload[3] = (uint8_t)result;
+    payload[4] = (uint8_t)culprit;
+    UARTLinkPut32(&payload[5], bound);
+    UARTLinkSend(payload, sizeof(payload));
+
+    ConsolePrintf("[%u ms] [Admission] %s service %u: %s, culprit %u, bound %u us\n", xTaskGetTickCount(),
+                  enable ? "Enable" : "Disable", id, verdicts[result], culprit, bound);
+}
+
+uint32_t ServiceWcetCycles(uint32_t id) {
+    static TraceStore* const serviceData[NUM_SERVICES] = { &serviceData1, &serviceData2, &serviceData3, &serviceData4 };
+
+    return (id < NUM_SERVICES && serviceData[id]->count > 0) ? serviceData[id]->execution.max : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+////////////////    Task Function Definitions      ///////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+void CameraUARTService1(void* pvParameters) {
+    uint32_t reportedLinkErrors = 0;      // Link error total at the last warning.
+    UARTLinkFrame frame;
+    TimingJob job;
+    TraceStoreReset(&serviceData1);
+
+    while (!SequencerAborted()) {
+        uint32_t releases = SequencerWaitForRelease(SERVICE_1);
+        if (releases > 0) {
+            ServiceTimingJobStart(SERVICE_1, &job);
+
+            // Receive stamp for every frame of this release. Reading it every release also keeps the
+            // microsecond clock extended. Bytes may have arrived up to one period earlier; the Jetson's
+            // clock sync keeps only its lowest round trip samples, which are the ones stamped promptly.
+            uint32_t rxTime = TimingNowUs();
+
+            // Decode every complete frame buffered since the last release.
+            while (UARTLinkReceive(&frame)) {
+                TickType_t currentTime = xTaskGetTickCount();
+
+                if (frame.len >= 6 && frame.payload[0] == UART_LINK_MSG_SYNC_REQUEST) {
+                    SendSyncReply(&frame, rxTime);
+                    continue;
+                }
+
+                if (frame.len >= 3 && frame.payload[0] == UART_LINK_MSG_SERVICE_REQUEST) {
+                    SendServiceReply(&frame);
+                    continue;
+                }
+
+                if (frame.len < 2 || frame.payload[0] != UART_LINK_MSG_DETECTION) {
+                    TelemetryLog(SERVICE_1, TEL_EVT_UNKNOWN_MESSAGE, frame.seq);
+                    continue;
+                }
+
+                uint8_t data = frame.payload[1];
+                TelemetryLog(SERVICE_1, TEL_EVT_FRAME_RX, ((uint32_t)frame.seq << 8) | data);
+
+                switch(data) {
+                    case DETECTION_STOP:
+                        TelemetryLog(SERVICE_1, TEL_EVT_STOP_DETECTED, frame.seq);
+                        break;
+                    case DETECTION_CLEAR:
+                        TelemetryLog(SERVICE_1, TEL_EVT_PATH_CLEAR, frame.seq);
+                        break;
+                    default:
+                        TelemetryLog(SERVICE_1, TEL_EVT_UNKNOWN_COMMAND, data);
+                        continue;
+                }
+
+                // Fan the validated state out to the motor and LED services, with the capture time
+                // the Jetson stamped on it (older senders leave it out) for the actuation acknowledgement.
+                ChannelEvent event;
+                event.timestamp = currentTime;
+                event.type = EVENT_DETECTION;
+                event.value = data;
+                event.linkSeq = frame.seq;
+                event.sourceTime = (frame.len >= 6) ? UARTLinkGet32(&frame.payload[2]) : 0;
+                event.rxTime = rxTime;
+                EventChannelPublish(&detectionChannel, &event);
+
+#if UART_FAST_STOP==1
+                // The UART1 ISR already stopped the motors on this frame; acknowledge it with the ISR's times.
+                if (data == DETECTION_STOP) {
+                    uint32_t n = decodedStops;
+                    if (fastStops - n - 1 < FAST_STOP_STAMPS) {
+                        ChannelEvent acted = event;
+                        acted.rxTime = fastStopStamps[n & (FAST_STOP_STAMPS - 1)].rxTime;
+                        SendActuationAck(UART_LINK_SERVICE_FAST_PATH, &acted, fastStopStamps[n & (FAST_STOP_STAMPS - 1)].actuatedTime);
+                    }
+                    decodedStops = n + 1;
+                }
+#endif
+            }
+
+            // Corrupted or lost frames are reported rather than silently ignored.
+            uint32_t linkErrors = g_uartLinkStats.crcErrors + g_uartLinkStats.lengthErrors +
+                                  g_uartLinkStats.seqGaps + g_uartLinkStats.ringOverflows;
+            if (linkErrors != reportedLinkErrors) {
+                TelemetryLog(SERVICE_1, TEL_EVT_LINK_ERRORS, linkErrors);
+                reportedLinkErrors = linkErrors;
+            }
+
+            RecordServiceTiming(&serviceData1, SERVICE_1, &job);
+
+            SequencerCompleteRelease(SERVICE_1, releases);
+        }
+    }
+
+    PrintServiceTiming("CameraUARTService1", &serviceData1);
+    ConsolePrintf("[%u ms] [CameraUARTService1] Summary: Total Executions: %u, Overruns: %u\n",
+                   xTaskGetTickCount(), serviceData1.count, SequencerOverruns(SERVICE_1));
+    ConsolePrintf("[%u ms] [CameraUARTService1] Link Errors: CRC %u, Length %u, Missing %u, Overflow %u, Resyncs %u\n",
+                   xTaskGetTickCount(), g_uartLinkStats.crcErrors, g_uartLinkStats.lengthErrors,
+                   g_uartLinkStats.seqGaps, g_uartLinkStats.ringOverflows, g_uartLinkStats.seqResyncs);
+    ConsolePrintf("[%u ms] [CameraUARTService1] Link TX: %u frames, %u dropped\n",
+                   xTaskGetTickCount(), g_uartLinkStats.txFrames, g_uartLinkStats.txDropped);
+#if UART_FAST_STOP==1
+    ConsolePrintf("[%u ms] [CameraUARTService1] Fast Path: %u stops from the UART1 ISR\n",
+                   xTaskGetTickCount(), fastStops);
+#endif
+
+    SequencerServiceExit(SERVICE_1);
+    vTaskDelete(NULL);
+}
+
+void Motor1Service2(void* pvParameters) {
+    ChannelEvent event;
+    TimingJob job;
+    TraceStoreReset(&serviceData2);
+
+    while (!SequencerAborted()) {
+        uint32_t releases = SequencerWaitForRelease(SERVICE_2);
+        if (releases > 0) {
+            ServiceTimingJobStart(SERVICE_2, &job);
+
+            // Handle every detection event published since the last release, in order.
+            while (EventChannelReceive(&motor1Subscriber, &event)) {
+                uint8_t command = event.value;
+
+                if (command == DETECTION_STOP) {  // If STOP sign detected
+#if UART_FAST_STOP==1
+                    // Stopped from the UART1 ISR already; repeating it keeps the motors stopped
+                    // should a stale CLEAR have slipped in after Service 1 caught up.
+                    MotorStopCommand();
+                    TelemetryLog(SERVICE_2, TEL_EVT_FAST_STOP, event.linkSeq);
+#else
+                    MotorStopCommand();  // Stop the motors
+                    SendActuationAck(SERVICE_2, &event, TimingNowUs());
+                    TelemetryLog(SERVICE_2, TEL_EVT_MOTOR_STOP, event.linkSeq);
+#endif
+                } else if (command == DETECTION_CLEAR) {  // If STOP sign cleared
+                    if (MotorResumeCommand()) {  // Resume both motors forward
+                        SendActuationAck(SERVICE_2, &event, TimingNowUs());
+                        TelemetryLog(SERVICE_2, TEL_EVT_MOTOR_FORWARD, event.linkSeq);
+                    } else {
+                        TelemetryLog(SERVICE_2, TEL_EVT_STALE_CLEAR, event.linkSeq);
+                    }
+                }
+            }
+
+            RecordServiceTiming(&serviceData2, SERVICE_2, &job);
+
+            SequencerCompleteRelease(SERVICE_2, releases);
+        }
+    }
+
+    PrintServiceTiming("Motor1Service2", &serviceData2);
+    ConsolePrintf("[%u ms] [Motor1Service2] Summary: Total Executions: %u, Missed Events: %u, Overruns: %u\n",
+                   xTaskGetTickCount(), serviceData2.count, motor1Subscriber.missed, SequencerOverruns(SERVICE_2));
+
+    SequencerServiceExit(SERVICE_2);
+    vTaskDelete(NULL);
+}
+
+
+
+void Motor2Service3(void* pvParameters) {
+    ChannelEvent event;
+    TimingJob job;
+    TraceStoreReset(&serviceData3);
+
+    while (!SequencerAborted()) {
+        uint32_t releases = SequencerWaitForRelease(SERVICE_3);
+        if (releases > 0) {
+            ServiceTimingJobStart(SERVICE_3, &job);
+
+            // Handle every detection event published since the last release, in order.
+            while (EventChannelReceive(&motor2Subscriber, &event)) {
+                uint8_t command = event.value;
+
+                if (command == DETECTION_STOP) {  // If STOP sign detected
+#if UART_FAST_STOP==1
+                    // Stopped from the UART1 ISR already; repeating it keeps the motors stopped
+                    // should a stale CLEAR have slipped in after Service 1 caught up.
+                    MotorStopCommand();
+                    TelemetryLog(SERVICE_3, TEL_EVT_FAST_STOP, event.linkSeq);
+#else
+                    MotorStopCommand();  // Stop the motors
+                    SendActuationAck(SERVICE_3, &event, TimingNowUs());
+                    TelemetryLog(SERVICE_3, TEL_EVT_MOTOR_STOP, event.linkSeq);
+#endif
+                } else if (command == DETECTION_CLEAR) {  // If STOP sign cleared
+                    if (MotorResumeCommand()) {  // Resume both motors forward
+                        SendActuationAck(SERVICE_3, &event, TimingNowUs());
+                        TelemetryLog(SERVICE_3, TEL_EVT_MOTOR_FORWARD, event.linkSeq);
+                    } else {
+                        TelemetryLog(SERVICE_3, TEL_EVT_STALE_CLEAR, event.linkSeq);
+                    }
+                }
+            }
+            // FIB_TEST(47, 2000); // Placeholder for the actual workload
+
+            RecordServiceTiming(&serviceData3, SERVICE_3, &job);
+
+            SequencerCompleteRelease(SERVICE_3, releases);
+        }
+    }
+
+    PrintServiceTiming("Motor2Service3", &serviceData3);
+    ConsolePrintf("[%u ms] [Motor2Service3] Summary: Total Executions: %u, Missed Events: %u, Overruns: %u\n",
+                   xTaskGetTickCount(), serviceData3.count, motor2Subscriber.missed, SequencerOverruns(SERVICE_3));
+
+    SequencerServiceExit(SERVICE_3);
+    vTaskDelete(NULL);
+}
+
+void DiagnosticsLEDService4(void* pvParameters) {
+    ChannelEvent event;
+    TimingJob job;
+    TraceStoreReset(&serviceData4);
+
+    // Initialize the blue LED
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
+    GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_2);
+
+    while (!SequencerAborted()) {
+        uint32_t releases = SequencerWaitForRelease(SERVICE_4);
+        if (releases > 0) {
+            ServiceTimingJobStart(SERVICE_4, &job);
+            // FIB_TEST(47, 2000); // Placeholder for the actual workload
+
+            // Handle every detection event published since the last release, in order.
+            while (EventChannelReceive(&ledSubscriber, &event)) {
+                uint8_t command = event.value;
+
+                if (command == DETECTION_STOP) {
+                    GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_2, GPIO_PIN_2);  // Turn on the blue LED
+                    TelemetryLog(SERVICE_4, TEL_EVT_LED_ON, event.linkSeq);
+                } else if (command == DETECTION_CLEAR) {
+                    GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_2, 0);  // Turn off the blue LED
+                    TelemetryLog(SERVICE_4, TEL_EVT_LED_OFF, event.linkSeq);
+                }
+            }
+
+            RecordServiceTiming(&serviceData4, SERVICE_4, &job);
+
+            SequencerCompleteRelease(SERVICE_4, releases);
+        }
+    }
+
+    PrintServiceTiming("DiagnosticsLEDService4", &serviceData4);
+    ConsolePrintf("[%u ms] [DiagnosticsLEDService4] Summary: Total Executions: %u, Missed Events: %u, Overruns: %u\n",
+                   xTaskGetTickCount(), serviceData4.count, ledSubscriber.missed, SequencerOverruns(SERVICE_4));
+
+    // Clean up
+    SequencerServiceExit(SERVICE_4);
+    vTaskDelete(NULL);
+}
+
+/**
+ * Reports overruns flagged by the sequencer ISR. Runs at low priority so the UART output never
+ * delays a release; the ISR only sets one notification bit per late service. Once every service
+ * has exited, the service table is printed in the feasibility analyzer's task-set format.
+ */
+void OverrunLoggerTask(void* pvParameters) {
+    static TraceStore* const serviceData[NUM_SERVICES] = { &serviceData1, &serviceData2, &serviceData3, &serviceData4 };
+    uint32_t pendingBits;
+    uint32_t id;
+
+    while (1) {
+        if (xTaskNotifyWait(0, 0xFFFFFFFFUL, &pendingBits, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        for (id = 0; id < NUM_SERVICES; id++) {
+            if (pendingBits & (1UL << id)) {
+                ConsolePrintf("[%u ms] [Sequencer] Warning: %s overrun - Total Overruns: %u\n",
+                              xTaskGetTickCount(), serviceTable[id].name, SequencerOverruns(id));
+            }
+        }
+
+        if (pendingBits & SEQ_NOTIFY_RUN_COMPLETE) {
+            ConsolePrintf("# Task set from the service table, hyperperiod %u us (times in us)\n", SequencerHyperperiod() * SEQ_TICK_US);
+            // J is the measured release jitter, the same for every service; B is the longest a
+            // service waited for the console while the sequencer ran.
+            ConsolePrintf("# name C T D J B\n");
+            for (id = 0; id < NUM_SERVICES; id++) {
+#if SEQ_USE_EDF == 1
+                ConsolePrintf("%s%s %u %u %u %u %u # offset %u, EDF, %u deadline misses\n",
+                              SequencerEnabled(id) ? "" : "# disabled: ", serviceTable[id].name,
+                              TimingCyclesToUs(serviceData[id]->execution.max),
+                              serviceTable[id].period * SEQ_TICK_US, serviceTable[id].deadline * SEQ_TICK_US,
+                              SequencerReleaseJitterUs(), ConsoleBlockingUs(id), SequencerOffset(id) * SEQ_TICK_US,
+                              SequencerDeadlineMisses(id));
+#else
+                ConsolePrintf("%s%s %u %u %u %u %u # offset %u, priority %u, %u deadline misses\n",
+                              SequencerEnabled(id) ? "" : "# disabled: ", serviceTable[id].name,
+                              TimingCyclesToUs(serviceData[id]->execution.max),
+                              serviceTable[id].period * SEQ_TICK_US, serviceTable[id].deadline * SEQ_TICK_US,
+                              SequencerReleaseJitterUs(), ConsoleBlockingUs(id), SequencerOffset(id) * SEQ_TICK_US,
+                              serviceTable[id].priority, SequencerDeadlineMisses(id));
+#endif
+            }
+            ConsolePrintf("# Console: %u lines, %u truncated, %u waits\n",
+                          g_consoleStats.lines, g_consoleStats.truncated, g_consoleStats.waits);
+#if configUSE_TICKLESS_IDLE == 2
+            ConsolePrintf("# Tickless idle: %u sleeps, %u ticks skipped, %u ended on a release, %u aborted\n",
+                          g_ticklessStats.sleeps, g_ticklessStats.skipped, g_ticklessStats.clamped,
+                          g_ticklessStats.aborted);
+#endif
+        }
+    }
+}
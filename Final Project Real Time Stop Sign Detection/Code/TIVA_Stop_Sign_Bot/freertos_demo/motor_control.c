@@ -0,0 +1,324 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: motor_control.c
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Atomic two-wheel motor commands and timer-driven brake ramps. See
+ * motor_control.h.
+ *
+ * The two PWM pins sit on different PWM modules (PF0 is M1PWM4, PB4 is
+ * M0PWM2), so a single synchronization write cannot cover both. Instead
+ * each generator defers compare updates until a global synchronization.
+ * Both requests are issued back to back with interrupts masked, and the
+ * generator counters were reset together at init. The new duty therefore
+ * takes effect at the same period boundary on both wheels.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_types.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_gpio.h"
+#include "inc/hw_pwm.h"
+#include "inc/hw_ints.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/pwm.h"
+#include "driverlib/timer.h"
+#include "driverlib/rom.h"
+#include "motor_control.h"
+
+// PWM output of each motor: module, generator, output and the registers used on the hot path.
+#define MOTOR1_PWM_BASE         PWM1_BASE
+#define MOTOR1_PWM_GEN          PWM_GEN_2
+#define MOTOR1_PWM_GEN_BIT      PWM_GEN_2_BIT
+#define MOTOR1_PWM_OUT          PWM_OUT_4
+#define MOTOR1_PWM_OUT_BIT      PWM_OUT_4_BIT
+#define MOTOR1_PWM_CMP          PWM_O_2_CMPA
+
+#define MOTOR2_PWM_BASE         PWM0_BASE
+#define MOTOR2_PWM_GEN          PWM_GEN_1
+#define MOTOR2_PWM_GEN_BIT      PWM_GEN_1_BIT
+#define MOTOR2_PWM_OUT          PWM_OUT_2
+#define MOTOR2_PWM_OUT_BIT      PWM_OUT_2_BIT
+#define MOTOR2_PWM_CMP          PWM_O_1_CMPA
+
+// Masked GPIO DATA addresses: a store only changes the pins in the mask.
+#define MOTOR1_DATA             HWREG(MOTOR1_GPIO_BASE + GPIO_O_DATA + ((MOTOR1_PIN_A1 | MOTOR1_PIN_A2) << 2))
+#define MOTOR2_DATA             HWREG(MOTOR2_GPIO_BASE + GPIO_O_DATA + ((MOTOR2_PIN_B1 | MOTOR2_PIN_B2) << 2))
+
+#define MOTOR_RAMP_TIMER_BASE   TIMER1_BASE
+
+static const uint8_t s_motor1Pins[] = { 0, MOTOR1_PIN_A1, MOTOR1_PIN_A2 };  // Indexed by MotorDirection.
+static const uint8_t s_motor2Pins[] = { 0, MOTOR2_PIN_B1, MOTOR2_PIN_B2 };
+
+static uint32_t s_pwmLoad = 0;                              // Generator load value (period - 1).
+static uint16_t s_profile[MOTOR_NUM_PROFILES][MOTOR_RAMP_STEPS];  // Remaining duty after each step, 0 .. 1000.
+
+static MotorCommand s_current;                              // Last command written to the hardware.
+
+// Brake ramp in progress; only touched with interrupts masked or from the Timer1A ISR.
+static volatile bool s_rampActive = false;
+static const uint16_t* s_rampTable;
+static uint32_t s_rampStep;
+static uint16_t s_rampDuty1, s_rampDuty2;                   // Duty when the ramp started.
+
+// Compare value for a duty. Generators count down, high from load to compare, so the
+// compare is kept one count inside the period at both ends instead of hitting load or zero.
+static uint32_t DutyToCompare(uint16_t duty) {
+    uint32_t width = (uint32_t)(((uint64_t)(s_pwmLoad + 1) * duty) / MOTOR_DUTY_MAX);
+    uint32_t compare = (width >= s_pwmLoad) ? 1 : s_pwmLoad - width;
+
+    return (compare >= s_pwmLoad) ? s_pwmLoad - 1 : compare;
+}
+
+// Writes cmd to the hardware. Interrupts must be masked.
+static void Commit(const MotorCommand* cmd) {
+    // Directions: one store per port.
+    MOTOR1_DATA = s_motor1Pins[cmd->direction1];
+    MOTOR2_DATA = s_motor2Pins[cmd->direction2];
+
+    // Duties: load both compares, then release them together at the next period boundary.
+    HWREG(MOTOR1_PWM_BASE + MOTOR1_PWM_CMP) = DutyToCompare(cmd->duty1);
+    HWREG(MOTOR2_PWM_BASE + MOTOR2_PWM_CMP) = DutyToCompare(cmd->duty2);
+    HWREG(MOTOR1_PWM_BASE + PWM_O_CTL) |= MOTOR1_PWM_GEN_BIT;
+    HWREG(MOTOR2_PWM_BASE + PWM_O_CTL) |= MOTOR2_PWM_GEN_BIT;
+
+    s_current = *cmd;
+}
+
+// Applies brake step s_rampStep, or the final stop after the last one. Interrupts must be masked.
+static void RampStep(void) {
+    MotorCommand cmd = s_current;
+
+    if (s_rampStep >= MOTOR_RAMP_STEPS) {
+        cmd.direction1 = MOTOR_DIR_STOP;
+        cmd.direction2 = MOTOR_DIR_STOP;
+        cmd.duty1 = 0;
+        cmd.duty2 = 0;
+        s_rampActive = false;
+        TimerDisable(MOTOR_RAMP_TIMER_BASE, TIMER_A);
+    } else {
+        cmd.duty1 = (uint16_t)((uint32_t)s_rampDuty1 * s_rampTable[s_rampStep] / MOTOR_DUTY_MAX);
+        cmd.duty2 = (uint16_t)((uint32_t)s_rampDuty2 * s_rampTable[s_rampStep] / MOTOR_DUTY_MAX);
+        s_rampStep++;
+    }
+    Commit(&cmd);
+}
+
+// Fills the brake lookup tables: the fraction of the starting duty left after each step.
+static void BuildProfiles(void) {
+    uint32_t i;
+
+    for (i = 0; i < MOTOR_RAMP_STEPS; i++) {
+        uint32_t x = ((i + 1) * MOTOR_DUTY_MAX) / MOTOR_RAMP_STEPS;        // Ramp progress, 0 .. 1000.
+        uint32_t left = MOTOR_DUTY_MAX - x;
+
+        s_profile[MOTOR_PROFILE_LINEAR][i] = (uint16_t)left;
+        s_profile[MOTOR_PROFILE_EASE_OUT][i] = (uint16_t)((left * left) / MOTOR_DUTY_MAX);
+        s_profile[MOTOR_PROFILE_S_CURVE][i] = (uint16_t)(MOTOR_DUTY_MAX - (x * x * (3 * MOTOR_DUTY_MAX - 2 * x)) /
+                                                         (MOTOR_DUTY_MAX * MOTOR_DUTY_MAX));
+    }
+}
+
+/**
+ * Configures PWM (Pulse Width Modulation) for controlling motor speed. Both generators count
+ * down, defer compare updates to a global synchronization, and have their counters reset together.
+ * @param pwmPeriod The period of the PWM signal in system clocks, which determines the frequency.
+ */
+static void ConfigurePWM(uint32_t pwmPeriod) {
+    bool masked;
+
+    // Set the PWM clock divider to 1 for full speed.
+    ROM_SysCtlPWMClockSet(SYSCTL_PWMDIV_1);
+
+    // Enable the PWM peripherals for motor control.
+    ROM_SysCtlPeripheralEnable(SYSCTL_PERIPH_PWM1); // PWM1 for Motor 1
+    ROM_SysCtlPeripheralEnable(SYSCTL_PERIPH_PWM0); // PWM0 for Motor 2
+
+    // Enable the GPIO peripherals that the PWM pins are multiplexed on.
+    ROM_SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF); // GPIOF for Motor 1
+    ROM_SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOB); // GPIOB for Motor 2
+
+    // PF0 is locked to its NMI function out of reset; unlock it before changing its function.
+    HWREG(GPIO_PORTF_BASE + GPIO_O_LOCK) = GPIO_LOCK_KEY;
+    HWREG(GPIO_PORTF_BASE + GPIO_O_CR) |= GPIO_PIN_0;
+
+    // Set the specific pins to be used as PWM outputs.
+    ROM_GPIOPinTypePWM(GPIO_PORTF_BASE, GPIO_PIN_0); // PF0 for Motor 1
+    ROM_GPIOPinTypePWM(GPIO_PORTB_BASE, GPIO_PIN_4); // PB4 for Motor 2
+
+    // Configure pin muxing for PWM output on these pins.
+    ROM_GPIOPinConfigure(GPIO_PF0_M1PWM4); // PF0 as M1PWM4 for Motor 1
+    ROM_GPIOPinConfigure(GPIO_PB4_M0PWM2); // PB4 as M0PWM2 for Motor 2
+
+    // Configure both generators; duty starts at zero until the first command.
+    ROM_PWMGenConfigure(MOTOR1_PWM_BASE, MOTOR1_PWM_GEN, PWM_GEN_MODE_DOWN | PWM_GEN_MODE_SYNC);
+    ROM_PWMGenPeriodSet(MOTOR1_PWM_BASE, MOTOR1_PWM_GEN, pwmPeriod);
+    ROM_PWMGenConfigure(MOTOR2_PWM_BASE, MOTOR2_PWM_GEN, PWM_GEN_MODE_DOWN | PWM_GEN_MODE_SYNC);
+    ROM_PWMGenPeriodSet(MOTOR2_PWM_BASE, MOTOR2_PWM_GEN, pwmPeriod);
+    s_pwmLoad = pwmPeriod - 1;
+
+    // Apply the initial load and compare values, then start both counters in step.
+    masked = IntMasterDisable();
+    HWREG(MOTOR1_PWM_BASE + MOTOR1_PWM_CMP) = DutyToCompare(0);
+    HWREG(MOTOR2_PWM_BASE + MOTOR2_PWM_CMP) = DutyToCompare(0);
+    HWREG(MOTOR1_PWM_BASE + PWM_O_CTL) |= MOTOR1_PWM_GEN_BIT;
+    HWREG(MOTOR2_PWM_BASE + PWM_O_CTL) |= MOTOR2_PWM_GEN_BIT;
+    ROM_PWMGenEnable(MOTOR1_PWM_BASE, MOTOR1_PWM_GEN);
+    ROM_PWMGenEnable(MOTOR2_PWM_BASE, MOTOR2_PWM_GEN);
+    HWREG(MOTOR1_PWM_BASE + PWM_O_SYNC) = MOTOR1_PWM_GEN_BIT;
+    HWREG(MOTOR2_PWM_BASE + PWM_O_SYNC) = MOTOR2_PWM_GEN_BIT;
+    if (!masked) {
+        IntMasterEnable();
+    }
+
+    ROM_PWMOutputState(MOTOR1_PWM_BASE, MOTOR1_PWM_OUT_BIT, true);
+    ROM_PWMOutputState(MOTOR2_PWM_BASE, MOTOR2_PWM_OUT_BIT, true);
+}
+
+/**
+ * Configures GPIOs for motor control, setting up pins as output for controlling motor direction.
+ */
+static void ConfigureMotorGPIO(void) {
+    // Enable the GPIO peripheral for Motor 1 and configure its pins as outputs.
+    ROM_SysCtlPeripheralEnable(MOTOR1_GPIO_PERIPH);
+    ROM_GPIOPinTypeGPIOOutput(MOTOR1_GPIO_BASE, MOTOR1_PIN_A1 | MOTOR1_PIN_A2);
+    ROM_GPIOPinWrite(MOTOR1_GPIO_BASE, MOTOR1_PIN_A1 | MOTOR1_PIN_A2, 0); // Initialize pins to low.
+
+    // Enable the GPIO peripheral for Motor 2 and configure its pins as outputs.
+    ROM_SysCtlPeripheralEnable(MOTOR2_GPIO_PERIPH);
+    ROM_GPIOPinTypeGPIOOutput(MOTOR2_GPIO_BASE, MOTOR2_PIN_B1 | MOTOR2_PIN_B2);
+    ROM_GPIOPinWrite(MOTOR2_GPIO_BASE, MOTOR2_PIN_B1 | MOTOR2_PIN_B2, 0); // Initialize pins to low.
+}
+
+/**
+ * Configures Timer1A as the brake ramp clock: periodic at MOTOR_RAMP_STEP_US, enabled only while
+ * a ramp runs.
+ */
+static void ConfigureRampTimer(void) {
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER1);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_TIMER1)) {}
+    TimerConfigure(MOTOR_RAMP_TIMER_BASE, TIMER_CFG_PERIODIC);
+    TimerLoadSet(MOTOR_RAMP_TIMER_BASE, TIMER_A, (SysCtlClockGet() / 1000000) * MOTOR_RAMP_STEP_US - 1);
+    TimerIntRegister(MOTOR_RAMP_TIMER_BASE, TIMER_A, MotorRampIntHandler);
+    TimerIntEnable(MOTOR_RAMP_TIMER_BASE, TIMER_TIMA_TIMEOUT);
+    IntEnable(INT_TIMER1A);
+}
+
+void MotorControlInit(uint32_t pwmPeriod) {
+    MotorCommand stop = { MOTOR_DIR_STOP, MOTOR_DIR_STOP, 0, 0 };
+
+    BuildProfiles();
+    ConfigureMotorGPIO();
+    ConfigurePWM(pwmPeriod);
+    ConfigureRampTimer();
+    MotorApply(&stop);
+}
+
+void MotorApply(const MotorCommand* cmd) {
+    bool masked = IntMasterDisable();
+
+    if (s_rampActive) {
+        s_rampActive = false;
+        TimerDisable(MOTOR_RAMP_TIMER_BASE, TIMER_A);
+    }
+    Commit(cmd);
+
+    if (!masked) {
+        IntMasterEnable();
+    }
+}
+
+void MotorBrake(MotorProfile profile) {
+    bool masked = IntMasterDisable();
+
+    if (!s_rampActive && profile < MOTOR_NUM_PROFILES &&
+        (s_current.direction1 != MOTOR_DIR_STOP || s_current.direction2 != MOTOR_DIR_STOP)) {
+        s_rampTable = s_profile[profile];
+        s_rampStep = 0;
+        s_rampDuty1 = s_current.duty1;
+        s_rampDuty2 = s_current.duty2;
+        s_rampActive = true;
+        RampStep();
+
+        // The timer is stopped between ramps, so reloading it here gives the first step a full period.
+        TimerLoadSet(MOTOR_RAMP_TIMER_BASE, TIMER_A, (SysCtlClockGet() / 1000000) * MOTOR_RAMP_STEP_US - 1);
+        TimerEnable(MOTOR_RAMP_TIMER_BASE, TIMER_A);
+    }
+
+    if (!masked) {
+        IntMasterEnable();
+    }
+}
+
+bool MotorBraking(void) {
+    return s_rampActive;
+}
+
+void MotorCurrent(MotorCommand* cmd) {
+    bool masked = IntMasterDisable();
+
+    *cmd = s_current;
+
+    if (!masked) {
+        IntMasterEnable();
+    }
+}
+
+/**
+ * Sets the direction of both motors to forward at cruise duty, as one command.
+ */
+void MotorForward(void) {
+    MotorCommand cmd = { MOTOR_DIR_FORWARD, MOTOR_DIR_FORWARD, MOTOR_DUTY_CRUISE, MOTOR_DUTY_CRUISE };
+
+    MotorApply(&cmd);
+}
+
+/**
+ * Sets the direction of both motors to reverse at cruise duty, as one command.
+ */
+void MotorReverse(void) {
+    MotorCommand cmd = { MOTOR_DIR_REVERSE, MOTOR_DIR_REVERSE, MOTOR_DUTY_CRUISE, MOTOR_DUTY_CRUISE };
+
+    MotorApply(&cmd);
+}
+
+/**
+ * Stops both motors at once by setting both control pins of each motor low.
+ * This ensures there is no voltage difference across the motor terminals.
+ */
+void MotorStop(void) {
+    MotorCommand cmd = { MOTOR_DIR_STOP, MOTOR_DIR_STOP, 0, 0 };
+
+    MotorApply(&cmd);
+}
+
+void MotorRampIntHandler(void) {
+    bool masked;
+
+    TimerIntClear(MOTOR_RAMP_TIMER_BASE, TIMER_TIMA_TIMEOUT);
+
+    masked = IntMasterDisable();
+    if (s_rampActive) {
+        RampStep();
+    } else {
+        TimerDisable(MOTOR_RAMP_TIMER_BASE, TIMER_A);
+    }
+    if (!masked) {
+        IntMasterEnable();
+    }
+}
@@ -0,0 +1,106 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: motor_control.h
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Motor control for both wheels, driven by one atomic command: the
+ * direction and duty of each motor together.
+ *
+ * MotorApply() writes the direction pins with one masked store to the
+ * GPIO DATA register of each port. It then loads both PWM compare
+ * registers and releases them with a global synchronization request to
+ * each PWM module. The generators are set up for globally synchronized
+ * updates and their counters are started together, so the new duty
+ * reaches both wheels on the same PWM period boundary. The whole update
+ * runs with interrupts masked; no service, ISR or brake step ever sees
+ * one wheel changed and the other not.
+ *
+ * Ramped braking takes the duty down to zero along a profile computed
+ * into a lookup table at init, then stops. The steps are applied from
+ * the Timer1A interrupt, so a ramp costs the motor services nothing
+ * after MotorBrake() returns. Any later MotorApply() cancels it.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#ifndef __MOTOR_CONTROL_H__
+#define __MOTOR_CONTROL_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Direction pins of each motor driver input pair.
+#define MOTOR1_GPIO_PERIPH      SYSCTL_PERIPH_GPIOB
+#define MOTOR1_GPIO_BASE        GPIO_PORTB_BASE
+#define MOTOR1_PIN_A1           GPIO_PIN_0
+#define MOTOR1_PIN_A2           GPIO_PIN_1
+
+#define MOTOR2_GPIO_PERIPH      SYSCTL_PERIPH_GPIOC
+#define MOTOR2_GPIO_BASE        GPIO_PORTC_BASE
+#define MOTOR2_PIN_B1           GPIO_PIN_6           // Motor 2 Pin B1 connected to PC6
+#define MOTOR2_PIN_B2           GPIO_PIN_7           // Motor 2 Pin B2 connected to PC7
+
+// Duty cycle in thousandths of the PWM period.
+#define MOTOR_DUTY_MAX          1000
+#define MOTOR_DUTY_CRUISE       500         // Forward speed, the former fixed 50% duty.
+
+// Brake ramps: each profile is MOTOR_RAMP_STEPS steps, one every MOTOR_RAMP_STEP_US.
+#define MOTOR_RAMP_STEPS        32
+#define MOTOR_RAMP_STEP_US      5000        // 160 ms from full duty to stop.
+
+typedef enum {
+    MOTOR_DIR_STOP = 0,                     // Both inputs low.
+    MOTOR_DIR_FORWARD,
+    MOTOR_DIR_REVERSE
+} MotorDirection;
+
+typedef enum {
+    MOTOR_PROFILE_LINEAR = 0,               // Constant deceleration.
+    MOTOR_PROFILE_EASE_OUT,                 // Sheds most of the speed early, then settles gently.
+    MOTOR_PROFILE_S_CURVE,                  // Smoothstep: gentle at both ends, no jerk on the chassis.
+    MOTOR_NUM_PROFILES
+} MotorProfile;
+
+// One command for both wheels.
+typedef struct {
+    uint8_t direction1;     // MotorDirection of motor 1.
+    uint8_t direction2;     // MotorDirection of motor 2.
+    uint16_t duty1;         // Duty of motor 1, 0 .. MOTOR_DUTY_MAX.
+    uint16_t duty2;         // Duty of motor 2, 0 .. MOTOR_DUTY_MAX.
+} MotorCommand;
+
+// Configures the direction GPIOs, both PWM generators at pwmPeriod system clocks,
+// the brake profiles and Timer1A, and leaves the motors stopped.
+void MotorControlInit(uint32_t pwmPeriod);
+
+// Applies cmd to both motors at once, cancelling any brake ramp. Safe from any context.
+void MotorApply(const MotorCommand* cmd);
+
+// Ramps the current duty down to zero along profile, then stops both motors. The first
+// step is applied before returning. Does nothing while a ramp runs or the motors are stopped.
+void MotorBrake(MotorProfile profile);
+
+// True while a brake ramp is running.
+bool MotorBraking(void);
+
+// The last command applied, including brake steps.
+void MotorCurrent(MotorCommand* cmd);
+
+// Both motors forward at MOTOR_DUTY_CRUISE, or stopped, as one command. Safe from any context.
+void MotorForward(void);
+void MotorReverse(void);
+void MotorStop(void);
+
+// Timer1A interrupt: applies the next brake step.
+void MotorRampIntHandler(void);
+
+#endif // __MOTOR_CONTROL_H__
@@ -0,0 +1,136 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: runtime_stats.c
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Kernel run time statistics and the stats reporting task. See
+ * runtime_stats.h.
+ *
+ * The kernel accumulates each task's run time in 32-bit counters of the
+ * 1 MHz clock, which wrap after about 71 minutes. The task only ever uses
+ * differences between two snapshots one period apart, so the wrap does
+ * not matter.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_types.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_timer.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sequencer.h"
+#include "telemetry.h"
+#include "console.h"
+#include "runtime_stats.h"
+
+#if TELEMETRY_RING_DEPTH < (3 * RUNTIME_STATS_BURST_TASKS + 1)
+#error "RUNTIME_STATS_BURST_TASKS does not fit in the telemetry ring"
+#endif
+
+// Rate monotonic least upper bound n(2^(1/n) - 1) for n = 1 .. SEQ_MAX_SERVICES, in 0.01 %.
+static const uint16_t s_rmLub[SEQ_MAX_SERVICES] = { 10000, 8284, 7798, 7568, 7435, 7348, 7286, 7241 };
+
+static volatile uint32_t s_switches[RUNTIME_STATS_MAX_TASKS];   // Switches in, by task number.
+
+// Reporting task state: the last snapshot of each task number.
+static TaskStatus_t s_status[RUNTIME_STATS_MAX_TASKS];
+static uint32_t s_lastRunTime[RUNTIME_STATS_MAX_TASKS];
+static uint32_t s_lastSwitches[RUNTIME_STATS_MAX_TASKS];
+static bool s_named[RUNTIME_STATS_MAX_TASKS];
+
+void RuntimeStatsTimerInit(void) {
+    SysCtlPeripheralEnable(RUNTIME_STATS_TIMER_PERIPH);
+    while (!SysCtlPeripheralReady(RUNTIME_STATS_TIMER_PERIPH)) {}
+
+    // In up count mode the prescaler extends the counter instead of dividing the clock, so the
+    // timer counts down and RuntimeStatsCounter() turns it around.
+    TimerConfigure(RUNTIME_STATS_TIMER_BASE, TIMER_CFG_SPLIT_PAIR | TIMER_CFG_A_PERIODIC);
+    TimerPrescaleSet(RUNTIME_STATS_TIMER_BASE, TIMER_A, SysCtlClockGet() / RUNTIME_STATS_COUNTER_HZ - 1);
+    TimerLoadSet(RUNTIME_STATS_TIMER_BASE, TIMER_A, 0xFFFFFFFF);
+    TimerEnable(RUNTIME_STATS_TIMER_BASE, TIMER_A);
+}
+
+unsigned long RuntimeStatsCounter(void) {
+    return 0xFFFFFFFFUL - HWREG(RUNTIME_STATS_TIMER_BASE + TIMER_O_TAR);
+}
+
+void RuntimeStatsSwitchedIn(unsigned long taskNumber) {
+    if (taskNumber < RUNTIME_STATS_MAX_TASKS) {
+        s_switches[taskNumber]++;
+    }
+}
+
+// part as a share of total, in 0.01 %.
+static uint32_t Share(uint32_t part, uint32_t total) {
+    return (total == 0) ? 0 : (uint32_t)(((uint64_t)part * 10000) / total);
+}
+
+void RuntimeStatsTask(void* pvParameters) {
+    TickType_t wakeTime = xTaskGetTickCount();
+    uint32_t lastTotal = 0;
+
+    while (1) {
+        uint32_t total, elapsed, servicesShare = 0, services = 0;
+        uint32_t count, i, reported = 0;
+
+        vTaskDelayUntil(&wakeTime, pdMS_TO_TICKS(RUNTIME_STATS_PERIOD_MS));
+
+        count = uxTaskGetSystemState(s_status, RUNTIME_STATS_MAX_TASKS, &total);
+        elapsed = total - lastTotal;
+        lastTotal = total;
+
+        for (i = 0; i < count; i++) {
+            const TaskStatus_t* task = &s_status[i];
+            uint32_t number = task->xTaskNumber;
+            uint32_t tag, share, switches;
+
+            if (number >= RUNTIME_STATS_MAX_TASKS) {
+                continue;
+            }
+            if (!s_named[number]) {
+                ConsolePrintf("# task %u %s\n", number, task->pcTaskName);
+                s_named[number] = true;
+            }
+
+            share = Share(task->ulRunTimeCounter - s_lastRunTime[number], elapsed);
+            switches = s_switches[number] - s_lastSwitches[number];
+            s_lastRunTime[number] = task->ulRunTimeCounter;
+            s_lastSwitches[number] += switches;
+
+            // Sequenced services carry their index + 1 in the task tag.
+            tag = (uint32_t)(uintptr_t)xTaskGetApplicationTaskTag(task->xHandle);
+            if (tag >= 1 && tag <= SEQ_MAX_SERVICES) {
+                servicesShare += share;
+                services++;
+            }
+
+            // Let the telemetry task drain the ring between bursts.
+            if (reported != 0 && reported % RUNTIME_STATS_BURST_TASKS == 0) {
+                vTaskDelay(pdMS_TO_TICKS(TELEMETRY_FLUSH_MS));
+            }
+            TelemetryLog(TELEMETRY_SOURCE_STATS, TEL_EVT_TASK_CPU, (number << 24) | share);
+            TelemetryLog(TELEMETRY_SOURCE_STATS, TEL_EVT_TASK_STACK, (number << 24) | task->usStackHighWaterMark);
+            TelemetryLog(TELEMETRY_SOURCE_STATS, TEL_EVT_TASK_SWITCHES, (number << 24) | (switches & 0xFFFFFF));
+            reported++;
+        }
+
+        if (services != 0) {
+            TelemetryLog(TELEMETRY_SOURCE_STATS, TEL_EVT_CPU_SERVICES,
+                         ((uint32_t)s_rmLub[services - 1] << 16) | servicesShare);
+        }
+    }
+}
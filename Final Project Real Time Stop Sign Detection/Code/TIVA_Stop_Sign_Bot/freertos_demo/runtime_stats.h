@@ -0,0 +1,69 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: runtime_stats.h
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Per-task CPU utilization, stack headroom and context switch counts for
+ * every task in the system, not only the sequenced services.
+ *
+ * The kernel's run time statistics (configGENERATE_RUN_TIME_STATS) are
+ * clocked by WTIMER0A, counting at 1 MHz. The traceTASK_SWITCHED_IN hook
+ * counts how often each task is switched in, indexed by its kernel task
+ * number. Every RUNTIME_STATS_PERIOD_MS a low priority task snapshots all
+ * tasks with uxTaskGetSystemState() and sends, for each task, over the
+ * binary telemetry channel (source TELEMETRY_SOURCE_STATS):
+ *
+ *   TEL_EVT_TASK_CPU       arg = task number << 24 | CPU share of the period, 0.01 %
+ *   TEL_EVT_TASK_STACK     arg = task number << 24 | fewest free stack words so far
+ *   TEL_EVT_TASK_SWITCHES  arg = task number << 24 | switches in during the period
+ *
+ * followed by one TEL_EVT_CPU_SERVICES record: (RM least upper bound for
+ * the number of sequenced services << 16) | their total utilization, both
+ * in 0.01 %. The first time a task number shows up its name is printed on
+ * the console as "# task <number> <name>" so the decoder output can be
+ * read against it.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#ifndef __RUNTIME_STATS_H__
+#define __RUNTIME_STATS_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Run time counter: WTIMER0A counting down from 0xFFFFFFFF, prescaled to 1 MHz.
+#define RUNTIME_STATS_TIMER_PERIPH  SYSCTL_PERIPH_WTIMER0
+#define RUNTIME_STATS_TIMER_BASE    WTIMER0_BASE
+#define RUNTIME_STATS_COUNTER_HZ    1000000
+
+// Reporting period of the stats task.
+#define RUNTIME_STATS_PERIOD_MS     1000
+
+// Tasks tracked. Tasks with a higher kernel task number are not reported.
+#define RUNTIME_STATS_MAX_TASKS     16
+
+// Tasks reported per burst. Each takes three records of the stats telemetry ring, so a burst
+// must fit in TELEMETRY_RING_DEPTH; the task waits one telemetry flush between bursts.
+#define RUNTIME_STATS_BURST_TASKS   4
+
+#define RUNTIME_STATS_STACK_WORDS   128
+
+// Kernel hooks, see FreeRTOSConfig.h.
+void RuntimeStatsTimerInit(void);
+unsigned long RuntimeStatsCounter(void);
+void RuntimeStatsSwitchedIn(unsigned long taskNumber);
+
+// Stats task entry: reports all tasks every RUNTIME_STATS_PERIOD_MS.
+void RuntimeStatsTask(void* pvParameters);
+
+#endif // __RUNTIME_STATS_H__
@@ -0,0 +1,539 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: sequencer.c
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Table-driven cyclic sequencer. See sequencer.h.
+ *
+ * Everything derived from the table (hyperperiod, offsets, tick countdowns)
+ * is computed once in SequencerInit before the scheduler starts, so the
+ * tick hook only decrements one counter per service and never divides.
+ * Only tickless idle, stepping over ticks it slept through, divides.
+ *
+ * Deadlines are absolute sequencer tick counts. s_deadline holds the one of
+ * the oldest release not completed yet; a job answering several releases
+ * moves it on by whole periods, as the releases are strictly periodic.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "sequencer.h"
+#include "service_timing.h"
+#if SEQ_USE_EDF == 1
+#include "priorities.h"
+#endif
+
+static const ServiceConfig* s_table = NULL;     // Application service table.
+static uint32_t s_count = 0;                    // Number of rows in s_table.
+static uint32_t s_hyperperiod = 0;              // LCM of all periods, in sequencer ticks.
+static uint16_t s_offset[SEQ_MAX_SERVICES];     // Resolved release offsets.
+
+static TaskHandle_t s_handles[SEQ_MAX_SERVICES];
+static TaskHandle_t s_overrunTask = NULL;
+#if RELEASE_USE_TASK_NOTIFY == 0
+static SemaphoreHandle_t s_releaseSemaphores[SEQ_MAX_SERVICES];
+#endif
+
+#if configSUPPORT_STATIC_ALLOCATION == 1
+// Control blocks and stacks of the service tasks. Stacks are carved out of one pool in table
+// order, so services with different stack depths waste nothing.
+static StaticTask_t s_taskBuffers[SEQ_MAX_SERVICES];
+static StackType_t s_stackPool[SEQ_STACK_POOL_WORDS];
+static uint32_t s_stackUsed = 0;
+#if RELEASE_USE_TASK_NOTIFY == 0
+static StaticSemaphore_t s_semaphoreBuffers[SEQ_MAX_SERVICES];
+#endif
+#endif
+
+// Release bookkeeping. The sequencer counts releases, each service counts the releases it has
+// completed; a release arriving while the two differ means the previous job overran.
+static volatile uint16_t s_countdown[SEQ_MAX_SERVICES];
+static volatile uint32_t s_releaseCount[SEQ_MAX_SERVICES];
+static volatile uint32_t s_completeCount[SEQ_MAX_SERVICES];
+static volatile uint32_t s_overrunCount[SEQ_MAX_SERVICES];
+static volatile uint32_t s_deadline[SEQ_MAX_SERVICES];      // Absolute deadline of the oldest pending release.
+static volatile bool s_missed[SEQ_MAX_SERVICES];            // That release has already been counted as missed.
+static volatile uint32_t s_missCount[SEQ_MAX_SERVICES];
+static volatile bool s_enabled[SEQ_MAX_SERVICES];           // Releases of the service are delivered.
+
+#if SEQ_USE_EDF == 1
+#define SERVICE_PRIORITY(row)   SEQ_EDF_PRIORITY_BASE   // Until the dispatcher's first pass.
+static TaskHandle_t s_edfTask = NULL;
+static UBaseType_t s_edfPriority[SEQ_MAX_SERVICES];         // Priority last handed out.
+#if configSUPPORT_STATIC_ALLOCATION == 1
+static StaticTask_t s_edfTaskBuffer;
+static StackType_t s_edfStack[SEQ_EDF_STACK_WORDS];
+#endif
+// The band must fit between the dispatcher and the application tasks.
+typedef char seqEdfBandCheck[(SEQ_EDF_PRIORITY_BASE > PRIORITY_SWITCH_TASK) ? 1 : -1];
+#else
+#define SERVICE_PRIORITY(row)   ((row).priority)
+#endif
+
+static volatile uint32_t s_seqCnt = 0;      // Sequencer ticks since start.
+static volatile bool s_aborted = false;     // Set once the run length has elapsed.
+static volatile uint32_t s_exited = 0;      // Services that finished their clean up.
+static uint32_t s_kernelPhase = 0;          // Kernel ticks since the last sequencer tick.
+
+// Release jitter: each sequencer tick is compared against a clock advancing by exactly one
+// sequencer tick of the time base per tick.
+#define SEQ_TICK_CYCLES         (configCPU_CLOCK_HZ / SEQ_TICK_HZ)
+static bool s_jitterStarted = false;
+static uint32_t s_idealStamp = 0;           // Ideal time of the last sequencer tick.
+static uint32_t s_idealCnt = 0;             // s_seqCnt at s_idealStamp.
+static int32_t s_lateMin = 0, s_lateMax = 0;
+
+// Compile time check that the sequencer tick is a whole number of kernel ticks.
+typedef char seqKernelTicksCheck[(configTICK_RATE_HZ % SEQ_TICK_HZ == 0) ? 1 : -1];
+
+static uint32_t Gcd(uint32_t a, uint32_t b) {
+    while (b != 0) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+static uint32_t Lcm(uint32_t a, uint32_t b) {
+    return (a / Gcd(a, b)) * b;
+}
+
+/**
+ * Picks an offset for service i that collides with as few releases of the already placed
+ * services (0 .. i-1) as possible. Two services with periods Pi, Pj and offsets Oi, Oj release on
+ * the same tick iff (Oi - Oj) is a multiple of gcd(Pi, Pj), and then do so H / lcm(Pi, Pj) times
+ * per hyperperiod H. Ties go to the smallest offset, so the result is deterministic.
+ */
+static uint16_t SpreadOffset(uint32_t i) {
+    uint32_t period = s_table[i].period;
+    uint32_t best = 0, bestCost = 0xFFFFFFFFUL;
+    uint32_t candidate, j;
+
+    for (candidate = 0; candidate < period; candidate++) {
+        uint32_t cost = 0;
+        for (j = 0; j < i; j++) {
+            uint32_t g = Gcd(period, s_table[j].period);
+            uint32_t diff = (candidate + s_table[j].period * period - s_offset[j]) % g;
+            if (diff == 0) {
+                cost += s_hyperperiod / Lcm(period, s_table[j].period);
+            }
+        }
+        if (cost < bestCost) {
+            bestCost = cost;
+            best = candidate;
+        }
+    }
+    return (uint16_t)best;
+}
+
+#if SEQ_USE_EDF == 1
+/**
+ * EDF dispatcher. Woken by the tick hook after releases and by a completion that leaves work
+ * pending; runs above every service, so the new priorities are in place before any of them runs.
+ */
+static void EdfDispatcherTask(void* pvParameters) {
+    uint8_t order[SEQ_MAX_SERVICES];
+    uint32_t deadline[SEQ_MAX_SERVICES];
+    bool pending[SEQ_MAX_SERVICES];
+    uint32_t i, j, n;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        taskENTER_CRITICAL();
+        for (i = 0; i < s_count; i++) {
+            pending[i] = (s_releaseCount[i] != s_completeCount[i]);
+            deadline[i] = s_deadline[i];
+        }
+        taskEXIT_CRITICAL();
+
+        // Insertion sort of the services with pending work by deadline; ties keep table order.
+        n = 0;
+        for (i = 0; i < s_count; i++) {
+            if (!pending[i]) {
+                continue;
+            }
+            for (j = n; j > 0 && (int32_t)(deadline[order[j - 1]] - deadline[i]) > 0; j--) {
+                order[j] = order[j - 1];
+            }
+            order[j] = (uint8_t)i;
+            n++;
+        }
+
+        // The earliest deadline gets the top of the band; idle services wait at its bottom.
+        for (i = 0; i < s_count; i++) {
+            UBaseType_t priority = SEQ_EDF_PRIORITY_BASE;
+            for (j = 0; j < n; j++) {
+                if (order[j] == i) {
+                    priority = SEQ_EDF_PRIORITY_BASE + s_count - 1 - j;
+                    break;
+                }
+            }
+            if (priority != s_edfPriority[i]) {
+                s_edfPriority[i] = priority;
+                vTaskPrioritySet(s_handles[i], priority);
+            }
+        }
+    }
+}
+#endif
+
+bool SequencerInit(const ServiceConfig* table, uint32_t count) {
+    bool ok = true;
+    uint32_t i;
+
+    if (count == 0 || count > SEQ_MAX_SERVICES) {
+        return false;
+    }
+
+    s_table = table;
+    s_count = count;
+
+    // Hyperperiod of the whole table.
+    s_hyperperiod = 1;
+    for (i = 0; i < count; i++) {
+        s_hyperperiod = Lcm(s_hyperperiod, table[i].period);
+    }
+
+    // Resolve offsets in table order, then load each countdown with the first release tick.
+    for (i = 0; i < count; i++) {
+        s_offset[i] = (table[i].offset == SEQ_OFFSET_AUTO) ? SpreadOffset(i) : (uint16_t)(table[i].offset % table[i].period);
+        s_countdown[i] = (s_offset[i] == 0) ? table[i].period : s_offset[i];
+        s_releaseCount[i] = 0;
+        s_completeCount[i] = 0;
+        s_overrunCount[i] = 0;
+        s_missCount[i] = 0;
+        s_enabled[i] = ((table[i].flags & SEQ_SERVICE_START_DISABLED) == 0);
+
+#if RELEASE_USE_TASK_NOTIFY == 0
+#if configSUPPORT_STATIC_ALLOCATION == 1
+        s_releaseSemaphores[i] = xSemaphoreCreateBinaryStatic(&s_semaphoreBuffers[i]);
+#else
+        s_releaseSemaphores[i] = xSemaphoreCreateBinary();
+#endif
+        if (s_releaseSemaphores[i] == NULL) { ok = false; }
+#endif
+
+#if SEQ_USE_EDF == 1
+        s_edfPriority[i] = SEQ_EDF_PRIORITY_BASE;
+#endif
+
+#if configSUPPORT_STATIC_ALLOCATION == 1
+        if (s_stackUsed + table[i].stackDepth > SEQ_STACK_POOL_WORDS) {
+            s_handles[i] = NULL;
+        } else {
+            s_handles[i] = xTaskCreateStatic(table[i].entry, table[i].name, table[i].stackDepth, (void*)(uintptr_t)i,
+                                             SERVICE_PRIORITY(table[i]), &s_stackPool[s_stackUsed], &s_taskBuffers[i]);
+            s_stackUsed += table[i].stackDepth;
+        }
+#else
+        if (xTaskCreate(table[i].entry, table[i].name, table[i].stackDepth, (void*)(uintptr_t)i,
+                        SERVICE_PRIORITY(table[i]), &s_handles[i]) != pdTRUE) {
+            s_handles[i] = NULL;
+        }
+#endif
+
+        if (s_handles[i] == NULL) {
+            ok = false;
+        } else {
+            // Lets the context switch hooks attribute execution time to this service.
+            vTaskSetApplicationTaskTag(s_handles[i], (TaskHookFunction_t)(uintptr_t)(i + 1));
+        }
+    }
+
+#if SEQ_USE_EDF == 1
+#if configSUPPORT_STATIC_ALLOCATION == 1
+    s_edfTask = xTaskCreateStatic(EdfDispatcherTask, "EDF", SEQ_EDF_STACK_WORDS, NULL, configMAX_PRIORITIES - 1,
+                                  s_edfStack, &s_edfTaskBuffer);
+#else
+    if (xTaskCreate(EdfDispatcherTask, "EDF", SEQ_EDF_STACK_WORDS, NULL, configMAX_PRIORITIES - 1,
+                    &s_edfTask) != pdTRUE) {
+        s_edfTask = NULL;
+    }
+#endif
+    if (s_edfTask == NULL) {
+        ok = false;
+    }
+#endif
+
+    return ok;
+}
+
+void SequencerSetOverrunTask(TaskHandle_t task) {
+    s_overrunTask = task;
+}
+
+/**
+ * Wakes a service without overrun accounting.
+ */
+static void UnblockServiceFromISR(uint32_t id, BaseType_t* pxHigherPriorityTaskWoken) {
+#if RELEASE_USE_TASK_NOTIFY == 1
+    vTaskNotifyGiveFromISR(s_handles[id], pxHigherPriorityTaskWoken);
+#else
+    xSemaphoreGiveFromISR(s_releaseSemaphores[id], pxHigherPriorityTaskWoken);
+#endif
+}
+
+/**
+ * Releases one service. If the previous release has not completed yet the overrun is counted and
+ * handed to the overrun task, rather than printed from interrupt context.
+ */
+static void ReleaseServiceFromISR(uint32_t id, BaseType_t* pxHigherPriorityTaskWoken) {
+    bool released;
+
+    if (s_releaseCount[id] != s_completeCount[id]) {
+        s_overrunCount[id]++;
+        if (s_overrunTask != NULL) {
+            xTaskNotifyFromISR(s_overrunTask, 1UL << id, eSetBits, pxHigherPriorityTaskWoken);
+        }
+    } else {
+        // Nothing pending: this release starts the next job's response time and sets its deadline.
+        ServiceTimingReleaseFromISR(id);
+        s_deadline[id] = s_seqCnt + s_table[id].deadline;
+        s_missed[id] = false;
+    }
+
+#if RELEASE_USE_TASK_NOTIFY == 1
+    // The notification value counts pending releases, so nothing is silently coalesced.
+    vTaskNotifyGiveFromISR(s_handles[id], pxHigherPriorityTaskWoken);
+    released = true;
+#else
+    released = (xSemaphoreGiveFromISR(s_releaseSemaphores[id], pxHigherPriorityTaskWoken) == pdTRUE);
+#endif
+
+    if (released) {
+        s_releaseCount[id]++;
+    }
+}
+
+/**
+ * Counts a miss for every pending release whose deadline is this tick (or, after tickless idle,
+ * already past).
+ */
+static void CheckDeadlinesFromISR(void) {
+    uint32_t i;
+
+    for (i = 0; i < s_count; i++) {
+        if (s_releaseCount[i] != s_completeCount[i] && !s_missed[i] && (int32_t)(s_seqCnt - s_deadline[i]) >= 0) {
+            s_missed[i] = true;
+            s_missCount[i]++;
+        }
+    }
+}
+
+bool SequencerTickFromISR(BaseType_t* pxHigherPriorityTaskWoken) {
+    bool released = false;
+    uint32_t i;
+
+    if (s_aborted) {
+        return false;
+    }
+
+    s_seqCnt++;
+
+    if (SEQ_RUN_TICKS != 0 && s_seqCnt >= SEQ_RUN_TICKS) {
+        // End of the run: unblock every service so it can report and exit.
+        s_aborted = true;
+        for (i = 0; i < s_count; i++) {
+            UnblockServiceFromISR(i, pxHigherPriorityTaskWoken);
+        }
+        return false;
+    }
+
+    CheckDeadlinesFromISR();
+    for (i = 0; i < s_count; i++) {
+        if (--s_countdown[i] == 0) {
+            s_countdown[i] = s_table[i].period;
+            if (s_enabled[i]) {
+                ReleaseServiceFromISR(i, pxHigherPriorityTaskWoken);
+                released = true;
+            }
+        }
+    }
+
+#if SEQ_USE_EDF == 1
+    if (released) {
+        vTaskNotifyGiveFromISR(s_edfTask, pxHigherPriorityTaskWoken);
+    }
+#else
+    (void)released;
+#endif
+    return true;
+}
+
+/**
+ * Measures how late sequencer tick number tick is against the ideal clock started by the first one.
+ */
+static void RecordTickTime(uint32_t tick) {
+    uint32_t now = TimingNow();
+    int32_t late;
+
+    if (!s_jitterStarted) {
+        s_jitterStarted = true;
+        s_idealStamp = now;
+        s_idealCnt = tick;
+        return;
+    }
+    s_idealStamp += (tick - s_idealCnt) * SEQ_TICK_CYCLES;
+    s_idealCnt = tick;
+    late = (int32_t)(now - s_idealStamp);
+    if (late < s_lateMin) { s_lateMin = late; }
+    if (late > s_lateMax) { s_lateMax = late; }
+}
+
+bool SequencerKernelTickFromISR(BaseType_t* pxHigherPriorityTaskWoken) {
+    if (++s_kernelPhase < SEQ_KERNEL_TICKS) {
+        return !s_aborted;
+    }
+    s_kernelPhase = 0;
+    if (!s_aborted) {
+        RecordTickTime(s_seqCnt + 1);
+    }
+    return SequencerTickFromISR(pxHigherPriorityTaskWoken);
+}
+
+TickType_t SequencerTicksToNextEvent(void) {
+    uint32_t next = 0xFFFFFFFFUL;
+    uint32_t i;
+
+    if (s_aborted) {
+        return portMAX_DELAY;
+    }
+
+    // Sequencer ticks until the first release, or until the tick that ends the run. Disabled
+    // services count too: SequencerSkipTicks() must never step a countdown through zero.
+    for (i = 0; i < s_count; i++) {
+        if (s_countdown[i] < next) { next = s_countdown[i]; }
+    }
+    if (SEQ_RUN_TICKS != 0 && SEQ_RUN_TICKS - s_seqCnt < next) {
+        next = SEQ_RUN_TICKS - s_seqCnt;
+    }
+    // A job blocked on something other than the CPU can still miss its deadline while we sleep.
+    for (i = 0; i < s_count; i++) {
+        if (s_releaseCount[i] != s_completeCount[i] && !s_missed[i]) {
+            int32_t left = (int32_t)(s_deadline[i] - s_seqCnt);
+            uint32_t ticks = (left > 0) ? (uint32_t)left : 1;
+            if (ticks < next) { next = ticks; }
+        }
+    }
+    return (SEQ_KERNEL_TICKS - s_kernelPhase) + (next - 1) * SEQ_KERNEL_TICKS;
+}
+
+void SequencerSkipTicks(TickType_t ticks) {
+    uint32_t total = s_kernelPhase + ticks;
+    uint32_t skipped = total / SEQ_KERNEL_TICKS;
+    uint32_t i;
+
+    s_kernelPhase = total % SEQ_KERNEL_TICKS;
+    if (s_aborted || skipped == 0) {
+        return;
+    }
+
+    // Sequencer ticks without a release: only the counters move.
+    s_seqCnt += skipped;
+    for (i = 0; i < s_count; i++) {
+        s_countdown[i] = (s_countdown[i] > skipped) ? (uint16_t)(s_countdown[i] - skipped) : 1;
+    }
+}
+
+uint32_t SequencerReleaseJitterUs(void) {
+    return TimingCyclesToUs((uint32_t)(s_lateMax - s_lateMin));
+}
+
+void SequencerSetEnabled(uint32_t id, bool enabled) {
+    if (id < s_count) {
+        taskENTER_CRITICAL();
+        s_enabled[id] = enabled;
+        taskEXIT_CRITICAL();
+    }
+}
+
+bool SequencerEnabled(uint32_t id) {
+    return s_enabled[id];
+}
+
+uint32_t SequencerWaitForRelease(uint32_t id) {
+#if RELEASE_USE_TASK_NOTIFY == 1
+    return ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#else
+    return (xSemaphoreTake(s_releaseSemaphores[id], portMAX_DELAY) == pdPASS) ? 1 : 0;
+#endif
+}
+
+void SequencerCompleteRelease(uint32_t id, uint32_t releases) {
+    bool pending;
+
+    taskENTER_CRITICAL();
+    s_completeCount[id] += releases;
+    pending = (s_releaseCount[id] != s_completeCount[id]);
+    if (pending) {
+        // Releases that arrived during the job: the oldest of them is the next job.
+        s_deadline[id] += releases * s_table[id].period;
+        s_missed[id] = false;
+    }
+    taskEXIT_CRITICAL();
+
+#if SEQ_USE_EDF == 1
+    if (pending) {
+        xTaskNotifyGive(s_edfTask);
+    }
+#else
+    (void)pending;
+#endif
+}
+
+bool SequencerAborted(void) {
+    return s_aborted;
+}
+
+void SequencerServiceExit(uint32_t id) {
+    uint32_t exited;
+
+    // Take the count inside the critical section, so only the last service to exit sees s_count.
+    taskENTER_CRITICAL();
+    exited = ++s_exited;
+    taskEXIT_CRITICAL();
+
+    if (exited == s_count && s_overrunTask != NULL) {
+        xTaskNotify(s_overrunTask, SEQ_NOTIFY_RUN_COMPLETE, eSetBits);
+    }
+}
+
+uint32_t SequencerServiceCount(void) {
+    return s_count;
+}
+
+const ServiceConfig* SequencerService(uint32_t id) {
+    return &s_table[id];
+}
+
+uint32_t SequencerOffset(uint32_t id) {
+    return s_offset[id];
+}
+
+uint32_t SequencerHyperperiod(void) {
+    return s_hyperperiod;
+}
+
+uint32_t SequencerOverruns(uint32_t id) {
+    return s_overrunCount[id];
+}
+
+uint32_t SequencerDeadlineMisses(uint32_t id) {
+    return s_missCount[id];
+}
@@ -0,0 +1,163 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: sequencer.h
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Table-driven cyclic sequencer. The application describes its services in
+ * a const ServiceConfig table (name, period, offset, deadline, priority,
+ * stack size and entry function); the sequencer creates the tasks, works
+ * out the hyperperiod and release offsets, and releases each service from
+ * the FreeRTOS tick hook, every SEQ_KERNEL_TICKS kernel ticks (100 Hz).
+ * Adding a service only means adding a row.
+ *
+ * Periods, offsets and deadlines are expressed in sequencer ticks
+ * (SEQ_TICK_HZ). The same table is printed in the feasibility analyzer's
+ * task-set format at the end of a run.
+ *
+ * Every release carries an absolute deadline, its release tick plus the
+ * deadline column. A job still unfinished on its deadline tick is counted as
+ * a deadline miss (SequencerDeadlineMisses()), whatever the scheduling mode.
+ *
+ * With SEQ_USE_EDF the priority column is ignored and the services are
+ * scheduled earliest deadline first on top of the fixed priority kernel: a
+ * dispatcher task above all services is woken whenever a release or a
+ * completion changes the deadlines, sorts the services with pending work by
+ * absolute deadline and hands them the priorities SEQ_EDF_PRIORITY_BASE ..
+ * SEQ_EDF_PRIORITY_BASE + count - 1, the earliest deadline the highest. Equal
+ * deadlines go to the lower table index, so no two services ever share a
+ * priority and round robin never decides the order. The price is one extra
+ * context switch, into the dispatcher, per release tick.
+ *
+ * A service can be disabled at run time (SequencerSetEnabled()): its
+ * release countdown keeps running, so it stays on its offset, but its task
+ * is not released until it is enabled again. Only rows flagged
+ * SEQ_SERVICE_OPTIONAL may be switched (admission.h refuses the others),
+ * and those also flagged SEQ_SERVICE_START_DISABLED start disabled.
+ * Enabling a service is meant to go through admission control, which
+ * checks the grown task set first.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#ifndef __SEQUENCER_H__
+#define __SEQUENCER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Sequencer tick rate and the derived tick length. The sequencer runs off the FreeRTOS tick, so
+// SEQ_TICK_HZ must divide configTICK_RATE_HZ.
+#define SEQ_TICK_HZ             100
+#define SEQ_TICK_US             (1000000UL / SEQ_TICK_HZ)
+#define SEQ_KERNEL_TICKS        (configTICK_RATE_HZ / SEQ_TICK_HZ)  // Kernel ticks per sequencer tick.
+
+// Length of a run in sequencer ticks before all services are aborted (0 = run forever).
+#define SEQ_RUN_TICKS           1000
+
+// Release mechanism: 1 = direct-to-task notifications, 0 = binary semaphores.
+#define RELEASE_USE_TASK_NOTIFY 1
+
+// Service scheduling: 1 = earliest deadline first, 0 = the fixed priorities of the table.
+#define SEQ_USE_EDF             0
+
+// EDF: the lowest of the service priorities handed out by the dispatcher, which itself runs at
+// configMAX_PRIORITIES - 1, above the whole band.
+#define SEQ_EDF_PRIORITY_BASE   (configMAX_PRIORITIES - 1 - SEQ_MAX_SERVICES)
+#define SEQ_EDF_STACK_WORDS     128
+
+// Upper bound on the number of table entries.
+#define SEQ_MAX_SERVICES        8
+
+// Stack words shared by all service tasks when they are allocated statically. Must cover the sum
+// of the stackDepth column of the service table.
+#define SEQ_STACK_POOL_WORDS    512
+
+// Offset value asking the sequencer to pick a release offset that spreads releases.
+#define SEQ_OFFSET_AUTO         0xFFFF
+
+// ServiceConfig flags.
+#define SEQ_SERVICE_OPTIONAL        0x01    // May be enabled and disabled at run time.
+#define SEQ_SERVICE_START_DISABLED  0x02    // Optional service that starts disabled.
+
+// Notification bit sent to the overrun handler task once every service has exited.
+#define SEQ_NOTIFY_RUN_COMPLETE (1UL << 31)
+
+// One row of the service table.
+typedef struct {
+    const char* name;           // Task name and report label.
+    TaskFunction_t entry;       // Task entry function.
+    uint16_t period;            // Release period in sequencer ticks.
+    uint16_t offset;            // First release tick, or SEQ_OFFSET_AUTO.
+    uint16_t deadline;          // Relative deadline in sequencer ticks.
+    uint16_t stackDepth;        // Task stack size in words.
+    UBaseType_t priority;       // FreeRTOS priority, unused with SEQ_USE_EDF.
+    uint16_t wcetUs;            // Execution time admission control assumes until one is measured.
+    uint16_t flags;             // SEQ_SERVICE_* flags.
+} ServiceConfig;
+
+// Set up release bookkeeping, hyperperiod and offsets, and create one task per table row.
+// pvParameters of each task is its service index. Returns false if any task (or the EDF
+// dispatcher) could not be created, or, with static allocation, if the stacks do not fit in
+// SEQ_STACK_POOL_WORDS.
+bool SequencerInit(const ServiceConfig* table, uint32_t count);
+
+// Task that receives one notification bit per late service, plus SEQ_NOTIFY_RUN_COMPLETE.
+void SequencerSetOverrunTask(TaskHandle_t task);
+
+// Called once per sequencer tick. Returns false once the run has ended.
+bool SequencerTickFromISR(BaseType_t* pxHigherPriorityTaskWoken);
+
+// Called from the FreeRTOS tick hook on every kernel tick; runs SequencerTickFromISR() every
+// SEQ_KERNEL_TICKS of them. Returns false once the run has ended.
+bool SequencerKernelTickFromISR(BaseType_t* pxHigherPriorityTaskWoken);
+
+// Tickless idle: kernel ticks from now to the tick that releases a service, ends the run or is
+// the deadline of a pending job (at least 1), or portMAX_DELAY once the run is over. Call with
+// interrupts masked.
+TickType_t SequencerTicksToNextEvent(void);
+
+// Tickless idle: accounts for kernel ticks slept through without the tick hook. ticks must be
+// less than SequencerTicksToNextEvent(), so nothing is released. Call with interrupts masked.
+void SequencerSkipTicks(TickType_t ticks);
+
+// Spread (latest minus earliest) of the sequencer tick times against an ideal fixed rate clock,
+// in microseconds: the release jitter every service sees.
+uint32_t SequencerReleaseJitterUs(void);
+
+// Enables or disables the releases of a service from its next release on. Enabling bypasses
+// admission control; use AdmissionRequest() instead.
+void SequencerSetEnabled(uint32_t id, bool enabled);
+bool SequencerEnabled(uint32_t id);
+
+// Service side: block until the next release; returns the releases answered (0 on failure).
+uint32_t SequencerWaitForRelease(uint32_t id);
+
+// Service side: mark the releases answered by the job that just finished as complete.
+void SequencerCompleteRelease(uint32_t id, uint32_t releases);
+
+// Service side: true once the run is over and the service should print its summary and exit.
+bool SequencerAborted(void);
+
+// Service side: report that the service has finished its end-of-run clean up.
+void SequencerServiceExit(uint32_t id);
+
+// Accessors for reporting.
+uint32_t SequencerServiceCount(void);
+const ServiceConfig* SequencerService(uint32_t id);
+uint32_t SequencerOffset(uint32_t id);
+uint32_t SequencerHyperperiod(void);
+uint32_t SequencerOverruns(uint32_t id);
+uint32_t SequencerDeadlineMisses(uint32_t id);
+
+#endif // __SEQUENCER_H__
@@ -0,0 +1,129 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: service_timing.c
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Cycle accurate service timing. See service_timing.h.
+ *
+ * The switch hooks run inside the kernel's context switch, so they only
+ * read the time base once and touch two words; all conversion to
+ * microseconds happens at report time.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_types.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "sequencer.h"
+#include "service_timing.h"
+
+static uint32_t s_cyclesPerUs = 1;                          // Time base ticks per microsecond.
+
+static uint32_t s_usLastCycles = 0;                         // TimingNowUs(): time base at the last read,
+static uint32_t s_usRemainder = 0;                          // cycles not yet worth a whole microsecond,
+static uint32_t s_usNow = 0;                                // and the microsecond clock itself.
+
+static volatile uint32_t s_releaseStamp[SEQ_MAX_SERVICES];  // Oldest pending release of each service.
+static volatile uint32_t s_execution[SEQ_MAX_SERVICES];     // Cycles run, up to the last switch out.
+static volatile uint32_t s_switchedIn[SEQ_MAX_SERVICES];    // Time stamp of the last switch in.
+
+void TimingInit(void) {
+#if TIMING_USE_DWT == 1
+    HWREG(TIMING_DEMCR) |= TIMING_DEMCR_TRCENA;
+    HWREG(TIMING_DWT_CYCCNT) = 0;
+    HWREG(TIMING_DWT_CTRL) |= TIMING_DWT_CTRL_CYCCNTENA;
+#else
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_WTIMER5);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_WTIMER5)) {}
+    TimerConfigure(TIMING_TIMER_BASE, TIMER_CFG_SPLIT_PAIR | TIMER_CFG_A_PERIODIC_UP);
+    TimerLoadSet(TIMING_TIMER_BASE, TIMER_A, 0xFFFFFFFF);
+    TimerEnable(TIMING_TIMER_BASE, TIMER_A);
+#endif
+
+    s_cyclesPerUs = SysCtlClockGet() / 1000000;
+}
+
+uint32_t TimingCyclesToUs(uint32_t cycles) {
+    return cycles / s_cyclesPerUs;
+}
+
+/**
+ * Advances the microsecond clock by the cycles elapsed since the last read. Interrupts are masked
+ * for the handful of instructions this takes so that concurrent readers never step it twice.
+ */
+uint32_t TimingNowUs(void) {
+    bool masked = IntMasterDisable();
+    uint32_t now = TimingNow();
+    uint32_t cycles = (now - s_usLastCycles) + s_usRemainder;
+    uint32_t us;
+
+    s_usLastCycles = now;
+    s_usNow += cycles / s_cyclesPerUs;
+    s_usRemainder = cycles % s_cyclesPerUs;
+    us = s_usNow;
+
+    if (!masked) {
+        IntMasterEnable();
+    }
+    return us;
+}
+
+void ServiceTimingReleaseFromISR(uint32_t id) {
+    s_releaseStamp[id] = TimingNow();
+}
+
+/**
+ * Execution counter of a running service, including the part of the current run that the switch
+ * out hook has not accounted for yet. Retries if a context switch lands between the reads.
+ */
+static uint32_t ExecutionSoFar(uint32_t id) {
+    uint32_t execution, switchedIn, now;
+
+    do {
+        execution = s_execution[id];
+        switchedIn = s_switchedIn[id];
+        now = TimingNow();
+    } while (execution != s_execution[id]);
+
+    return execution + (now - switchedIn);
+}
+
+void ServiceTimingJobStart(uint32_t id, TimingJob* job) {
+    job->release = s_releaseStamp[id];
+    job->executionBase = ExecutionSoFar(id);
+    job->start = TimingNow();
+}
+
+void ServiceTimingJobEnd(uint32_t id, const TimingJob* job, TimingSample* sample) {
+    uint32_t now = TimingNow();
+
+    sample->execution = ExecutionSoFar(id) - job->executionBase;
+    sample->elapsed = now - job->start;
+    sample->response = now - job->release;
+}
+
+void ServiceTimingSwitchedIn(unsigned long tag) {
+    if (tag != 0 && tag <= SEQ_MAX_SERVICES) {
+        s_switchedIn[tag - 1] = TimingNow();
+    }
+}
+
+void ServiceTimingSwitchedOut(unsigned long tag) {
+    if (tag != 0 && tag <= SEQ_MAX_SERVICES) {
+        s_execution[tag - 1] += TimingNow() - s_switchedIn[tag - 1];
+    }
+}
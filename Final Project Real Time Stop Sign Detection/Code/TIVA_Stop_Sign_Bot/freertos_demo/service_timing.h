@@ -0,0 +1,98 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: service_timing.h
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Cycle accurate timing of the sequenced services. The FreeRTOS tick is
+ * 1 ms and every service finishes well inside a tick, so tick based start
+ * and end times report a WCET of 0 ms. This module timestamps with the
+ * Cortex-M4 DWT cycle counter (or, with TIMING_USE_DWT 0, a free running
+ * 32-bit wide timer) and records three numbers per release:
+ *
+ *   response  - release (sequencer ISR) to job end
+ *   elapsed   - job start to job end, including preemption
+ *   execution - cycles the service actually ran between start and end,
+ *               accumulated by the traceTASK_SWITCHED_IN/OUT hooks
+ *
+ * Each service carries its sequencer index + 1 in its application task
+ * tag; every other task has tag 0 and is ignored by the hooks.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#ifndef __SERVICE_TIMING_H__
+#define __SERVICE_TIMING_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_types.h"
+#include "inc/hw_memmap.h"
+
+// Time base: 1 = DWT cycle counter, 0 = WTIMER5A counting up at the system clock. The DWT
+// counter stops while the core sleeps, so tickless idle (FreeRTOSConfig.h) needs WTIMER5A.
+#define TIMING_USE_DWT          0
+
+#if TIMING_USE_DWT == 1
+// Core debug registers (not covered by the TivaWare headers).
+#define TIMING_DEMCR            0xE000EDFC      // Debug Exception and Monitor Control.
+#define TIMING_DEMCR_TRCENA     0x01000000      // Enables the DWT and ITM units.
+#define TIMING_DWT_CTRL         0xE0001000      // DWT control.
+#define TIMING_DWT_CTRL_CYCCNTENA 0x00000001    // Enables the cycle counter.
+#define TIMING_DWT_CYCCNT       0xE0001004      // DWT cycle count.
+
+// Current time stamp in CPU cycles. A single load, safe from any context.
+#define TimingNow()             HWREG(TIMING_DWT_CYCCNT)
+#else
+#define TIMING_TIMER_BASE       WTIMER5_BASE
+#define TIMING_TIMER_TAV        0x050           // GPTM Timer A value register offset.
+
+#define TimingNow()             HWREG(TIMING_TIMER_BASE + TIMING_TIMER_TAV)
+#endif
+
+// Timing of one job, in cycles.
+typedef struct {
+    uint32_t response;      // Release to end.
+    uint32_t elapsed;       // Start to end, including preemption.
+    uint32_t execution;     // Time spent running between start and end.
+} TimingSample;
+
+// Open timing window of the job a service is currently running.
+typedef struct {
+    uint32_t release;       // Time stamp of the oldest release the job answers.
+    uint32_t start;         // Time stamp at job start.
+    uint32_t executionBase; // Execution counter of the service at job start.
+} TimingJob;
+
+// Start the time base. Call once before the scheduler starts.
+void TimingInit(void);
+
+// Converts a cycle count to microseconds.
+uint32_t TimingCyclesToUs(uint32_t cycles);
+
+// Free running microsecond clock for stamps shared with the Jetson. Wraps after
+// about 71 minutes. It extends the time base in software, so it must be read at
+// least once per time base wrap (86 s at 50 MHz); CameraUARTService1 reads it
+// on every release. Safe from any context.
+uint32_t TimingNowUs(void);
+
+// Sequencer ISR: a release of service id arrived while none was pending.
+void ServiceTimingReleaseFromISR(uint32_t id);
+
+// Service side: bracket one job.
+void ServiceTimingJobStart(uint32_t id, TimingJob* job);
+void ServiceTimingJobEnd(uint32_t id, const TimingJob* job, TimingSample* sample);
+
+// Kernel trace hooks, see FreeRTOSConfig.h. tag is the application task tag.
+void ServiceTimingSwitchedIn(unsigned long tag);
+void ServiceTimingSwitchedOut(unsigned long tag);
+
+#endif // __SERVICE_TIMING_H__
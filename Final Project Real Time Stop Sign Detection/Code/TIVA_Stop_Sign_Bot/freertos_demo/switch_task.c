@@ -1,177 +1,368 @@
-//*****************************************************************************
-//
-// switch_task.c - A simple switch task to process the buttons.
-//
-// Copyright (c) 2012-2017 Texas Instruments Incorporated.  All rights reserved.
-// Software License Agreement
-// 
-// Texas Instruments (TI) is supplying this software for use solely and
-// exclusively on TI's microcontroller products. The software is owned by
-// TI and/or its suppliers, and is protected under applicable copyright
-// laws. You may not combine this software with "viral" open-source
-// software in order to form a larger program.
-// 
-// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
-// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
-// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
-// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
-// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
-// DAMAGES, FOR ANY REASON WHATSOEVER.
-// 
-// This is part of revision 2.1.4.178 of the EK-TM4C123GXL Firmware Package.
-//
-//*****************************************************************************
-
-#include <stdbool.h>
-#include <stdint.h>
-#include "inc/hw_memmap.h"
-#include "inc/hw_types.h"
-#include "inc/hw_gpio.h"
-#include "driverlib/sysctl.h"
-#include "driverlib/gpio.h"
-#include "driverlib/rom.h"
-#include "drivers/buttons.h"
-#include "utils/uartstdio.h"
-#include "switch_task.h"
-#include "led_task.h"
-#include "priorities.h"
-#include "FreeRTOS.h"
-#include "task.h"
-#include "queue.h"
-#include "semphr.h"
-
-//*****************************************************************************
-//
-// The stack size for the display task.
-//
-//*****************************************************************************
-#define SWITCHTASKSTACKSIZE        128         // Stack size in words
-
-extern xQueueHandle g_pLEDQueue;
-extern xSemaphoreHandle g_pUARTSemaphore;
-
-//*****************************************************************************
-//
-// This task reads the buttons' state and passes this information to LEDTask.
-//
-//*****************************************************************************
-static void
-SwitchTask(void *pvParameters)
-{
-    portTickType ui16LastTime;
-    uint32_t ui32SwitchDelay = 25;
-    uint8_t ui8CurButtonState, ui8PrevButtonState;
-    uint8_t ui8Message;
-
-    ui8CurButtonState = ui8PrevButtonState = 0;
-
-    //
-    // Get the current tick count.
-    //
-    ui16LastTime = xTaskGetTickCount();
-
-    //
-    // Loop forever.
-    //
-    while(1)
-    {
-        //
-        // Poll the debounced state of the buttons.
-        //
-        ui8CurButtonState = ButtonsPoll(0, 0);
-
-        //
-        // Check if previous debounced state is equal to the current state.
-        //
-        if(ui8CurButtonState != ui8PrevButtonState)
-        {
-            ui8PrevButtonState = ui8CurButtonState;
-
-            //
-            // Check to make sure the change in state is due to button press
-            // and not due to button release.
-            //
-            if((ui8CurButtonState & ALL_BUTTONS) != 0)
-            {
-                if((ui8CurButtonState & ALL_BUTTONS) == LEFT_BUTTON)
-                {
-                    ui8Message = LEFT_BUTTON;
-
-                    //
-                    // Guard UART from concurrent access.
-                    //
-                    xSemaphoreTake(g_pUARTSemaphore, portMAX_DELAY);
-                    UARTprintf("Left Button is pressed.\n");
-                    xSemaphoreGive(g_pUARTSemaphore);
-                }
-                else if((ui8CurButtonState & ALL_BUTTONS) == RIGHT_BUTTON)
-                {
-                    ui8Message = RIGHT_BUTTON;
-
-                    //
-                    // Guard UART from concurrent access.
-                    //
-                    xSemaphoreTake(g_pUARTSemaphore, portMAX_DELAY);
-                    UARTprintf("Right Button is pressed.\n");
-                    xSemaphoreGive(g_pUARTSemaphore);
-                }
-
-                //
-                // Pass the value of the button pressed to LEDTask.
-                //
-                if(xQueueSend(g_pLEDQueue, &ui8Message, portMAX_DELAY) !=
-                   pdPASS)
-                {
-                    //
-                    // Error. The queue should never be full. If so print the
-                    // error message on UART and wait for ever.
-                    //
-                    UARTprintf("\nQueue full. This should never happen.\n");
-                    while(1)
-                    {
-                    }
-                }
-            }
-        }
-
-        //
-        // Wait for the required amount of time to check back.
-        //
-        vTaskDelayUntil(&ui16LastTime, ui32SwitchDelay / portTICK_RATE_MS);
-    }
-}
-
-//*****************************************************************************
-//
-// Initializes the switch task.
-//
-//*****************************************************************************
-uint32_t
-SwitchTaskInit(void)
-{
-    //
-    // Unlock the GPIO LOCK register for Right button to work.
-    //
-    HWREG(GPIO_PORTF_BASE + GPIO_O_LOCK) = GPIO_LOCK_KEY;
-    HWREG(GPIO_PORTF_BASE + GPIO_O_CR) = 0xFF;
-
-    //
-    // Initialize the buttons
-    //
-    ButtonsInit();
-
-    //
-    // Create the switch task.
-    //
-    if(xTaskCreate(SwitchTask, (const portCHAR *)"Switch",
-                   SWITCHTASKSTACKSIZE, NULL, tskIDLE_PRIORITY +
-                   PRIORITY_SWITCH_TASK, NULL) != pdTRUE)
-    {
-        return(1);
-    }
-
-    //
-    // Success.
-    //
-    return(0);
-}
+//*****************************************************************************
+//
+// switch_task.c - A simple switch task to process the buttons.
+//
+// Copyright (c) 2012-2017 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.4.178 of the EK-TM4C123GXL Firmware Package.
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_gpio.h"
+#include "inc/hw_ints.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/timer.h"
+#include "driverlib/rom.h"
+#include "drivers/buttons.h"
+#include "utils/uartstdio.h"
+#include "switch_task.h"
+#include "led_task.h"
+#include "priorities.h"
+#include "console.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+//*****************************************************************************
+//
+// The stack size for the display task.
+//
+//*****************************************************************************
+#define SWITCHTASKSTACKSIZE        128         // Stack size in words
+
+//*****************************************************************************
+//
+// Button handling. 1 = GPIO edge interrupts debounced by a one-shot hardware
+// timer; the task only runs when the debounced state changes. 0 = poll
+// ButtonsPoll() every 25 ms.
+//
+//*****************************************************************************
+#define SWITCH_USE_INTERRUPTS      1
+
+//
+// Buttons handled in interrupt mode. PF0 (RIGHT_BUTTON) is the M1PWM4 output
+// of motor 1 in this project (motor_control.h), so only PF4 is used here.
+//
+#define SWITCH_BUTTONS             LEFT_BUTTON
+
+//
+// Time the buttons must be quiet after an edge before they are sampled.
+//
+#define SWITCH_DEBOUNCE_MS         10
+
+#define SWITCH_TIMER_PERIPH        SYSCTL_PERIPH_TIMER2
+#define SWITCH_TIMER_BASE          TIMER2_BASE
+#define SWITCH_TIMER_INT           INT_TIMER2A
+
+extern xQueueHandle g_pLEDQueue;
+
+//*****************************************************************************
+//
+// Drop counters. Nothing in the switch path ever blocks or spins.
+//
+//*****************************************************************************
+volatile uint32_t g_ui32SwitchQueueDrops = 0;
+volatile uint32_t g_ui32SwitchNotifyRetries = 0;
+
+#if configSUPPORT_STATIC_ALLOCATION == 1
+//*****************************************************************************
+//
+// Storage for the switch task when the kernel allocates nothing.
+//
+//*****************************************************************************
+static StackType_t g_pxSwitchTaskStack[SWITCHTASKSTACKSIZE];
+static StaticTask_t g_sSwitchTaskBuffer;
+#endif
+
+//*****************************************************************************
+//
+// The switch task, woken by the debounce timer in interrupt mode.
+//
+//*****************************************************************************
+static TaskHandle_t g_hSwitchTask = NULL;
+
+#if SWITCH_USE_INTERRUPTS == 1
+//*****************************************************************************
+//
+// The last debounced state handed to the task (a set bit is a pressed
+// button).
+//
+//*****************************************************************************
+static uint8_t g_ui8ReportedState = 0;
+
+//*****************************************************************************
+//
+// First edge of a press or release. Mask the button interrupts so the bounce
+// that follows costs nothing, and sample the buttons once the debounce timer
+// expires.
+//
+//*****************************************************************************
+static void
+SwitchGPIOIntHandler(void)
+{
+    uint32_t ui32Status = GPIOIntStatus(BUTTONS_GPIO_BASE, true);
+
+    GPIOIntClear(BUTTONS_GPIO_BASE, ui32Status);
+    if((ui32Status & SWITCH_BUTTONS) != 0)
+    {
+        GPIOIntDisable(BUTTONS_GPIO_BASE, SWITCH_BUTTONS);
+        TimerEnable(SWITCH_TIMER_BASE, TIMER_A);
+    }
+}
+
+//*****************************************************************************
+//
+// Debounce timer expired: the buttons have settled. Wake the task only if the
+// state differs from the last one it was given. If the task has not taken
+// that one yet, try again one debounce period later instead of losing either.
+//
+//*****************************************************************************
+static void
+SwitchTimerIntHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint8_t ui8State;
+
+    TimerIntClear(SWITCH_TIMER_BASE, TIMER_TIMA_TIMEOUT);
+
+    //
+    // The buttons are active low.
+    //
+    ui8State = ~GPIOPinRead(BUTTONS_GPIO_BASE, SWITCH_BUTTONS) & SWITCH_BUTTONS;
+
+    if(ui8State != g_ui8ReportedState)
+    {
+        if(xTaskNotifyFromISR(g_hSwitchTask, ui8State,
+                              eSetValueWithoutOverwrite,
+                              &xHigherPriorityTaskWoken) != pdPASS)
+        {
+            g_ui32SwitchNotifyRetries++;
+            TimerEnable(SWITCH_TIMER_BASE, TIMER_A);
+            return;
+        }
+        g_ui8ReportedState = ui8State;
+    }
+
+    //
+    // Edges seen while masked are covered by the sample just taken.
+    //
+    GPIOIntClear(BUTTONS_GPIO_BASE, SWITCH_BUTTONS);
+    GPIOIntEnable(BUTTONS_GPIO_BASE, SWITCH_BUTTONS);
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+//*****************************************************************************
+//
+// Configures the button pins for edge interrupts and the one-shot debounce
+// timer. Both interrupts run at the lowest priority, below everything on the
+// motor path.
+//
+//*****************************************************************************
+static void
+SwitchInterruptsInit(void)
+{
+    SysCtlPeripheralEnable(BUTTONS_GPIO_PERIPH);
+    GPIOPinTypeGPIOInput(BUTTONS_GPIO_BASE, SWITCH_BUTTONS);
+    GPIOPadConfigSet(BUTTONS_GPIO_BASE, SWITCH_BUTTONS, GPIO_STRENGTH_2MA,
+                     GPIO_PIN_TYPE_STD_WPU);
+    GPIOIntTypeSet(BUTTONS_GPIO_BASE, SWITCH_BUTTONS, GPIO_BOTH_EDGES);
+
+    SysCtlPeripheralEnable(SWITCH_TIMER_PERIPH);
+    while(!SysCtlPeripheralReady(SWITCH_TIMER_PERIPH))
+    {
+    }
+    TimerConfigure(SWITCH_TIMER_BASE, TIMER_CFG_ONE_SHOT);
+    TimerLoadSet(SWITCH_TIMER_BASE, TIMER_A,
+                 (SysCtlClockGet() / 1000) * SWITCH_DEBOUNCE_MS);
+    TimerIntRegister(SWITCH_TIMER_BASE, TIMER_A, SwitchTimerIntHandler);
+    IntPrioritySet(SWITCH_TIMER_INT, configKERNEL_INTERRUPT_PRIORITY);
+    TimerIntEnable(SWITCH_TIMER_BASE, TIMER_TIMA_TIMEOUT);
+
+    GPIOIntRegister(BUTTONS_GPIO_BASE, SwitchGPIOIntHandler);
+    IntPrioritySet(INT_GPIOF, configKERNEL_INTERRUPT_PRIORITY);
+    GPIOIntClear(BUTTONS_GPIO_BASE, SWITCH_BUTTONS);
+    GPIOIntEnable(BUTTONS_GPIO_BASE, SWITCH_BUTTONS);
+}
+#endif
+
+//*****************************************************************************
+//
+// Acts on a new debounced button state: a press of one button is reported
+// and passed to LEDTask. The post never blocks; a full queue only costs the
+// message, which is counted.
+//
+//*****************************************************************************
+static void
+SwitchHandleState(uint8_t ui8CurButtonState, uint8_t *pui8PrevButtonState)
+{
+    uint8_t ui8Message;
+
+    //
+    // Check if previous debounced state is equal to the current state.
+    //
+    if(ui8CurButtonState == *pui8PrevButtonState)
+    {
+        return;
+    }
+    *pui8PrevButtonState = ui8CurButtonState;
+
+    //
+    // Check to make sure the change in state is due to button press
+    // and not due to button release.
+    //
+    if((ui8CurButtonState & ALL_BUTTONS) == LEFT_BUTTON)
+    {
+        ui8Message = LEFT_BUTTON;
+
+        //
+        // The console gatekeeper owns the UART.
+        //
+        ConsolePrintf("Left Button is pressed.\n");
+    }
+    else if((ui8CurButtonState & ALL_BUTTONS) == RIGHT_BUTTON)
+    {
+        ui8Message = RIGHT_BUTTON;
+
+        //
+        // The console gatekeeper owns the UART.
+        //
+        ConsolePrintf("Right Button is pressed.\n");
+    }
+    else
+    {
+        return;
+    }
+
+    //
+    // Pass the value of the button pressed to LEDTask.
+    //
+    if(xQueueSend(g_pLEDQueue, &ui8Message, 0) != pdPASS)
+    {
+        g_ui32SwitchQueueDrops++;
+    }
+}
+
+//*****************************************************************************
+//
+// This task passes the buttons' state to LEDTask. In interrupt mode it sleeps
+// until the debounce timer hands it a changed state; otherwise it polls.
+//
+//*****************************************************************************
+static void
+SwitchTask(void *pvParameters)
+{
+    uint8_t ui8PrevButtonState = 0;
+#if SWITCH_USE_INTERRUPTS == 1
+    uint32_t ui32State;
+
+    //
+    // Loop forever.
+    //
+    while(1)
+    {
+        if(xTaskNotifyWait(0, 0xFFFFFFFF, &ui32State, portMAX_DELAY) == pdPASS)
+        {
+            SwitchHandleState((uint8_t)ui32State, &ui8PrevButtonState);
+        }
+    }
+#else
+    portTickType ui16LastTime;
+    uint32_t ui32SwitchDelay = 25;
+
+    //
+    // Get the current tick count.
+    //
+    ui16LastTime = xTaskGetTickCount();
+
+    //
+    // Loop forever.
+    //
+    while(1)
+    {
+        //
+        // Poll the debounced state of the buttons.
+        //
+        SwitchHandleState(ButtonsPoll(0, 0), &ui8PrevButtonState);
+
+        //
+        // Wait for the required amount of time to check back.
+        //
+        vTaskDelayUntil(&ui16LastTime, ui32SwitchDelay / portTICK_RATE_MS);
+    }
+#endif
+}
+
+//*****************************************************************************
+//
+// Initializes the switch task.
+//
+//*****************************************************************************
+uint32_t
+SwitchTaskInit(void)
+{
+#if SWITCH_USE_INTERRUPTS == 0
+    //
+    // Unlock the GPIO LOCK register for Right button to work.
+    //
+    HWREG(GPIO_PORTF_BASE + GPIO_O_LOCK) = GPIO_LOCK_KEY;
+    HWREG(GPIO_PORTF_BASE + GPIO_O_CR) = 0xFF;
+
+    //
+    // Initialize the buttons
+    //
+    ButtonsInit();
+#endif
+
+    //
+    // Create the switch task.
+    //
+#if configSUPPORT_STATIC_ALLOCATION == 1
+    g_hSwitchTask = xTaskCreateStatic(SwitchTask, (const portCHAR *)"Switch",
+                                      SWITCHTASKSTACKSIZE, NULL,
+                                      tskIDLE_PRIORITY + PRIORITY_SWITCH_TASK,
+                                      g_pxSwitchTaskStack,
+                                      &g_sSwitchTaskBuffer);
+    if(g_hSwitchTask == NULL)
+#else
+    if(xTaskCreate(SwitchTask, (const portCHAR *)"Switch",
+                   SWITCHTASKSTACKSIZE, NULL, tskIDLE_PRIORITY +
+                   PRIORITY_SWITCH_TASK, &g_hSwitchTask) != pdTRUE)
+#endif
+    {
+        return(1);
+    }
+
+#if SWITCH_USE_INTERRUPTS == 1
+    //
+    // The interrupts need the task handle, so they are enabled last.
+    //
+    SwitchInterruptsInit();
+#endif
+
+    //
+    // Success.
+    //
+    return(0);
+}
@@ -1,35 +1,45 @@
-//*****************************************************************************
-//
-// switch_task.h - Prototypes for the switch task.
-//
-// Copyright (c) 2012-2017 Texas Instruments Incorporated.  All rights reserved.
-// Software License Agreement
-// 
-// Texas Instruments (TI) is supplying this software for use solely and
-// exclusively on TI's microcontroller products. The software is owned by
-// TI and/or its suppliers, and is protected under applicable copyright
-// laws. You may not combine this software with "viral" open-source
-// software in order to form a larger program.
-// 
-// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
-// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
-// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
-// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
-// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
-// DAMAGES, FOR ANY REASON WHATSOEVER.
-// 
-// This is part of revision 2.1.4.178 of the EK-TM4C123GXL Firmware Package.
-//
-//*****************************************************************************
-
-#ifndef __SWITCH_TASK_H__
-#define __SWITCH_TASK_H__
-
-//*****************************************************************************
-//
-// Prototypes for the switch task.
-//
-//*****************************************************************************
-extern uint32_t SwitchTaskInit(void);
-
-#endif // __SWITCH_TASK_H__
+//*****************************************************************************
+//
+// switch_task.h - Prototypes for the switch task.
+//
+// Copyright (c) 2012-2017 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.4.178 of the EK-TM4C123GXL Firmware Package.
+//
+//*****************************************************************************
+
+#ifndef __SWITCH_TASK_H__
+#define __SWITCH_TASK_H__
+
+//*****************************************************************************
+//
+// Prototypes for the switch task.
+//
+//*****************************************************************************
+extern uint32_t SwitchTaskInit(void);
+
+//*****************************************************************************
+//
+// Button presses lost because the LED queue was full, and debounced states
+// the timer interrupt had to sample again because the task had not taken the
+// previous one yet.
+//
+//*****************************************************************************
+extern volatile uint32_t g_ui32SwitchQueueDrops;
+extern volatile uint32_t g_ui32SwitchNotifyRetries;
+
+#endif // __SWITCH_TASK_H__
@@ -0,0 +1,223 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: telemetry.c
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Lock-free binary telemetry rings and the UART0 logger task.
+ * See telemetry.h.
+ *
+ * Each ring has exactly one producer (its service) and one consumer (the
+ * logger task), so head and tail each have a single writer and neither
+ * side disables interrupts or takes a lock.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_uart.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/uart.h"
+#include "driverlib/udma.h"
+#include "uart_link.h"
+#include "service_timing.h"
+#include "console.h"
+#include "telemetry.h"
+
+#if (TELEMETRY_RING_DEPTH & (TELEMETRY_RING_DEPTH - 1)) != 0
+#error "TELEMETRY_RING_DEPTH must be a power of two"
+#endif
+
+#define TELEMETRY_RING_MASK (TELEMETRY_RING_DEPTH - 1)
+
+typedef struct {
+    TelemetryRecord records[TELEMETRY_RING_DEPTH];
+    volatile uint32_t head;         // Written by the producer only.
+    volatile uint32_t tail;         // Written by the logger only.
+    volatile uint32_t dropped;      // Written by the producer only.
+    uint32_t reportedDropped;       // Logger's copy of dropped at the last TEL_EVT_DROPPED.
+} TelemetryRing;
+
+static TelemetryRing s_rings[TELEMETRY_SOURCES];
+static uint8_t s_frame[TELEMETRY_FRAME_BYTES];
+static uint8_t s_frameSeq = 0;
+
+#if TELEMETRY_USE_UDMA == 1
+static TaskHandle_t s_loggerTask = NULL;
+
+#pragma DATA_ALIGN(s_dmaControlTable, 1024)
+static uint8_t s_dmaControlTable[1024];
+#endif
+
+void TelemetryInit(void) {
+    uint32_t i;
+
+    for (i = 0; i < TELEMETRY_SOURCES; i++) {
+        s_rings[i].head = 0;
+        s_rings[i].tail = 0;
+        s_rings[i].dropped = 0;
+        s_rings[i].reportedDropped = 0;
+    }
+
+#if TELEMETRY_USE_UDMA == 1
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    uDMAEnable();
+    uDMAControlBaseSet(s_dmaControlTable);
+
+    uDMAChannelAttributeDisable(UDMA_CHANNEL_UART0TX, UDMA_ATTR_ALTSELECT | UDMA_ATTR_HIGH_PRIORITY | UDMA_ATTR_REQMASK);
+    uDMAChannelAttributeEnable(UDMA_CHANNEL_UART0TX, UDMA_ATTR_USEBURST);
+    uDMAChannelControlSet(UDMA_CHANNEL_UART0TX | UDMA_PRI_SELECT, UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE | UDMA_ARB_4);
+
+    UARTFIFOLevelSet(UART0_BASE, UART_FIFO_TX4_8, UART_FIFO_RX4_8);
+    UARTDMAEnable(UART0_BASE, UART_DMA_TX);
+    // The handler calls FreeRTOS, so it must not be above the syscall priority.
+    IntPrioritySet(INT_UART0, configMAX_SYSCALL_INTERRUPT_PRIORITY);
+    UARTIntRegister(UART0_BASE, TelemetryUART0IntHandler);
+#endif
+}
+
+void TelemetryLog(uint32_t source, uint8_t event, uint32_t arg) {
+    TelemetryRing* ring = &s_rings[source];
+    uint32_t head = ring->head;
+    TelemetryRecord* record;
+
+    if ((head - ring->tail) >= TELEMETRY_RING_DEPTH) {
+        ring->dropped++;
+        return;
+    }
+
+    record = &ring->records[head & TELEMETRY_RING_MASK];
+    record->timestamp = TimingNow();
+    record->arg = arg;
+    record->source = (uint8_t)source;
+    record->event = event;
+
+    // Publish only after the record is complete.
+    ring->head = head + 1;
+}
+
+static uint8_t* PutRecord(uint8_t* out, const TelemetryRecord* record) {
+    out[0] = (uint8_t)record->timestamp;
+    out[1] = (uint8_t)(record->timestamp >> 8);
+    out[2] = (uint8_t)(record->timestamp >> 16);
+    out[3] = (uint8_t)(record->timestamp >> 24);
+    out[4] = (uint8_t)record->arg;
+    out[5] = (uint8_t)(record->arg >> 8);
+    out[6] = (uint8_t)(record->arg >> 16);
+    out[7] = (uint8_t)(record->arg >> 24);
+    out[8] = record->source;
+    out[9] = record->event;
+    return out + TELEMETRY_RECORD_BYTES;
+}
+
+/**
+ * Moves up to TELEMETRY_BATCH_RECORDS records into s_frame, taking from the sources in turn so no
+ * single busy service starves the others. Returns the number of records framed.
+ */
+static uint32_t FillFrame(void) {
+    uint8_t* out = &s_frame[4];
+    uint32_t count = 0;
+    bool progress = true;
+    uint32_t i;
+
+    // Report new drops first; they describe records that will never arrive.
+    for (i = 0; i < TELEMETRY_SOURCES && count < TELEMETRY_BATCH_RECORDS; i++) {
+        uint32_t dropped = s_rings[i].dropped;
+        if (dropped != s_rings[i].reportedDropped) {
+            TelemetryRecord record = { TimingNow(), dropped, (uint8_t)i, TEL_EVT_DROPPED };
+            out = PutRecord(out, &record);
+            s_rings[i].reportedDropped = dropped;
+            count++;
+        }
+    }
+
+    while (progress && count < TELEMETRY_BATCH_RECORDS) {
+        progress = false;
+        for (i = 0; i < TELEMETRY_SOURCES && count < TELEMETRY_BATCH_RECORDS; i++) {
+            TelemetryRing* ring = &s_rings[i];
+            uint32_t tail = ring->tail;
+            if (tail != ring->head) {
+                out = PutRecord(out, &ring->records[tail & TELEMETRY_RING_MASK]);
+                ring->tail = tail + 1;
+                count++;
+                progress = true;
+            }
+        }
+    }
+
+    return count;
+}
+
+static void SendFrame(uint32_t length) {
+#if TELEMETRY_USE_UDMA == 1
+    uDMAChannelTransferSet(UDMA_CHANNEL_UART0TX | UDMA_PRI_SELECT, UDMA_MODE_BASIC,
+                           s_frame, (void*)(UART0_BASE + UART_O_DR), length);
+    uDMAChannelEnable(UDMA_CHANNEL_UART0TX);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#else
+    uint32_t i;
+    for (i = 0; i < length; i++) {
+        UARTCharPut(UART0_BASE, s_frame[i]);
+    }
+#endif
+}
+
+void TelemetryTask(void* pvParameters) {
+#if TELEMETRY_USE_UDMA == 1
+    s_loggerTask = xTaskGetCurrentTaskHandle();
+#endif
+
+    while (1) {
+        uint32_t count;
+
+        vTaskDelay(pdMS_TO_TICKS(TELEMETRY_FLUSH_MS));
+
+        while ((count = FillFrame()) > 0) {
+            uint32_t length = 4 + count * TELEMETRY_RECORD_BYTES;
+            uint16_t crc;
+
+            s_frame[0] = TELEMETRY_SYNC0;
+            s_frame[1] = TELEMETRY_SYNC1;
+            s_frame[2] = s_frameSeq++;
+            s_frame[3] = (uint8_t)count;
+            crc = UARTLinkCrc16(0xFFFF, &s_frame[2], length - 2);
+            s_frame[length] = (uint8_t)(crc >> 8);
+            s_frame[length + 1] = (uint8_t)crc;
+
+            // Frames and console lines share UART0; the console mutex keeps them apart.
+            ConsoleTake();
+            SendFrame(length + 2);
+            ConsoleGive();
+        }
+    }
+}
+
+void TelemetryUART0IntHandler(void) {
+#if TELEMETRY_USE_UDMA == 1
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t status = UARTIntStatus(UART0_BASE, true);
+
+    UARTIntClear(UART0_BASE, status);
+
+    // The uDMA asserts the UART interrupt when the transfer completes.
+    if (!uDMAChannelIsEnabled(UDMA_CHANNEL_UART0TX) && s_loggerTask != NULL) {
+        vTaskNotifyGiveFromISR(s_loggerTask, &xHigherPriorityTaskWoken);
+    }
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+#endif
+}
@@ -0,0 +1,99 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: telemetry.h
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Binary telemetry from the services. Formatting text with UARTprintf at
+ * 115200 baud costs milliseconds inside the timed section of a service;
+ * TelemetryLog instead copies a 12 byte record into the caller's own
+ * single-producer ring and returns. A low priority task drains the rings
+ * and sends the records on UART0 in batches, optionally by uDMA, for
+ * tools/telemetry_decode.py to turn back into text.
+ *
+ * Batch frame on UART0 (little endian fields, CRC big endian like the
+ * Jetson link):
+ *
+ *   [0xA5] [0x5A] [SEQ] [COUNT] COUNT x [TIMESTAMP:4] [ARG:4] [SOURCE] [EVENT]
+ *   [CRC16 hi] [CRC16 lo]
+ *
+ * The CRC is CRC-16/CCITT-FALSE over SEQ .. last record. Anything on UART0
+ * outside a frame is plain UARTprintf text, which the decoder passes on.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#ifndef __TELEMETRY_H__
+#define __TELEMETRY_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Send batches with uDMA (1) or by filling the UART FIFO from the logger task (0).
+// The uDMA control table costs 1 KB of SRAM because of its alignment.
+#define TELEMETRY_USE_UDMA      0
+
+// Producers, one ring each. Sources 0 .. 3 are the sequenced services (SERVICE_x).
+#define TELEMETRY_SOURCES       5
+#define TELEMETRY_SOURCE_STATS  4       // Run time stats task (runtime_stats.h).
+
+// Records buffered per producer. Must be a power of two.
+#define TELEMETRY_RING_DEPTH    16
+
+// Records per UART frame, and how often the logger task flushes.
+#define TELEMETRY_BATCH_RECORDS 16
+#define TELEMETRY_FLUSH_MS      20
+
+#define TELEMETRY_SYNC0         0xA5
+#define TELEMETRY_SYNC1         0x5A
+#define TELEMETRY_RECORD_BYTES  10
+#define TELEMETRY_FRAME_BYTES   (4 + TELEMETRY_BATCH_RECORDS * TELEMETRY_RECORD_BYTES + 2)
+
+// Event codes. Keep in sync with tools/telemetry_decode.py.
+#define TEL_EVT_FRAME_RX        0x01    // arg = link seq << 8 | command.
+#define TEL_EVT_STOP_DETECTED   0x02    // arg = link seq.
+#define TEL_EVT_PATH_CLEAR      0x03    // arg = link seq.
+#define TEL_EVT_UNKNOWN_COMMAND 0x04    // arg = command.
+#define TEL_EVT_UNKNOWN_MESSAGE 0x05    // arg = link seq.
+#define TEL_EVT_LINK_ERRORS     0x06    // arg = total CRC, length, gap and overflow errors.
+#define TEL_EVT_MOTOR_STOP      0x10    // arg = link seq of the command.
+#define TEL_EVT_MOTOR_FORWARD   0x11    // arg = link seq of the command.
+#define TEL_EVT_FAST_STOP       0x12    // arg = link seq of a STOP the UART ISR already carried out.
+#define TEL_EVT_STALE_CLEAR     0x13    // arg = link seq of a CLEAR ignored after a newer fast STOP.
+#define TEL_EVT_LED_ON          0x20    // arg = link seq of the command.
+#define TEL_EVT_LED_OFF         0x21    // arg = link seq of the command.
+#define TEL_EVT_TASK_CPU        0x30    // arg = task number << 24 | CPU share, 0.01 %.
+#define TEL_EVT_TASK_STACK      0x31    // arg = task number << 24 | stack high water mark, words.
+#define TEL_EVT_TASK_SWITCHES   0x32    // arg = task number << 24 | switches in during the period.
+#define TEL_EVT_CPU_SERVICES    0x33    // arg = RM LUB << 16 | services' utilization, both 0.01 %.
+#define TEL_EVT_DROPPED         0xF0    // arg = records dropped by this source so far.
+
+typedef struct {
+    uint32_t timestamp;     // Time base cycles (service_timing.h).
+    uint32_t arg;           // Event specific argument.
+    uint8_t source;         // Producer / service id.
+    uint8_t event;          // TEL_EVT_xxx.
+} TelemetryRecord;
+
+// Reset the rings and configure uDMA if used. Call before the scheduler starts.
+void TelemetryInit(void);
+
+// Queue one record. Must only be called from the task that owns source. Never blocks;
+// the record is dropped (and counted) if the ring is full.
+void TelemetryLog(uint32_t source, uint8_t event, uint32_t arg);
+
+// Logger task entry: drains the rings and sends framed batches on UART0.
+void TelemetryTask(void* pvParameters);
+
+// UART0 interrupt handler, needed for uDMA completion only.
+void TelemetryUART0IntHandler(void);
+
+#endif // __TELEMETRY_H__
@@ -0,0 +1,124 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: tickless_idle.c
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Suppress ticks and sleep hook. See tickless_idle.h.
+ *
+ * The SysTick reprogramming follows vPortSuppressTicksAndSleep() of the
+ * FreeRTOS Cortex-M4F port. The differences: the idle time is clamped to
+ * the next sequencer release, interrupts are masked for the whole
+ * function, and the sequencer is stepped together with the kernel before
+ * the pending tick interrupt, if any, runs the tick hook.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_types.h"
+#include "inc/hw_nvic.h"
+#include "driverlib/cpu.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sequencer.h"
+#include "service_timing.h"
+#include "tickless_idle.h"
+
+#if configUSE_TICKLESS_IDLE == 2
+
+#if TIMING_USE_DWT == 1
+#error "The DWT cycle counter stops in sleep; tickless idle needs TIMING_USE_DWT 0"
+#endif
+
+#define TICKLESS_COUNTS_PER_TICK    (configCPU_CLOCK_HZ / configTICK_RATE_HZ)
+#define TICKLESS_MAX_TICKS          (0xFFFFFFUL / TICKLESS_COUNTS_PER_TICK)   // SysTick is 24 bits.
+#define TICKLESS_STOPPED_COUNTS     45      // SysTick counts lost while it is stopped, as in the port.
+
+volatile TicklessStats g_ticklessStats = {0};
+
+void TicklessSuppressTicksAndSleep(uint32_t expectedIdleTime) {
+    uint32_t reload, completeTicks, ctrl;
+    TickType_t toEvent;
+
+    CPUcpsid();
+
+    // Wake on the tick of the next sequencer release at the latest.
+    toEvent = SequencerTicksToNextEvent();
+    if (expectedIdleTime > toEvent) {
+        expectedIdleTime = toEvent;
+        g_ticklessStats.clamped++;
+    }
+    if (expectedIdleTime > TICKLESS_MAX_TICKS) {
+        expectedIdleTime = TICKLESS_MAX_TICKS;
+    }
+
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep) {
+        g_ticklessStats.aborted++;
+        CPUcpsie();
+        return;
+    }
+
+    g_ticklessStats.sleeps++;
+    if (expectedIdleTime < 2) {
+        // The next tick releases a service: sleep until it without touching SysTick.
+        CPUwfi();
+        CPUcpsie();
+        return;
+    }
+
+    // Stop SysTick and load it with the rest of this tick plus the whole idle ticks.
+    HWREG(NVIC_ST_CTRL) &= ~NVIC_ST_CTRL_ENABLE;
+    reload = HWREG(NVIC_ST_CURRENT) + TICKLESS_COUNTS_PER_TICK * (expectedIdleTime - 1);
+    if (reload > TICKLESS_STOPPED_COUNTS) {
+        reload -= TICKLESS_STOPPED_COUNTS;
+    }
+    HWREG(NVIC_ST_RELOAD) = reload;
+    HWREG(NVIC_ST_CURRENT) = 0;
+    HWREG(NVIC_ST_CTRL) |= NVIC_ST_CTRL_ENABLE;
+
+    // Either the programmed SysTick expiry or any other interrupt (UART1 for one) ends the sleep.
+    CPUwfi();
+
+    ctrl = HWREG(NVIC_ST_CTRL);
+    HWREG(NVIC_ST_CTRL) = ctrl & ~NVIC_ST_CTRL_ENABLE;
+
+    if (ctrl & NVIC_ST_CTRL_COUNT) {
+        // Slept the whole period. The pending SysTick interrupt completes the last tick; the
+        // next one comes after whatever is left of a tick period.
+        uint32_t load = (TICKLESS_COUNTS_PER_TICK - 1) - (reload - HWREG(NVIC_ST_CURRENT));
+        if (load < TICKLESS_STOPPED_COUNTS || load > TICKLESS_COUNTS_PER_TICK) {
+            load = TICKLESS_COUNTS_PER_TICK - 1;
+        }
+        HWREG(NVIC_ST_RELOAD) = load;
+        completeTicks = expectedIdleTime - 1;
+    } else {
+        // Woken early: count the whole ticks and finish the partial one.
+        uint32_t elapsed = expectedIdleTime * TICKLESS_COUNTS_PER_TICK - HWREG(NVIC_ST_CURRENT);
+        completeTicks = elapsed / TICKLESS_COUNTS_PER_TICK;
+        HWREG(NVIC_ST_RELOAD) = (completeTicks + 1) * TICKLESS_COUNTS_PER_TICK - elapsed;
+    }
+
+    // Restart SysTick; the period after this one is a normal tick again.
+    HWREG(NVIC_ST_CURRENT) = 0;
+    HWREG(NVIC_ST_CTRL) |= NVIC_ST_CTRL_ENABLE;
+    HWREG(NVIC_ST_RELOAD) = TICKLESS_COUNTS_PER_TICK - 1;
+
+    // Both counters move before the tick hook can see the pending tick.
+    SequencerSkipTicks(completeTicks);
+    vTaskStepTick(completeTicks);
+    g_ticklessStats.skipped += completeTicks;
+
+    CPUcpsie();
+}
+
+#endif
@@ -0,0 +1,59 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: tickless_idle.h
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Tickless idle that knows the sequencer schedule.
+ *
+ * The sequencer is driven by the FreeRTOS tick hook, so SysTick is the
+ * only periodic time base. The kernel only knows about task delays and
+ * timeouts, not about sequencer releases. The suppress ticks hook here
+ * therefore shortens every idle period to end on the kernel tick that
+ * releases the next service (or ends the run). It then reprograms SysTick
+ * for the whole period, sleeps with WFI and, on wake up, steps both the
+ * kernel and the sequencer over the ticks that never happened. The tick
+ * that releases a service is always a real SysTick interrupt, so releases
+ * run exactly as they do without tickless idle.
+ *
+ * The core uses sleep, not deep sleep. Deep sleep would change the clocks
+ * of UART1 and the PWM generators, and a STOP frame from the Jetson must
+ * still be received while the core sleeps. Sleep mode wakes in a few
+ * cycles. Any remaining error shows up in SequencerReleaseJitterUs(),
+ * the J column of the task set printed at the end of a run.
+ *
+ * The DWT cycle counter stops while the core sleeps, so tickless idle
+ * needs the WTIMER5 time base (TIMING_USE_DWT 0).
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#ifndef __TICKLESS_IDLE_H__
+#define __TICKLESS_IDLE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+typedef struct {
+    uint32_t sleeps;        // Times the core went to sleep.
+    uint32_t skipped;       // Kernel ticks slept through.
+    uint32_t clamped;       // Sleeps cut short by the next sequencer release.
+    uint32_t aborted;       // Sleeps given up because a task became ready.
+} TicklessStats;
+
+extern volatile TicklessStats g_ticklessStats;
+
+// portSUPPRESS_TICKS_AND_SLEEP() hook, see FreeRTOSConfig.h. Called by the idle task with the
+// scheduler suspended.
+void TicklessSuppressTicksAndSleep(uint32_t expectedIdleTime);
+
+#endif // __TICKLESS_IDLE_H__
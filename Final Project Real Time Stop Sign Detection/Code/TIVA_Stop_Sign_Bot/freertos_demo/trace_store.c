@@ -0,0 +1,78 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: trace_store.c
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Fixed capacity, overwrite-oldest trace of service timing samples.
+ * See trace_store.h.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "trace_store.h"
+
+#if (TRACE_STORE_DEPTH & (TRACE_STORE_DEPTH - 1)) != 0
+#error "TRACE_STORE_DEPTH must be a power of two"
+#endif
+
+#define TRACE_STORE_MASK    (TRACE_STORE_DEPTH - 1)
+
+static void TraceStatReset(TraceStat* stat) {
+    stat->min = 0xFFFFFFFFUL;
+    stat->max = 0;
+    stat->sum = 0;
+}
+
+static void TraceStatAdd(TraceStat* stat, uint32_t value) {
+    if (value < stat->min) {
+        stat->min = value;
+    }
+    if (value > stat->max) {
+        stat->max = value;
+    }
+    stat->sum += value;
+}
+
+void TraceStoreReset(TraceStore* store) {
+    store->count = 0;
+    TraceStatReset(&store->response);
+    TraceStatReset(&store->elapsed);
+    TraceStatReset(&store->execution);
+}
+
+void TraceStoreAdd(TraceStore* store, const TimingSample* sample) {
+    store->samples[store->count & TRACE_STORE_MASK] = *sample;
+    store->count++;
+
+    TraceStatAdd(&store->response, sample->response);
+    TraceStatAdd(&store->elapsed, sample->elapsed);
+    TraceStatAdd(&store->execution, sample->execution);
+}
+
+uint32_t TraceStoreRetained(const TraceStore* store) {
+    return (store->count < TRACE_STORE_DEPTH) ? store->count : TRACE_STORE_DEPTH;
+}
+
+const TimingSample* TraceStoreSample(const TraceStore* store, uint32_t i) {
+    uint32_t oldest = store->count - TraceStoreRetained(store);
+    return &store->samples[(oldest + i) & TRACE_STORE_MASK];
+}
+
+uint32_t TraceStatMean(const TraceStat* stat, uint32_t count) {
+    return (count == 0) ? 0 : (uint32_t)(stat->sum / count);
+}
+
+uint32_t TraceStatJitter(const TraceStat* stat, uint32_t count) {
+    return (count == 0) ? 0 : stat->max - stat->min;
+}
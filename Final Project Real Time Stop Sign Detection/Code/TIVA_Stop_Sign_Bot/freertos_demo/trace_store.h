@@ -0,0 +1,65 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: trace_store.h
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Fixed capacity trace of service timing samples. Each service owns one
+ * statically allocated TraceStore: the last TRACE_STORE_DEPTH samples are
+ * kept in a ring that overwrites the oldest entry, and running min / mean /
+ * max statistics cover every sample ever added, so WCET and jitter stay
+ * valid on runs of any length while memory use is fixed at link time.
+ *
+ * All values are in time base cycles (see service_timing.h). Adding a
+ * sample is O(1) and never allocates.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#ifndef __TRACE_STORE_H__
+#define __TRACE_STORE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "service_timing.h"
+
+// Samples retained per service. Must be a power of two.
+#define TRACE_STORE_DEPTH       32
+
+// Running statistics over every sample of one quantity.
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+} TraceStat;
+
+typedef struct {
+    TimingSample samples[TRACE_STORE_DEPTH];    // Ring of the most recent samples.
+    uint32_t count;                             // Samples added since the last reset.
+    TraceStat response;
+    TraceStat elapsed;
+    TraceStat execution;
+} TraceStore;
+
+void TraceStoreReset(TraceStore* store);
+void TraceStoreAdd(TraceStore* store, const TimingSample* sample);
+
+// Number of samples currently retained (at most TRACE_STORE_DEPTH).
+uint32_t TraceStoreRetained(const TraceStore* store);
+
+// Retained sample i, 0 being the oldest still in the ring.
+const TimingSample* TraceStoreSample(const TraceStore* store, uint32_t i);
+
+// Mean and jitter (max - min) of a statistic of a store with count samples.
+uint32_t TraceStatMean(const TraceStat* stat, uint32_t count);
+uint32_t TraceStatJitter(const TraceStat* stat, uint32_t count);
+
+#endif // __TRACE_STORE_H__
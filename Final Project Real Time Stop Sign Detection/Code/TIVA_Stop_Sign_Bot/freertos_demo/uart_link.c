@@ -0,0 +1,376 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: uart_link.c
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Lock-free receive ring and CRC-checked frame parser for the Jetson link.
+ * See uart_link.h for the frame layout.
+ *
+ * The ring has exactly one producer (the UART1 ISR, which only advances
+ * s_rxHead) and one consumer (the task calling UARTLinkReceive, which only
+ * advances s_rxTail). Both indices run freely and are masked on access, so
+ * no critical section is needed on either side.
+ *
+ * The fast path parser belongs to the ISR alone and is marked as a shadow,
+ * so link statistics count every frame once, on the task side.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_types.h"      // Hardware specific type definitions.
+#include "inc/hw_uart.h"       // UART register bit definitions (receive error flags).
+#include "driverlib/interrupt.h" // Include for masking interrupts around the transmit ring.
+#include "driverlib/uart.h"    // Include for UART communication utilities.
+#include "uart_link.h"
+
+#if (UART_LINK_RX_RING_SIZE & (UART_LINK_RX_RING_SIZE - 1)) != 0
+#error "UART_LINK_RX_RING_SIZE must be a power of two"
+#endif
+#if (UART_LINK_TX_RING_SIZE & (UART_LINK_TX_RING_SIZE - 1)) != 0
+#error "UART_LINK_TX_RING_SIZE must be a power of two"
+#endif
+
+#define RX_RING_MASK    (UART_LINK_RX_RING_SIZE - 1)
+#define TX_RING_MASK    (UART_LINK_TX_RING_SIZE - 1)
+
+// Receive error flags returned in the upper bits of the UART data register.
+#define RX_ERROR_FLAGS  (UART_DR_OE | UART_DR_BE | UART_DR_PE | UART_DR_FE)
+
+// Parser states.
+enum {
+    PARSE_HUNT = 0,     // Waiting for SOF.
+    PARSE_SEQ,          // Expecting the sequence number.
+    PARSE_LEN,          // Expecting the payload length.
+    PARSE_PAYLOAD,      // Collecting payload bytes.
+    PARSE_CRC_HI,       // Expecting the CRC high byte.
+    PARSE_CRC_LO        // Expecting the CRC low byte.
+};
+
+// Link health counters.
+volatile UARTLinkStats g_uartLinkStats = {0};
+
+// Receive ring shared between the UART1 ISR and the consuming task.
+static uint8_t s_rxRing[UART_LINK_RX_RING_SIZE];
+static volatile uint32_t s_rxHead = 0;     // Written by the ISR only.
+static volatile uint32_t s_rxTail = 0;     // Written by the consumer only.
+
+// Parser and sequence tracking owned by the consuming task.
+static UARTLinkParser s_rxParser = { PARSE_HUNT };
+static bool s_haveSeq = false;
+static uint8_t s_lastSeq = 0;
+
+// Fast path: a second parser on the same bytes, owned by the receive ISR.
+static UARTLinkParser s_fastParser = { PARSE_HUNT };
+static UARTLinkFastHandler s_fastHandler = 0;
+
+// Transmit ring, filled by any task and drained into the UART FIFO by TxPump().
+// Both ends only run with interrupts masked or from the UART interrupt itself.
+static uint8_t s_txRing[UART_LINK_TX_RING_SIZE];
+static uint32_t s_txHead = 0;
+static uint32_t s_txTail = 0;
+static uint32_t s_txBase = 0;
+static uint8_t s_txSeq = 0;
+
+// Nibble lookup table for CRC-16/CCITT-FALSE (poly 0x1021).
+static const uint16_t s_crcNibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+static uint16_t Crc16Byte(uint16_t crc, uint8_t byte) {
+    crc = (uint16_t)((crc << 4) ^ s_crcNibble[(crc >> 12) ^ (byte >> 4)]);
+    crc = (uint16_t)((crc << 4) ^ s_crcNibble[(crc >> 12) ^ (byte & 0x0F)]);
+    return crc;
+}
+
+uint16_t UARTLinkCrc16(uint16_t crc, const uint8_t* data, uint32_t len) {
+    while (len--) {
+        crc = Crc16Byte(crc, *data++);
+    }
+    return crc;
+}
+
+/**
+ * Drains the UART hardware FIFO into the receive ring. Called from the UART
+ * receive and receive-timeout interrupts, so a burst is moved out of the
+ * FIFO in one pass instead of one interrupt per byte. With a fast path
+ * handler, each stored byte is parsed here too and a completed frame is
+ * handed to the handler before the next byte is read.
+ */
+void UARTLinkRxFromISR(uint32_t uartBase) {
+    UARTLinkFrame fastFrame;
+
+    while (UARTCharsAvail(uartBase)) {
+        int32_t data = UARTCharGetNonBlocking(uartBase);
+        uint32_t head = s_rxHead;
+
+        g_uartLinkStats.rxBytes++;
+        if (data & RX_ERROR_FLAGS) {
+            // Keep the byte; the CRC check rejects the frame it belongs to.
+            g_uartLinkStats.hwErrors++;
+        }
+
+        if ((head - s_rxTail) >= UART_LINK_RX_RING_SIZE) {
+            g_uartLinkStats.ringOverflows++;
+            continue;
+        }
+
+        s_rxRing[head & RX_RING_MASK] = (uint8_t)data;
+        s_rxHead = head + 1;  // Publish the byte only after it is stored.
+
+        // Only bytes that made it into the ring, so both parsers decode the same frames.
+        if (s_fastHandler && UARTLinkParseByte(&s_fastParser, (uint8_t)data, &fastFrame)) {
+            s_fastHandler(&fastFrame);
+        }
+    }
+}
+
+/**
+ * Pops buffered bytes through the link parser.
+ * Returns true with *frame filled in as soon as one valid frame is decoded;
+ * call again to continue with the remaining bytes.
+ */
+bool UARTLinkReceive(UARTLinkFrame* frame) {
+    while (s_rxTail != s_rxHead) {
+        uint8_t byte = s_rxRing[s_rxTail & RX_RING_MASK];
+        s_rxTail++;
+
+        if (UARTLinkParseByte(&s_rxParser, byte, frame)) {
+            if (s_haveSeq) {
+                uint8_t delta = (uint8_t)(frame->seq - (uint8_t)(s_lastSeq + 1));
+                // A jump forward is frames lost; a jump back is a duplicate, a reordered frame or a
+                // restarted sender, after which the count continues from the new sequence number.
+                if (delta < 128) {
+                    g_uartLinkStats.seqGaps += delta;
+                } else {
+                    g_uartLinkStats.seqResyncs++;
+                }
+            }
+            s_lastSeq = frame->seq;
+            s_haveSeq = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+void UARTLinkSetFastHandler(UARTLinkFastHandler handler) {
+    UARTLinkParserReset(&s_fastParser);
+    s_fastParser.shadow = true;
+    s_fastHandler = handler;
+}
+
+void UARTLinkParserReset(UARTLinkParser* parser) {
+    parser->state = PARSE_HUNT;
+    parser->escaped = false;
+    parser->index = 0;
+    parser->crc = UART_LINK_CRC_INIT;
+}
+
+/**
+ * Feeds one raw wire byte into the parser.
+ * Returns true when the byte completes a frame whose CRC matches.
+ */
+bool UARTLinkParseByte(UARTLinkParser* parser, uint8_t byte, UARTLinkFrame* frame) {
+    if (byte == UART_LINK_SOF) {
+        // A SOF always starts a new frame; one in mid-frame means truncation.
+        if (parser->state != PARSE_HUNT && !parser->shadow) {
+            g_uartLinkStats.lengthErrors++;
+        }
+        UARTLinkParserReset(parser);
+        parser->state = PARSE_SEQ;
+        return false;
+    }
+
+    if (parser->state == PARSE_HUNT) {
+        return false;
+    }
+
+    if (byte == UART_LINK_ESC) {
+        parser->escaped = true;
+        return false;
+    }
+    if (parser->escaped) {
+        byte ^= UART_LINK_ESC_XOR;
+        parser->escaped = false;
+    }
+
+    switch (parser->state) {
+        case PARSE_SEQ:
+            parser->frame.seq = byte;
+            parser->crc = Crc16Byte(parser->crc, byte);
+            parser->state = PARSE_LEN;
+            break;
+
+        case PARSE_LEN:
+            if (byte > UART_LINK_MAX_PAYLOAD) {
+                if (!parser->shadow) {
+                    g_uartLinkStats.lengthErrors++;
+                }
+                parser->state = PARSE_HUNT;
+                break;
+            }
+            parser->frame.len = byte;
+            parser->crc = Crc16Byte(parser->crc, byte);
+            parser->index = 0;
+            parser->state = (byte > 0) ? PARSE_PAYLOAD : PARSE_CRC_HI;
+            break;
+
+        case PARSE_PAYLOAD:
+            parser->frame.payload[parser->index++] = byte;
+            parser->crc = Crc16Byte(parser->crc, byte);
+            if (parser->index == parser->frame.len) {
+                parser->state = PARSE_CRC_HI;
+            }
+            break;
+
+        case PARSE_CRC_HI:
+            parser->crcHigh = byte;
+            parser->state = PARSE_CRC_LO;
+            break;
+
+        case PARSE_CRC_LO:
+            parser->state = PARSE_HUNT;
+            if ((uint16_t)((parser->crcHigh << 8) | byte) == parser->crc) {
+                if (!parser->shadow) {
+                    g_uartLinkStats.framesOk++;
+                }
+                *frame = parser->frame;
+                return true;
+            }
+            if (!parser->shadow) {
+                g_uartLinkStats.crcErrors++;
+            }
+            break;
+
+        default:
+            parser->state = PARSE_HUNT;
+            break;
+    }
+    return false;
+}
+
+uint32_t UARTLinkGet32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void UARTLinkPut32(uint8_t* p, uint32_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+/**
+ * Moves queued bytes into the hardware FIFO until either runs out. The TX
+ * interrupt stays enabled only while bytes are left in the ring.
+ */
+static void TxPump(void) {
+    while (s_txTail != s_txHead && UARTSpaceAvail(s_txBase)) {
+        UARTCharPutNonBlocking(s_txBase, s_txRing[s_txTail & TX_RING_MASK]);
+        s_txTail++;
+    }
+    if (s_txTail != s_txHead) {
+        UARTIntEnable(s_txBase, UART_INT_TX);
+    } else {
+        UARTIntDisable(s_txBase, UART_INT_TX);
+    }
+}
+
+void UARTLinkTxInit(uint32_t uartBase) {
+    s_txBase = uartBase;
+    s_txHead = 0;
+    s_txTail = 0;
+    // Interrupt when the FIFO drains to its trigger level rather than only at the end of transmission.
+    UARTTxIntModeSet(uartBase, UART_TXINT_MODE_FIFO);
+}
+
+/**
+ * Frames payload with the next transmit sequence number and queues it.
+ * Returns false, counting the frame in txDropped, if the ring has no room
+ * for it; frames are only ever queued whole. Interrupts are masked while
+ * the frame is encoded and copied, a few microseconds for the largest one.
+ */
+bool UARTLinkSend(const uint8_t* payload, uint8_t len) {
+    uint8_t frame[UART_LINK_MAX_FRAME];
+    bool queued = false;
+    bool masked = IntMasterDisable();
+    uint32_t n = UARTLinkEncode(s_txSeq, payload, len, frame);
+    uint32_t i;
+
+    if (n > 0 && s_txBase != 0 && (UART_LINK_TX_RING_SIZE - (s_txHead - s_txTail)) >= n) {
+        for (i = 0; i < n; i++) {
+            s_txRing[(s_txHead + i) & TX_RING_MASK] = frame[i];
+        }
+        s_txHead += n;
+        s_txSeq++;
+        g_uartLinkStats.txFrames++;
+        queued = true;
+        TxPump();
+    } else {
+        g_uartLinkStats.txDropped++;
+    }
+
+    if (!masked) {
+        IntMasterEnable();
+    }
+    return queued;
+}
+
+/**
+ * Refills the hardware FIFO. Called from the transmit UART's interrupt.
+ */
+void UARTLinkTxFromISR(void) {
+    TxPump();
+}
+
+static uint32_t StuffByte(uint8_t byte, uint8_t* out) {
+    if (byte == UART_LINK_SOF || byte == UART_LINK_ESC) {
+        out[0] = UART_LINK_ESC;
+        out[1] = byte ^ UART_LINK_ESC_XOR;
+        return 2;
+    }
+    out[0] = byte;
+    return 1;
+}
+
+/**
+ * Encodes seq/payload into a stuffed wire frame. out must hold at least
+ * UART_LINK_MAX_FRAME bytes.
+ */
+uint32_t UARTLinkEncode(uint8_t seq, const uint8_t* payload, uint8_t len, uint8_t* out) {
+    uint32_t n = 0;
+    uint16_t crc = UART_LINK_CRC_INIT;
+    uint8_t i;
+
+    if (len > UART_LINK_MAX_PAYLOAD) {
+        return 0;
+    }
+
+    out[n++] = UART_LINK_SOF;
+
+    crc = Crc16Byte(crc, seq);
+    n += StuffByte(seq, &out[n]);
+    crc = Crc16Byte(crc, len);
+    n += StuffByte(len, &out[n]);
+
+    for (i = 0; i < len; i++) {
+        crc = Crc16Byte(crc, payload[i]);
+        n += StuffByte(payload[i], &out[n]);
+    }
+
+    n += StuffByte((uint8_t)(crc >> 8), &out[n]);
+    n += StuffByte((uint8_t)(crc & 0xFF), &out[n]);
+    return n;
+}
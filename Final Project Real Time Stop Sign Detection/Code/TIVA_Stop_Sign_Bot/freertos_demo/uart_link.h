@@ -0,0 +1,155 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: uart_link.h
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Receive path and framing layer for the Jetson -> TIVA UART link.
+ *
+ * Bytes are moved out of the UART1 hardware FIFO by the receive ISR into a
+ * lock-free single-producer/single-consumer ring buffer. The consuming task
+ * drains the ring and runs the frame parser, so no byte is lost between two
+ * service releases.
+ *
+ * Frame layout on the wire (HDLC style byte stuffing, CRC-16/CCITT-FALSE):
+ *
+ *   [SOF 0x7E] [SEQ] [LEN] [PAYLOAD 0 .. LEN-1] [CRC16 hi] [CRC16 lo]
+ *
+ * The CRC covers SEQ, LEN and PAYLOAD. Every byte after SOF that equals 0x7E
+ * or 0x7D is sent as 0x7D followed by the byte XOR 0x20, so a SOF can only
+ * ever start a frame and the parser resynchronises on the next one after
+ * any corruption.
+ *
+ * The same framing runs back to the Jetson on UART2 TX, carrying clock sync
+ * replies and actuation acknowledgements. Frames are queued in a transmit
+ * ring that the UART2 interrupt feeds into the hardware FIFO, so a service
+ * never waits for the wire. Multi-byte payload fields are little endian;
+ * times are microseconds, on the Jetson's clock for fields the Jetson sent
+ * and on TimingNowUs() for the TIVA's own.
+ *
+ * Urgent frames need not wait for the consuming task. With a fast path
+ * handler installed, the receive ISR also runs every byte through a second
+ * (shadow) parser and hands each valid frame to the handler right away.
+ * The task still receives every frame through the ring as before.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#ifndef __UART_LINK_H__
+#define __UART_LINK_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Framing constants shared with camera-bit.py.
+#define UART_LINK_SOF               0x7E    // Start of frame flag.
+#define UART_LINK_ESC               0x7D    // Escape marker for stuffed bytes.
+#define UART_LINK_ESC_XOR           0x20    // Value XORed into an escaped byte.
+#define UART_LINK_MAX_PAYLOAD       16      // Largest payload accepted, in bytes.
+#define UART_LINK_CRC_INIT          0xFFFF  // CRC-16/CCITT-FALSE initial value.
+
+// Worst case encoded frame size: SOF plus every other byte stuffed.
+#define UART_LINK_MAX_FRAME         (1 + 2 * (2 + UART_LINK_MAX_PAYLOAD + 2))
+
+// Size of the ISR -> task receive ring. Must be a power of two.
+#define UART_LINK_RX_RING_SIZE      256
+
+// Size of the task -> ISR transmit ring. Must be a power of two.
+#define UART_LINK_TX_RING_SIZE      256
+
+// Payload message types (payload[0]), Jetson -> TIVA.
+#define UART_LINK_MSG_DETECTION     0x01    // [1] detection state, [2..5] frame capture time (optional).
+#define UART_LINK_MSG_SYNC_REQUEST  0x02    // [1] request id, [2..5] Jetson send time.
+#define UART_LINK_MSG_SERVICE_REQUEST 0x03  // [1] service, [2] 1 = enable, 0 = disable.
+
+// Payload message types, TIVA -> Jetson.
+#define UART_LINK_MSG_ACTUATION     0x81    // [1] link seq, [2] state, [3] service, [4..7] capture time,
+                                            // [8..11] TIVA receive time, [12..15] TIVA actuation time.
+#define UART_LINK_MSG_SYNC_REPLY    0x82    // [1] request id, [2..5] Jetson send time (echoed),
+                                            // [6..9] TIVA receive time, [10..13] TIVA reply time.
+#define UART_LINK_MSG_SERVICE_REPLY 0x83    // [1] service, [2] enable, [3] AdmissionResult, [4] culprit,
+                                            // [5..8] response time bound in us.
+
+// Service field of an actuation carried out by the receive ISR fast path.
+#define UART_LINK_SERVICE_FAST_PATH 0xFF
+
+// Detection states carried by UART_LINK_MSG_DETECTION.
+#define DETECTION_STOP              0xAA    // Stop sign in view.
+#define DETECTION_CLEAR             0x00    // Path clear.
+
+// A decoded, CRC-checked frame.
+typedef struct {
+    uint8_t seq;                                // Sender sequence number.
+    uint8_t len;                                // Number of valid payload bytes.
+    uint8_t payload[UART_LINK_MAX_PAYLOAD];     // Message body.
+} UARTLinkFrame;
+
+// Byte-at-a-time frame parser. One instance per consumer.
+typedef struct {
+    uint8_t state;          // Current parser state.
+    bool escaped;           // Previous byte was UART_LINK_ESC.
+    uint8_t index;          // Payload bytes collected so far.
+    uint8_t crcHigh;        // First received CRC byte.
+    uint16_t crc;           // Running CRC over SEQ, LEN and PAYLOAD.
+    bool shadow;            // Sees bytes another parser counts; stays out of g_uartLinkStats.
+    UARTLinkFrame frame;    // Frame under construction.
+} UARTLinkParser;
+
+// Fast path handler, called from the receive ISR for every valid frame. Must be short and
+// must not call the FreeRTOS API: the UART ISR runs above configMAX_SYSCALL_INTERRUPT_PRIORITY.
+typedef void (*UARTLinkFastHandler)(const UARTLinkFrame* frame);
+
+// Link health counters, readable at any time.
+typedef struct {
+    uint32_t rxBytes;       // Bytes taken out of the hardware FIFO.
+    uint32_t ringOverflows; // Bytes dropped because the ring was full.
+    uint32_t hwErrors;      // Overrun, break, parity or framing errors.
+    uint32_t framesOk;      // Frames that passed the CRC check.
+    uint32_t crcErrors;     // Frames dropped on a CRC mismatch.
+    uint32_t lengthErrors;  // Frames dropped on a bad LEN or truncated by SOF.
+    uint32_t seqGaps;       // Frames missing according to the sequence number.
+    uint32_t seqResyncs;    // Duplicated or reordered frames and sender restarts (sequence number went back).
+    uint32_t txFrames;      // Frames queued for transmission.
+    uint32_t txDropped;     // Frames dropped because the transmit ring was full.
+} UARTLinkStats;
+
+extern volatile UARTLinkStats g_uartLinkStats;
+
+// ISR side: drain the UART hardware FIFO into the receive ring.
+void UARTLinkRxFromISR(uint32_t uartBase);
+
+// Installs (or with NULL removes) the fast path handler. Call before enabling the UART interrupt.
+void UARTLinkSetFastHandler(UARTLinkFastHandler handler);
+
+// Task side: pop buffered bytes and return true once a valid frame is decoded.
+bool UARTLinkReceive(UARTLinkFrame* frame);
+
+// Parser primitives, usable from any context that owns the parser instance.
+void UARTLinkParserReset(UARTLinkParser* parser);
+bool UARTLinkParseByte(UARTLinkParser* parser, uint8_t byte, UARTLinkFrame* frame);
+
+// Transmit side: UARTLinkTxInit() once with the UART FIFO enabled, then
+// UARTLinkSend() from any task and UARTLinkTxFromISR() from the UART interrupt.
+void UARTLinkTxInit(uint32_t uartBase);
+bool UARTLinkSend(const uint8_t* payload, uint8_t len);
+void UARTLinkTxFromISR(void);
+
+// Little endian payload fields.
+uint32_t UARTLinkGet32(const uint8_t* p);
+void UARTLinkPut32(uint8_t* p, uint32_t value);
+
+// Encode a payload into a complete wire frame. Returns the encoded length.
+uint32_t UARTLinkEncode(uint8_t seq, const uint8_t* payload, uint8_t len, uint8_t* out);
+
+// CRC-16/CCITT-FALSE (poly 0x1021), continued from crc.
+uint16_t UARTLinkCrc16(uint16_t crc, const uint8_t* data, uint32_t len);
+
+#endif // __UART_LINK_H__
@@ -0,0 +1,58 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: FreeRTOSConfig.h
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Kernel configuration of the host build: the firmware configuration,
+ * with the settings the FreeRTOS POSIX port cannot take overridden. Found
+ * ahead of freertos_demo/FreeRTOSConfig.h by the kernel headers; the
+ * firmware's own include of it then hits the include guard.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#ifndef HOST_SIM_FREERTOS_CONFIG_H
+#define HOST_SIM_FREERTOS_CONFIG_H
+
+#include "../freertos_demo/FreeRTOSConfig.h"
+
+/* Every task is a POSIX thread, which needs far more stack than the
+ * firmware gives its tasks. The kernel's own tasks get this much, and
+ * HostSimTaskCreate() raises every firmware task to it. 8192 words are
+ * 64 KB with the port's 8 byte stack type. */
+#undef configMINIMAL_STACK_SIZE
+#define configMINIMAL_STACK_SIZE            ( ( unsigned short ) 8192 )
+
+/* Thread stacks come from the heap (heap_3, i.e. malloc), so there is no
+ * static allocation mode. */
+#undef configSUPPORT_STATIC_ALLOCATION
+#undef configSUPPORT_DYNAMIC_ALLOCATION
+#undef configTOTAL_HEAP_SIZE
+#define configSUPPORT_STATIC_ALLOCATION     0
+#define configSUPPORT_DYNAMIC_ALLOCATION    1
+#define configTOTAL_HEAP_SIZE               ( ( size_t ) ( 1024 * 1024 ) )
+
+/* Ticks come from a host timer and cannot be suppressed. */
+#undef configUSE_TICKLESS_IDLE
+#undef portSUPPRESS_TICKS_AND_SLEEP
+#define configUSE_TICKLESS_IDLE             0
+
+/* The thread stacks are guarded by the host; the firmware hook also has
+ * the pre V10 signature. */
+#undef configCHECK_FOR_STACK_OVERFLOW
+#define configCHECK_FOR_STACK_OVERFLOW      0
+
+/* A broken kernel invariant stops the simulation with its location. */
+extern void HostSimAssert(const char* file, unsigned long line);
+#define configASSERT( x )                   if( ( x ) == 0 ) HostSimAssert( __FILE__, __LINE__ )
+
+#endif /* HOST_SIM_FREERTOS_CONFIG_H */
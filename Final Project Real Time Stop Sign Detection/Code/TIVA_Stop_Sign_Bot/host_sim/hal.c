@@ -0,0 +1,666 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: hal.c
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Host implementation of the TivaWare calls used by the firmware. See
+ * hal.h for what is modelled.
+ *
+ * Under the FreeRTOS POSIX port only one task thread runs at a time and
+ * the tick handler runs with the tick signal blocked, so the device state
+ * here needs no locking beyond what the firmware already does with
+ * IntMasterDisable().
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "inc/hw_types.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_timer.h"
+#include "inc/hw_uart.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/pwm.h"
+#include "driverlib/timer.h"
+#include "driverlib/uart.h"
+#include "utils/uartstdio.h"
+#include "utils/ustdlib.h"
+#include "hal.h"
+
+#define HAL_REGISTERS           512     // Register file slots, a power of two.
+#define HAL_PRINTF_BYTES        256     // Longest UARTprintf() line.
+
+typedef struct {
+    uint32_t addr;
+    bool used;
+    volatile uint32_t value;
+} HalReg;
+
+typedef struct {
+    uint32_t base;
+    uint32_t config;            // TimerConfigure() value; Timer A only.
+    uint32_t load;
+    uint32_t prescale;
+    bool enabled;
+    uint32_t intMask;
+    uint32_t intStatus;
+    void (*handler)(void);
+    uint64_t startCycles;       // Time base at TimerEnable().
+    int64_t remaining;          // Cycles to the next timeout.
+} HalTimer;
+
+typedef struct {
+    uint32_t base;
+    uint32_t baud;
+    bool fifo;                  // FIFOs enabled; a one byte holding register otherwise.
+    uint32_t rxLevel;           // Receive interrupt at this many bytes, with the FIFO enabled.
+    uint32_t txLevel;           // Transmit interrupt at this many bytes or fewer.
+    uint32_t intMask;
+    uint32_t intStatus;
+    void (*handler)(void);
+    uint32_t rx[HAL_UART_FIFO_BYTES];   // Data register values: byte and error flags.
+    uint32_t rxHead, rxCount;
+    bool rxOverrun;             // Flag the next byte read with UART_DR_OE.
+    uint8_t tx[HAL_UART_FIFO_BYTES];
+    uint32_t txHead, txCount;
+    uint32_t txCredit;          // Bit times available on the wire this tick, times 1000.
+} HalUart;
+
+typedef struct {
+    uint32_t base;
+    uint8_t data;
+} HalPort;
+
+// FIFO trigger levels in bytes, indexed by UART_FIFO_TXn_8 and by UART_FIFO_RXn_8 >> 3.
+static const uint32_t s_fifoLevels[] = { 2, 4, 8, 12, 14 };
+
+static HalReg s_registers[HAL_REGISTERS];
+static HalTimer s_timers[] = {
+    { TIMER0_BASE }, { TIMER1_BASE }, { TIMER2_BASE }, { TIMER3_BASE }, { TIMER4_BASE }, { TIMER5_BASE },
+    { WTIMER0_BASE }, { WTIMER1_BASE }, { WTIMER2_BASE }, { WTIMER3_BASE }, { WTIMER4_BASE }, { WTIMER5_BASE },
+};
+static HalUart s_uarts[] = { { UART0_BASE }, { UART1_BASE }, { UART2_BASE } };
+static HalPort s_ports[] = {
+    { GPIO_PORTA_BASE }, { GPIO_PORTB_BASE }, { GPIO_PORTC_BASE },
+    { GPIO_PORTD_BASE }, { GPIO_PORTE_BASE }, { GPIO_PORTF_BASE },
+};
+
+static bool s_wallClock = false;
+static uint32_t s_readStep = 0;
+static HalSink s_sink = NULL;
+static struct timespec s_wallStart;
+
+static uint64_t s_tickCycles = 0;       // Virtual time base at the start of the current tick.
+static uint64_t s_readCycles = 0;       // Virtual time added by reads since then.
+
+static volatile bool s_inISR = false;
+static volatile bool s_masked = false;
+
+#define TABLE_SIZE(t)   (sizeof(t) / sizeof((t)[0]))
+
+static HalTimer* FindTimer(uint32_t base) {
+    uint32_t i;
+
+    for (i = 0; i < TABLE_SIZE(s_timers); i++) {
+        if (s_timers[i].base == base) {
+            return &s_timers[i];
+        }
+    }
+    return NULL;
+}
+
+static HalUart* FindUart(uint32_t base) {
+    uint32_t i;
+
+    for (i = 0; i < TABLE_SIZE(s_uarts); i++) {
+        if (s_uarts[i].base == base) {
+            return &s_uarts[i];
+        }
+    }
+    return NULL;
+}
+
+static HalPort* FindPort(uint32_t base) {
+    uint32_t i;
+
+    for (i = 0; i < TABLE_SIZE(s_ports); i++) {
+        if (s_ports[i].base == base) {
+            return &s_ports[i];
+        }
+    }
+    return NULL;
+}
+
+static void Emit(uint32_t uartBase, const uint8_t* data, uint32_t len) {
+    if (s_sink != NULL && len > 0) {
+        s_sink(uartBase, data, len);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+///////////////////      Time base and registers     /////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+void HalInit(bool wallClock, uint32_t readStep, HalSink sink) {
+    s_wallClock = wallClock;
+    s_readStep = readStep;
+    s_sink = sink;
+    clock_gettime(CLOCK_MONOTONIC, &s_wallStart);
+}
+
+uint64_t HalCycles(void) {
+    if (s_wallClock) {
+        struct timespec now;
+        int64_t ns;
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        ns = (int64_t)(now.tv_sec - s_wallStart.tv_sec) * 1000000000LL + (now.tv_nsec - s_wallStart.tv_nsec);
+        return (uint64_t)ns * (configCPU_CLOCK_HZ / 1000000) / 1000;
+    }
+
+    // Never past the end of the tick, so time stamps stay ordered with the tick count.
+    if (s_readCycles + s_readStep < HAL_CYCLES_PER_TICK) {
+        s_readCycles += s_readStep;
+    }
+    return s_tickCycles + s_readCycles;
+}
+
+// Timer A value register as the firmware reads it.
+static uint32_t TimerValue(const HalTimer* timer) {
+    uint64_t counts;
+
+    if (!timer->enabled) {
+        return timer->load;
+    }
+    counts = HalCycles() - timer->startCycles;
+    if (timer->config & TIMER_TAMR_TACDIR) {
+        // Counting up: in up count mode the prescaler extends the counter, it does not divide.
+        return (uint32_t)counts;
+    }
+    counts /= (uint64_t)timer->prescale + 1;
+    return timer->load - (uint32_t)(counts % ((uint64_t)timer->load + 1));
+}
+
+volatile uint32_t* HalRegister(uint32_t addr) {
+    uint32_t offset = addr & 0xFFF;
+    uint32_t slot = ((addr >> 2) * 2654435761U) & (HAL_REGISTERS - 1);
+    uint32_t probes;
+
+    for (probes = 0; probes < HAL_REGISTERS; probes++) {
+        HalReg* reg = &s_registers[slot];
+
+        if (!reg->used) {
+            reg->used = true;
+            reg->addr = addr;
+            reg->value = 0;
+        }
+        if (reg->addr == addr) {
+            if (offset == TIMER_O_TAR || offset == TIMER_O_TAV) {
+                const HalTimer* timer = FindTimer(addr & ~0xFFFU);
+                if (timer != NULL) {
+                    reg->value = TimerValue(timer);
+                }
+            }
+            return &reg->value;
+        }
+        slot = (slot + 1) & (HAL_REGISTERS - 1);
+    }
+
+    fprintf(stderr, "host_sim: register file full at 0x%08X\n", addr);
+    abort();
+}
+
+//////////////////////////////////////////////////////////////////////////
+///////////////////    Interrupt context and ticks   /////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+void HalEnterISR(void) {
+    s_inISR = true;
+}
+
+void HalExitISR(void) {
+    s_inISR = false;
+}
+
+bool IntMasterDisable(void) {
+    bool wasMasked = s_masked || s_inISR;
+
+    if (!s_inISR) {
+        portDISABLE_INTERRUPTS();
+        s_masked = true;
+    }
+    return wasMasked;
+}
+
+bool IntMasterEnable(void) {
+    bool wasMasked = s_masked || s_inISR;
+
+    if (!s_inISR) {
+        s_masked = false;
+        portENABLE_INTERRUPTS();
+    }
+    return wasMasked;
+}
+
+static void UartService(HalUart* uart) {
+    if ((uart->intStatus & uart->intMask) != 0 && uart->handler != NULL) {
+        uart->handler();
+    }
+}
+
+// Moves one tick worth of bytes onto the wire. The TX interrupt is raised as soon as the FIFO
+// falls to its trigger level, so a refill keeps the line busy within the same tick.
+static void UartTransmit(HalUart* uart) {
+    uart->txCredit += uart->baud * 1000 / configTICK_RATE_HZ;
+
+    while (uart->txCount > 0 && uart->txCredit >= HAL_UART_BIT_TIMES * 1000) {
+        uint8_t byte = uart->tx[uart->txHead];
+
+        uart->txHead = (uart->txHead + 1) % HAL_UART_FIFO_BYTES;
+        uart->txCount--;
+        uart->txCredit -= HAL_UART_BIT_TIMES * 1000;
+        Emit(uart->base, &byte, 1);
+
+        if (uart->txCount <= uart->txLevel) {
+            uart->intStatus |= UART_INT_TX;
+            UartService(uart);
+        }
+    }
+
+    // An idle line does not bank bit times for later.
+    if (uart->txCount == 0 && uart->txCredit > HAL_UART_BIT_TIMES * 1000) {
+        uart->txCredit = HAL_UART_BIT_TIMES * 1000;
+    }
+}
+
+void HalTick(TickType_t tick) {
+    uint32_t i;
+
+    s_tickCycles = (uint64_t)tick * HAL_CYCLES_PER_TICK;
+    s_readCycles = 0;
+
+    for (i = 0; i < TABLE_SIZE(s_timers); i++) {
+        HalTimer* timer = &s_timers[i];
+
+        if (!timer->enabled || timer->handler == NULL || (timer->intMask & TIMER_TIMA_TIMEOUT) == 0) {
+            continue;
+        }
+        timer->remaining -= HAL_CYCLES_PER_TICK;
+        while (timer->enabled && timer->remaining <= 0) {
+            if ((timer->config & TIMER_TAMR_TAMR_M) == TIMER_TAMR_TAMR_PERIOD) {
+                timer->remaining += (int64_t)timer->load + 1;
+            } else {
+                timer->enabled = false;
+            }
+            timer->intStatus |= TIMER_TIMA_TIMEOUT;
+            timer->handler();
+        }
+    }
+
+    for (i = 0; i < TABLE_SIZE(s_uarts); i++) {
+        UartTransmit(&s_uarts[i]);
+    }
+}
+
+void HalUartReceive(uint32_t uartBase, uint8_t byte) {
+    HalUart* uart = FindUart(uartBase);
+    uint32_t depth;
+
+    if (uart == NULL) {
+        return;
+    }
+
+    depth = uart->fifo ? HAL_UART_FIFO_BYTES : 1;
+    if (uart->rxCount >= depth) {
+        // Overrun: the byte is lost and the next one read carries the error flag.
+        uart->rxOverrun = true;
+    } else {
+        uint32_t data = byte;
+
+        if (uart->rxOverrun) {
+            data |= UART_DR_OE;
+            uart->rxOverrun = false;
+        }
+        uart->rx[(uart->rxHead + uart->rxCount) % HAL_UART_FIFO_BYTES] = data;
+        uart->rxCount++;
+    }
+
+    if (!uart->fifo || uart->rxCount >= uart->rxLevel) {
+        uart->intStatus |= UART_INT_RX;
+    }
+    UartService(uart);
+}
+
+void HalUartRxIdle(uint32_t uartBase) {
+    HalUart* uart = FindUart(uartBase);
+
+    if (uart != NULL && uart->rxCount > 0) {
+        uart->intStatus |= UART_INT_RT;
+        UartService(uart);
+    }
+}
+
+uint32_t HalUartBaud(uint32_t uartBase) {
+    HalUart* uart = FindUart(uartBase);
+
+    return (uart != NULL) ? uart->baud : 0;
+}
+
+uint8_t HalGpioData(uint32_t portBase) {
+    HalPort* port = FindPort(portBase);
+
+    return (port != NULL) ? port->data : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+///////////////////        driverlib: system         /////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+uint32_t SysCtlClockGet(void) {
+    return configCPU_CLOCK_HZ;
+}
+
+void SysCtlClockSet(uint32_t ui32Config) {
+}
+
+void SysCtlPWMClockSet(uint32_t ui32Config) {
+}
+
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral) {
+}
+
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral) {
+    return true;
+}
+
+void IntEnable(uint32_t ui32Interrupt) {
+}
+
+void IntPrioritySet(uint32_t ui32Interrupt, uint8_t ui8Priority) {
+}
+
+//////////////////////////////////////////////////////////////////////////
+///////////////////      driverlib: GPIO and PWM     /////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+void GPIOPinConfigure(uint32_t ui32PinConfig) {
+}
+
+void GPIOPinTypeGPIOOutput(uint32_t ui32Port, uint8_t ui8Pins) {
+}
+
+void GPIOPinTypePWM(uint32_t ui32Port, uint8_t ui8Pins) {
+}
+
+void GPIOPinTypeUART(uint32_t ui32Port, uint8_t ui8Pins) {
+}
+
+void GPIOPinWrite(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val) {
+    HalPort* port = FindPort(ui32Port);
+
+    if (port != NULL) {
+        port->data = (uint8_t)((port->data & ~ui8Pins) | (ui8Val & ui8Pins));
+    }
+}
+
+void PWMGenConfigure(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Config) {
+}
+
+void PWMGenPeriodSet(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Period) {
+}
+
+void PWMGenEnable(uint32_t ui32Base, uint32_t ui32Gen) {
+}
+
+void PWMOutputState(uint32_t ui32Base, uint32_t ui32PWMOutBits, bool bEnable) {
+}
+
+//////////////////////////////////////////////////////////////////////////
+///////////////////         driverlib: timers        /////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+void TimerConfigure(uint32_t ui32Base, uint32_t ui32Config) {
+    HalTimer* timer = FindTimer(ui32Base);
+
+    if (timer != NULL) {
+        timer->config = ui32Config;
+        timer->enabled = false;
+    }
+}
+
+void TimerLoadSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value) {
+    HalTimer* timer = FindTimer(ui32Base);
+
+    if (timer != NULL) {
+        timer->load = ui32Value;
+        timer->remaining = (int64_t)ui32Value + 1;
+    }
+}
+
+void TimerPrescaleSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value) {
+    HalTimer* timer = FindTimer(ui32Base);
+
+    if (timer != NULL) {
+        timer->prescale = ui32Value;
+    }
+}
+
+void TimerEnable(uint32_t ui32Base, uint32_t ui32Timer) {
+    HalTimer* timer = FindTimer(ui32Base);
+
+    if (timer != NULL && !timer->enabled) {
+        timer->enabled = true;
+        timer->startCycles = HalCycles();
+        if (timer->remaining <= 0) {
+            timer->remaining = (int64_t)timer->load + 1;
+        }
+    }
+}
+
+void TimerDisable(uint32_t ui32Base, uint32_t ui32Timer) {
+    HalTimer* timer = FindTimer(ui32Base);
+
+    if (timer != NULL) {
+        timer->enabled = false;
+    }
+}
+
+void TimerIntRegister(uint32_t ui32Base, uint32_t ui32Timer, void (*pfnHandler)(void)) {
+    HalTimer* timer = FindTimer(ui32Base);
+
+    if (timer != NULL) {
+        timer->handler = pfnHandler;
+    }
+}
+
+void TimerIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags) {
+    HalTimer* timer = FindTimer(ui32Base);
+
+    if (timer != NULL) {
+        timer->intMask |= ui32IntFlags;
+    }
+}
+
+void TimerIntClear(uint32_t ui32Base, uint32_t ui32IntFlags) {
+    HalTimer* timer = FindTimer(ui32Base);
+
+    if (timer != NULL) {
+        timer->intStatus &= ~ui32IntFlags;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+///////////////////          driverlib: UART         /////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+void UARTClockSourceSet(uint32_t ui32Base, uint32_t ui32Source) {
+}
+
+void UARTConfigSetExpClk(uint32_t ui32Base, uint32_t ui32UARTClk, uint32_t ui32Baud, uint32_t ui32Config) {
+    HalUart* uart = FindUart(ui32Base);
+
+    if (uart != NULL) {
+        uart->baud = ui32Baud;
+    }
+}
+
+void UARTEnable(uint32_t ui32Base) {
+}
+
+void UARTFIFOEnable(uint32_t ui32Base) {
+    HalUart* uart = FindUart(ui32Base);
+
+    if (uart != NULL) {
+        uart->fifo = true;
+    }
+}
+
+void UARTFIFODisable(uint32_t ui32Base) {
+    HalUart* uart = FindUart(ui32Base);
+
+    if (uart != NULL) {
+        uart->fifo = false;
+    }
+}
+
+void UARTFIFOLevelSet(uint32_t ui32Base, uint32_t ui32TxLevel, uint32_t ui32RxLevel) {
+    HalUart* uart = FindUart(ui32Base);
+
+    if (uart != NULL && ui32TxLevel < TABLE_SIZE(s_fifoLevels) && (ui32RxLevel >> 3) < TABLE_SIZE(s_fifoLevels)) {
+        uart->txLevel = s_fifoLevels[ui32TxLevel];
+        uart->rxLevel = s_fifoLevels[ui32RxLevel >> 3];
+    }
+}
+
+void UARTTxIntModeSet(uint32_t ui32Base, uint32_t ui32Mode) {
+}
+
+void UARTIntRegister(uint32_t ui32Base, void (*pfnHandler)(void)) {
+    HalUart* uart = FindUart(ui32Base);
+
+    if (uart != NULL) {
+        uart->handler = pfnHandler;
+    }
+}
+
+void UARTIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags) {
+    HalUart* uart = FindUart(ui32Base);
+
+    if (uart != NULL) {
+        uart->intMask |= ui32IntFlags;
+    }
+}
+
+void UARTIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags) {
+    HalUart* uart = FindUart(ui32Base);
+
+    if (uart != NULL) {
+        uart->intMask &= ~ui32IntFlags;
+    }
+}
+
+uint32_t UARTIntStatus(uint32_t ui32Base, bool bMasked) {
+    HalUart* uart = FindUart(ui32Base);
+
+    if (uart == NULL) {
+        return 0;
+    }
+    return bMasked ? (uart->intStatus & uart->intMask) : uart->intStatus;
+}
+
+void UARTIntClear(uint32_t ui32Base, uint32_t ui32IntFlags) {
+    HalUart* uart = FindUart(ui32Base);
+
+    if (uart != NULL) {
+        uart->intStatus &= ~ui32IntFlags;
+    }
+}
+
+bool UARTCharsAvail(uint32_t ui32Base) {
+    HalUart* uart = FindUart(ui32Base);
+
+    return uart != NULL && uart->rxCount > 0;
+}
+
+int32_t UARTCharGetNonBlocking(uint32_t ui32Base) {
+    HalUart* uart = FindUart(ui32Base);
+    uint32_t data;
+
+    if (uart == NULL || uart->rxCount == 0) {
+        return -1;
+    }
+    data = uart->rx[uart->rxHead];
+    uart->rxHead = (uart->rxHead + 1) % HAL_UART_FIFO_BYTES;
+    uart->rxCount--;
+    return (int32_t)data;
+}
+
+bool UARTSpaceAvail(uint32_t ui32Base) {
+    HalUart* uart = FindUart(ui32Base);
+
+    return uart != NULL && uart->txCount < HAL_UART_FIFO_BYTES;
+}
+
+bool UARTCharPutNonBlocking(uint32_t ui32Base, unsigned char ucData) {
+    HalUart* uart = FindUart(ui32Base);
+
+    if (uart == NULL || uart->txCount >= HAL_UART_FIFO_BYTES) {
+        return false;
+    }
+    uart->tx[(uart->txHead + uart->txCount) % HAL_UART_FIFO_BYTES] = ucData;
+    uart->txCount++;
+    return true;
+}
+
+// Blocking writes go straight to the sink; on the board the caller would wait for the wire.
+void UARTCharPut(uint32_t ui32Base, unsigned char ucData) {
+    Emit(ui32Base, &ucData, 1);
+}
+
+//////////////////////////////////////////////////////////////////////////
+///////////////////      utils: uartstdio, ustdlib   /////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+void UARTStdioConfig(uint32_t ui32PortNum, uint32_t ui32Baud, uint32_t ui32SrcClock) {
+}
+
+int UARTwrite(const char* pcBuf, uint32_t ui32Len) {
+    Emit(UART0_BASE, (const uint8_t*)pcBuf, ui32Len);
+    return (int)ui32Len;
+}
+
+void UARTprintf(const char* pcString, ...) {
+    char line[HAL_PRINTF_BYTES];
+    va_list args;
+    int n;
+
+    va_start(args, pcString);
+    n = vsnprintf(line, sizeof(line), pcString, args);
+    va_end(args);
+
+    if (n > 0) {
+        UARTwrite(line, (n < (int)sizeof(line)) ? (uint32_t)n : sizeof(line) - 1);
+    }
+}
+
+int uvsnprintf(char* restrict s, size_t n, const char* restrict format, va_list arg) {
+    return vsnprintf(s, n, format, arg);
+}
@@ -0,0 +1,92 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: hal.h
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Hardware shim for the host build of the firmware. It implements the
+ * TivaWare driverlib, uartstdio and ustdlib calls the firmware makes, and
+ * HWREG() (hal/inc/hw_types.h) maps every register access into a small
+ * register file instead of the TM4C123 address space.
+ *
+ * Only the devices the services depend on are modelled:
+ *
+ *   Timers   - free running time bases (WTIMER5 for service_timing.c,
+ *              WTIMER0 for runtime_stats.c) read through HWREG, and
+ *              timeout interrupts (the Timer1A brake ramp).
+ *   UARTs    - receive FIFO with RX and receive timeout interrupts, and a
+ *              transmit FIFO drained at the configured baud rate with TX
+ *              interrupts at the FIFO trigger level. UARTCharPut() and the
+ *              uartstdio calls reach the sink at once.
+ *   GPIO     - whole port data written by GPIOPinWrite().
+ *
+ * PWM and pin configuration calls do nothing; the motor state is read back
+ * with MotorCurrent(). Masked GPIO DATA stores made through HWREG land in
+ * the register file only.
+ *
+ * Time: with the virtual time base every kernel tick starts at exactly
+ * tick * HAL_CYCLES_PER_TICK cycles and every time base read advances the
+ * clock by a fixed step, so a replay gives the same time stamps on every
+ * run. The wall clock time base measures the host instead.
+ *
+ * Device interrupts are only raised from HalTick() and HalUartReceive(),
+ * which run inside the kernel tick hook, so they land on tick boundaries.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#ifndef __HAL_H__
+#define __HAL_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+#define HAL_CYCLES_PER_TICK     (configCPU_CLOCK_HZ / configTICK_RATE_HZ)
+#define HAL_UART_FIFO_BYTES     16
+#define HAL_UART_BIT_TIMES      10      // Start, 8 data and stop bit per byte.
+
+// Receives every byte a UART puts on the wire.
+typedef void (*HalSink)(uint32_t uartBase, const uint8_t* data, uint32_t len);
+
+// wallClock: time base from the host clock rather than the virtual one. readStep: cycles the
+// virtual clock advances on every time base read.
+void HalInit(bool wallClock, uint32_t readStep, HalSink sink);
+
+// Register file behind HWREG(). Time base registers are refreshed on every access.
+volatile uint32_t* HalRegister(uint32_t addr);
+
+// Current time base value in system clock cycles.
+uint64_t HalCycles(void);
+
+// Bracket code running in interrupt context: IntMasterDisable() then reports interrupts as
+// masked and IntMasterEnable() leaves the tick handler's signal mask alone.
+void HalEnterISR(void);
+void HalExitISR(void);
+
+// Kernel tick: starts the virtual time of tick, runs due timer interrupts and moves one tick
+// worth of bytes out of every transmit FIFO. Interrupt context.
+void HalTick(TickType_t tick);
+
+// A byte arriving on uartBase: stored in the receive FIFO (an overrun if full) and the receive
+// interrupt raised. Interrupt context.
+void HalUartReceive(uint32_t uartBase, uint8_t byte);
+
+// The receive line has gone quiet: raises the receive timeout interrupt if bytes are waiting.
+void HalUartRxIdle(uint32_t uartBase);
+
+// Baud rate set by UARTConfigSetExpClk(), 0 before.
+uint32_t HalUartBaud(uint32_t uartBase);
+
+// Pin levels of a GPIO port as written by GPIOPinWrite().
+uint8_t HalGpioData(uint32_t portBase);
+
+#endif // __HAL_H__
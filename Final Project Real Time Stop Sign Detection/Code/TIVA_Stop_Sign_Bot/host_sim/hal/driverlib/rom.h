@@ -0,0 +1,37 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: hal/driverlib/rom.h
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Host replacement for the TivaWare rom.h. On the board the ROM_ calls
+ * jump through the driverlib table in the TM4C123 boot ROM; here they are
+ * the hal.c functions of the same name.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#ifndef __DRIVERLIB_ROM_H__
+#define __DRIVERLIB_ROM_H__
+
+#define ROM_GPIOPinConfigure        GPIOPinConfigure
+#define ROM_GPIOPinTypeGPIOOutput   GPIOPinTypeGPIOOutput
+#define ROM_GPIOPinTypePWM          GPIOPinTypePWM
+#define ROM_GPIOPinWrite            GPIOPinWrite
+#define ROM_PWMGenConfigure         PWMGenConfigure
+#define ROM_PWMGenEnable            PWMGenEnable
+#define ROM_PWMGenPeriodSet         PWMGenPeriodSet
+#define ROM_PWMOutputState          PWMOutputState
+#define ROM_SysCtlClockGet          SysCtlClockGet
+#define ROM_SysCtlPWMClockSet       SysCtlPWMClockSet
+#define ROM_SysCtlPeripheralEnable  SysCtlPeripheralEnable
+
+#endif // __DRIVERLIB_ROM_H__
@@ -0,0 +1,35 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: hal/inc/hw_types.h
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Host replacement for the TivaWare hw_types.h. Register accesses go to
+ * the register file in hal.c rather than to the TM4C123 address space,
+ * which does not exist on the host. Found ahead of TivaWare on the
+ * include path; the other TivaWare headers are used as they are.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#ifndef __HW_TYPES_H__
+#define __HW_TYPES_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+extern volatile uint32_t* HalRegister(uint32_t addr);
+
+#define HWREG(x)                (*HalRegister((uint32_t)(x)))
+#define HWREGH(x)               (*(volatile uint16_t*)HalRegister((uint32_t)(x)))
+#define HWREGB(x)               (*(volatile uint8_t*)HalRegister((uint32_t)(x)))
+
+#endif // __HW_TYPES_H__
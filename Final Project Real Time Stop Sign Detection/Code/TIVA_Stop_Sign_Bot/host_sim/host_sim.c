@@ -0,0 +1,420 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: host_sim.c
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * Host simulation of the stop sign bot firmware. The unmodified firmware
+ * (freertos_demo.c and its modules) runs on the FreeRTOS POSIX port on top
+ * of the hardware shim in hal.c, while this file replays a link trace
+ * recorded on the Jetson (camera-bit.py --link-trace) into UART1 and logs
+ * what the firmware does with it. See readme.txt.
+ *
+ * The firmware's main() and vApplicationTickHook() are renamed at compile
+ * time (see the Makefile). On every kernel tick the hook here runs, in
+ * this order and in interrupt context: the shim's timers and transmit
+ * FIFOs, the trace bytes due by this tick (each one through the UART1
+ * interrupt), the firmware tick hook that releases the services, and a
+ * check of the motor and LED outputs. Every line of the event log is
+ * written from the tick, stamped with the tick count.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#include "uart_link.h"
+#include "motor_control.h"
+#include "sequencer.h"
+#include "hal.h"
+
+#define HOST_SIM_STACK_WORDS    configMINIMAL_STACK_SIZE
+#define HOST_SIM_POLL_MS        10          // Run end check period of the host task.
+#define HOST_SIM_DRAIN_MS       1000        // Left after the run for the summaries to print.
+#define HOST_SIM_LOG_BYTES      (4 * 1024 * 1024)
+#define HOST_SIM_READ_CYCLES    50          // Default virtual time per time base read, 1 us.
+#define HOST_SIM_START_MS       100         // Default tick of the first trace record.
+
+// Firmware entry points, renamed by the Makefile.
+extern int FirmwareMain(void);
+extern void FirmwareTickHook(void);
+
+// One frame of the link trace.
+typedef struct {
+    TickType_t tick;        // Kernel tick its first byte arrives on.
+    uint32_t offset;        // First byte in s_traceBytes.
+    uint32_t len;
+} TraceRecord;
+
+static TraceRecord* s_records = NULL;
+static uint8_t* s_traceBytes = NULL;
+static uint32_t s_recordCount = 0;
+static uint32_t s_nextRecord = 0;           // Record being delivered.
+static uint32_t s_nextByte = 0;             // Its next byte.
+static uint32_t s_rxCredit = 0;             // Bit times on the UART1 line this tick, times 1000.
+
+static FILE* s_eventsFile = NULL;
+static FILE* s_uart0File = NULL;
+static char s_log[HOST_SIM_LOG_BYTES];
+static uint32_t s_logLen = 0;
+static uint32_t s_logLost = 0;
+
+static UARTLinkParser s_txParser;           // Decodes what the TIVA sends to the Jetson.
+static MotorCommand s_lastMotor;
+static bool s_lastLed = false;
+
+static TickType_t s_limitTick = 0;          // End of the simulation, 0 = when the run ends.
+
+static const char* const s_directions[] = { "stop", "fwd", "rev" };
+
+// Appends one line to the event log. Tick context, or with interrupts masked.
+static void LogLine(const char* format, ...) {
+    va_list args;
+    int n;
+
+    va_start(args, format);
+    n = vsnprintf(&s_log[s_logLen], sizeof(s_log) - s_logLen, format, args);
+    va_end(args);
+
+    if (n < 0 || (uint32_t)n >= sizeof(s_log) - s_logLen) {
+        s_log[s_logLen] = '\0';
+        s_logLost++;
+        return;
+    }
+    s_logLen += n;
+}
+
+static void LogHex(TickType_t tick, const char* what, const uint8_t* data, uint32_t len) {
+    char hex[2 * UART_LINK_MAX_FRAME + 1];
+    uint32_t i;
+
+    for (i = 0; i < len && i < UART_LINK_MAX_FRAME; i++) {
+        snprintf(&hex[2 * i], 3, "%02x", data[i]);
+    }
+    hex[2 * i] = '\0';
+    LogLine("%u %s %s\n", (unsigned)tick, what, hex);
+}
+
+void HostSimAssert(const char* file, unsigned long line) {
+    fprintf(stderr, "host_sim: assertion failed at %s:%lu\n", file, line);
+    abort();
+}
+
+/**
+ * Every task the firmware creates goes through here (-DxTaskCreate=HostSimTaskCreate), so that
+ * its thread gets a host sized stack.
+ */
+BaseType_t HostSimTaskCreate(TaskFunction_t code, const char* const name, const configSTACK_DEPTH_TYPE depth,
+                             void* const params, UBaseType_t priority, TaskHandle_t* const handle) {
+    return xTaskCreate(code, name, (depth < HOST_SIM_STACK_WORDS) ? HOST_SIM_STACK_WORDS : depth,
+                       params, priority, handle);
+}
+
+// Bytes leaving the shim's UARTs: UART0 to the capture file, UART2 frames into the event log.
+static void UartSink(uint32_t uartBase, const uint8_t* data, uint32_t len) {
+    uint32_t i;
+
+    if (uartBase == UART0_BASE) {
+        fwrite(data, 1, len, s_uart0File);
+        return;
+    }
+    if (uartBase != UART2_BASE) {
+        return;
+    }
+    for (i = 0; i < len; i++) {
+        UARTLinkFrame frame;
+
+        if (UARTLinkParseByte(&s_txParser, data[i], &frame)) {
+            LogHex(xTaskGetTickCountFromISR(), "tx", frame.payload, frame.len);
+        }
+    }
+}
+
+/**
+ * Feeds UART1 with the trace bytes due by tick, no faster than the line's baud rate allows.
+ */
+static void DeliverTrace(TickType_t tick) {
+    uint32_t baud = HalUartBaud(UART1_BASE);
+
+    s_rxCredit += ((baud != 0) ? baud : 115200) * 1000 / configTICK_RATE_HZ;
+
+    while (s_nextRecord < s_recordCount && s_records[s_nextRecord].tick <= tick &&
+           s_rxCredit >= HAL_UART_BIT_TIMES * 1000) {
+        const TraceRecord* record = &s_records[s_nextRecord];
+
+        if (s_nextByte == 0) {
+            LogHex(tick, "rx", &s_traceBytes[record->offset], record->len);
+        }
+        HalUartReceive(UART1_BASE, s_traceBytes[record->offset + s_nextByte]);
+        s_rxCredit -= HAL_UART_BIT_TIMES * 1000;
+
+        if (++s_nextByte == record->len) {
+            s_nextRecord++;
+            s_nextByte = 0;
+        }
+    }
+
+    if (s_nextRecord >= s_recordCount || s_records[s_nextRecord].tick > tick) {
+        // The line is idle: no banking of bit times, and the tail of a burst times out.
+        if (s_rxCredit > HAL_UART_BIT_TIMES * 1000) {
+            s_rxCredit = HAL_UART_BIT_TIMES * 1000;
+        }
+        HalUartRxIdle(UART1_BASE);
+    }
+}
+
+// Logs the motor command and the blue LED whenever they change.
+static void SampleOutputs(TickType_t tick) {
+    MotorCommand motor;
+    bool led = (HalGpioData(GPIO_PORTF_BASE) & GPIO_PIN_2) != 0;   // LED_PIN in freertos_demo.c.
+
+    MotorCurrent(&motor);
+    if (memcmp(&motor, &s_lastMotor, sizeof(motor)) != 0) {
+        LogLine("%u motor %s %u %s %u\n", (unsigned)tick,
+                s_directions[motor.direction1 % 3], motor.duty1, s_directions[motor.direction2 % 3], motor.duty2);
+        s_lastMotor = motor;
+    }
+    if (led != s_lastLed) {
+        LogLine("%u led %s\n", (unsigned)tick, led ? "on" : "off");
+        s_lastLed = led;
+    }
+}
+
+void vApplicationTickHook(void) {
+    TickType_t tick = xTaskGetTickCountFromISR();
+
+    HalEnterISR();
+    HalTick(tick);
+    DeliverTrace(tick);
+    FirmwareTickHook();
+    SampleOutputs(tick);
+    HalExitISR();
+}
+
+/**
+ * Writes the summary and the event log and ends the process. The exit status is 1 if the run
+ * had any overrun, deadline miss or link error, so a replay can gate a change.
+ */
+static void Finish(TickType_t tick) {
+    uint32_t linkErrors, overruns = 0;
+    uint32_t id;
+
+    portDISABLE_INTERRUPTS();
+
+    linkErrors = g_uartLinkStats.crcErrors + g_uartLinkStats.lengthErrors + g_uartLinkStats.seqGaps +
+                 g_uartLinkStats.ringOverflows + g_uartLinkStats.hwErrors;
+
+    LogLine("%u end\n", (unsigned)tick);
+    LogLine("# trace: %u of %u frames delivered\n", s_nextRecord, s_recordCount);
+    LogLine("# link: %u frames, %u crc, %u length, %u missing, %u overflow, %u hw errors, %u resyncs; %u frames sent, %u dropped\n",
+            g_uartLinkStats.framesOk, g_uartLinkStats.crcErrors, g_uartLinkStats.lengthErrors,
+            g_uartLinkStats.seqGaps, g_uartLinkStats.ringOverflows, g_uartLinkStats.hwErrors, g_uartLinkStats.seqResyncs,
+            g_uartLinkStats.txFrames, g_uartLinkStats.txDropped);
+    for (id = 0; id < SequencerServiceCount(); id++) {
+        LogLine("# %s: %u overruns, %u deadline misses\n", SequencerService(id)->name, SequencerOverruns(id),
+                SequencerDeadlineMisses(id));
+        overruns += SequencerOverruns(id) + SequencerDeadlineMisses(id);
+    }
+    if (s_logLost != 0) {
+        fprintf(stderr, "host_sim: event log full, %u lines lost\n", s_logLost);
+    }
+
+    fwrite(s_log, 1, s_logLen, s_eventsFile);
+    fflush(s_eventsFile);
+    fflush(s_uart0File);
+    exit((overruns != 0 || linkErrors != 0) ? 1 : 0);
+}
+
+/**
+ * Ends the simulation HOST_SIM_DRAIN_MS after the sequencer run is over, or at the -d limit.
+ */
+static void HostSimTask(void* pvParameters) {
+    TickType_t endTick = 0;
+
+    while (1) {
+        TickType_t now;
+
+        vTaskDelay(pdMS_TO_TICKS(HOST_SIM_POLL_MS));
+        now = xTaskGetTickCount();
+
+        if (s_limitTick != 0 && now >= s_limitTick) {
+            Finish(now);
+        }
+        if (endTick == 0 && SequencerAborted()) {
+            endTick = now + pdMS_TO_TICKS(HOST_SIM_DRAIN_MS);
+        }
+        if (endTick != 0 && now >= endTick) {
+            Finish(now);
+        }
+    }
+}
+
+static int HexValue(int c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * Loads a link trace: one frame per line, "<ms> <hex bytes>", '#' starts a comment. Times are
+ * relative to the first frame, which arrives on tick startTick.
+ */
+static bool LoadTrace(const char* path, TickType_t startTick) {
+    FILE* file = fopen(path, "r");
+    char* line = NULL;
+    size_t size = 0;
+    uint32_t lineNumber = 0, capacity = 0, bytes = 0;
+    double first = 0.0, last = 0.0;
+
+    if (file == NULL) {
+        perror(path);
+        return false;
+    }
+
+    while (getline(&line, &size, file) >= 0) {
+        char* p = line;
+        char* end;
+        double ms;
+        uint32_t len = 0;
+
+        lineNumber++;
+        while (isspace((unsigned char)*p)) p++;
+        if (*p == '\0' || *p == '#') {
+            continue;
+        }
+
+        ms = strtod(p, &end);
+        if (end == p || ms < last) {
+            fprintf(stderr, "%s:%u: bad or decreasing time\n", path, lineNumber);
+            return false;
+        }
+        if (s_recordCount == 0) {
+            first = ms;
+        }
+        last = ms;
+
+        if (s_recordCount == capacity) {
+            TraceRecord* records;
+            uint8_t* traceBytes;
+
+            capacity = capacity ? 2 * capacity : 256;
+            records = realloc(s_records, capacity * sizeof(*s_records));
+            if (records == NULL) {
+                fprintf(stderr, "%s:%u: out of memory\n", path, lineNumber);
+                return false;
+            }
+            s_records = records;
+            traceBytes = realloc(s_traceBytes, capacity * UART_LINK_MAX_FRAME);
+            if (traceBytes == NULL) {
+                fprintf(stderr, "%s:%u: out of memory\n", path, lineNumber);
+                return false;
+            }
+            s_traceBytes = traceBytes;
+        }
+
+        for (p = end; *p != '\0' && *p != '#'; p++) {
+            int high, low;
+
+            if (isspace((unsigned char)*p)) {
+                continue;
+            }
+            high = HexValue(p[0]);
+            low = HexValue(p[1]);
+            if (high < 0 || low < 0 || len == UART_LINK_MAX_FRAME) {
+                fprintf(stderr, "%s:%u: bad frame bytes\n", path, lineNumber);
+                return false;
+            }
+            s_traceBytes[bytes + len++] = (uint8_t)((high << 4) | low);
+            p++;
+        }
+        if (len == 0) {
+            continue;
+        }
+
+        s_records[s_recordCount].tick = startTick + (TickType_t)((ms - first) * configTICK_RATE_HZ / 1000);
+        s_records[s_recordCount].offset = bytes;
+        s_records[s_recordCount].len = len;
+        s_recordCount++;
+        bytes += len;
+    }
+
+    free(line);
+    fclose(file);
+    return true;
+}
+
+static void Usage(const char* name) {
+    fprintf(stderr,
+            "usage: %s [-o events.txt] [-u uart0.bin] [-s start_ms] [-d duration_ms] [-r read_cycles] [-w] [trace]\n"
+            "  -o  event log (default stdout)\n"
+            "  -u  UART0 capture, console text and telemetry (default host_sim_uart0.bin)\n"
+            "  -s  tick of the first trace frame (default %u)\n"
+            "  -d  end after this many ms even if the run goes on (default: when the run ends)\n"
+            "  -r  virtual cycles per time base read (default %u)\n"
+            "  -w  time base from the host clock instead (not repeatable)\n",
+            name, HOST_SIM_START_MS, HOST_SIM_READ_CYCLES);
+}
+
+int main(int argc, char** argv) {
+    const char* eventsPath = NULL;
+    const char* uart0Path = "host_sim_uart0.bin";
+    uint32_t startMs = HOST_SIM_START_MS, readCycles = HOST_SIM_READ_CYCLES;
+    bool wallClock = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "o:u:s:d:r:wh")) != -1) {
+        switch (opt) {
+            case 'o': eventsPath = optarg; break;
+            case 'u': uart0Path = optarg; break;
+            case 's': startMs = strtoul(optarg, NULL, 0); break;
+            case 'd': s_limitTick = pdMS_TO_TICKS(strtoul(optarg, NULL, 0)); break;
+            case 'r': readCycles = strtoul(optarg, NULL, 0); break;
+            case 'w': wallClock = true; break;
+            default: Usage(argv[0]); return 2;
+        }
+    }
+
+    if (optind < argc && !LoadTrace(argv[optind], pdMS_TO_TICKS(startMs))) {
+        return 2;
+    }
+
+    s_eventsFile = (eventsPath != NULL) ? fopen(eventsPath, "w") : stdout;
+    s_uart0File = fopen(uart0Path, "wb");
+    if (s_eventsFile == NULL || s_uart0File == NULL) {
+        perror("host_sim");
+        return 2;
+    }
+    LogLine("# host_sim %s, %u frames, %s time base\n", (optind < argc) ? argv[optind] : "(no trace)",
+            s_recordCount, wallClock ? "wall clock" : "virtual");
+
+    UARTLinkParserReset(&s_txParser);
+    s_txParser.shadow = true;
+    HalInit(wallClock, readCycles, UartSink);
+
+    if (xTaskCreate(HostSimTask, "HostSim", HOST_SIM_STACK_WORDS, NULL, configMAX_PRIORITIES - 1, NULL) != pdPASS) {
+        fprintf(stderr, "host_sim: cannot create the host task\n");
+        return 2;
+    }
+
+    // Does not return: the firmware starts the scheduler and HostSimTask ends the process.
+    return FirmwareMain();
+}
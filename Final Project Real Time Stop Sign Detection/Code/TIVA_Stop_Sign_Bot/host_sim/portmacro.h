@@ -0,0 +1,33 @@
+/***********************************************************************
+ * ==========================================================================
+ *
+ * File: portmacro.h
+ *
+ * Author: Kiran Jojare, Ayswariya Kannan
+ *
+ * Project Name: Stop Sign Detection Bot on TIVA using FreeRTOS
+ *
+ * Description:
+ * The POSIX port's portmacro.h with one change. The firmware tick hook and
+ * every simulated device interrupt run inside the port's tick handler,
+ * where the port's portYIELD_FROM_ISR() would switch threads in the middle
+ * of xTaskIncrementTick(). The FromISR calls already set the kernel's
+ * pending yield, and the port switches once the tick handler completes,
+ * so here the request is dropped.
+ *
+ * Subject: ECEN - 5623 Real Time Operating Systems
+ *
+ * University: University of Colorado, Boulder
+ *
+ * ==========================================================================
+ ***********************************************************************/
+
+#ifndef HOST_SIM_PORTMACRO_H
+#define HOST_SIM_PORTMACRO_H
+
+#include_next <portmacro.h>
+
+#undef portYIELD_FROM_ISR
+#define portYIELD_FROM_ISR( x )             ( ( void ) ( x ) )
+
+#endif /* HOST_SIM_PORTMACRO_H */
@@ -0,0 +1,170 @@
+"""
+TELEMETRY DECODER
+
+Turns the TIVA's UART0 output back into readable text. The firmware interleaves plain UARTprintf
+text with binary telemetry batches (see freertos_demo/telemetry.h):
+
+    [0xA5] [0x5A] [SEQ] [COUNT] COUNT x ([TIMESTAMP:4] [ARG:4] [SOURCE] [EVENT]) [CRC16 hi] [CRC16 lo]
+
+Text is passed through unchanged; every record of a batch whose CRC checks out is printed as one
+line. Timestamps are time base cycles and are converted with --clock-hz.
+
+Usage:
+    python3 telemetry_decode.py /dev/ttyACM0            # live, 115200 baud
+    python3 telemetry_decode.py --file capture.bin      # offline capture
+
+Authors: Kiran Jojare, Ayswariya Kannan
+Subject: ECEN 5623 Real-Time Embedded Systems
+University: University of Colorado Boulder
+"""
+
+import argparse
+import struct
+import sys
+
+SYNC0 = 0xA5
+SYNC1 = 0x5A
+RECORD_BYTES = 10
+MAX_RECORDS = 16
+
+SOURCES = {0: "CameraUARTService1", 1: "Motor1Service2", 2: "Motor2Service3", 3: "DiagnosticsLEDService4",
+           4: "RuntimeStats"}
+
+# Keep in sync with the TEL_EVT_xxx codes in telemetry.h.
+EVENTS = {
+    0x01: ("Received Frame", lambda a: "seq %u: 0x%02X" % (a >> 8, a & 0xFF)),
+    0x02: ("Alert: STOP Sign Detected - Vehicle HALTED", lambda a: "seq %u" % a),
+    0x03: ("Info: Path Clear - Vehicle Continuing", lambda a: "seq %u" % a),
+    0x04: ("Warning: Unknown Command - No Action Taken", lambda a: "0x%02X" % a),
+    0x05: ("Warning: Unknown Message - No Action Taken", lambda a: "seq %u" % a),
+    0x06: ("Warning: Link errors", lambda a: "total %u" % a),
+    0x10: ("STOP Sign Detected - Motor Stopped", lambda a: "seq %u" % a),
+    0x11: ("Path Clear - Motor Resumed Forward", lambda a: "seq %u" % a),
+    0x12: ("STOP Sign Detected - Motor Stopped from UART ISR", lambda a: "seq %u" % a),
+    0x13: ("Path Clear Ignored - Newer STOP Already Applied", lambda a: "seq %u" % a),
+    0x20: ("Blue LED ON", lambda a: "seq %u" % a),
+    0x21: ("Blue LED OFF", lambda a: "seq %u" % a),
+    0x30: ("Task CPU", lambda a: "task %u: %.2f %%" % (a >> 24, (a & 0xFFFFFF) / 100.0)),
+    0x31: ("Task stack headroom", lambda a: "task %u: %u words" % (a >> 24, a & 0xFFFFFF)),
+    0x32: ("Task context switches", lambda a: "task %u: %u" % (a >> 24, a & 0xFFFFFF)),
+    0x33: ("Services utilization", lambda a: "%.2f %% of RM LUB %.2f %%%s" % (
+        (a & 0xFFFF) / 100.0, (a >> 16) / 100.0, "" if (a & 0xFFFF) <= (a >> 16) else ", ABOVE BOUND")),
+    0xF0: ("Warning: Telemetry records dropped", lambda a: "total %u" % a),
+}
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, same as UARTLinkCrc16() on the TIVA."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def format_record(timestamp, arg, source, event, clock_hz):
+    name, fmt = EVENTS.get(event, ("Event 0x%02X" % event, lambda a: "arg %u" % a))
+    return "[%.6f s] [%s] %s (%s)" % (timestamp / clock_hz, SOURCES.get(source, "Source%u" % source), name, fmt(arg))
+
+
+class TelemetryDecoder:
+    """Splits a UART0 byte stream into text and telemetry records."""
+
+    def __init__(self, clock_hz):
+        self.clock_hz = clock_hz
+        self.buf = bytearray()
+        self.last_seq = None
+        self.crc_errors = 0
+        self.lost_frames = 0
+
+    def _frame_length(self):
+        count = self.buf[3]
+        if count == 0 or count > MAX_RECORDS:
+            return None
+        return 4 + count * RECORD_BYTES + 2
+
+    def feed(self, data):
+        """Returns (text, lines): pass-through text and one decoded line per record."""
+        self.buf += data
+        text = bytearray()
+        lines = []
+        while self.buf:
+            start = self.buf.find(bytes([SYNC0, SYNC1]))
+            if start < 0:
+                # Keep a trailing SYNC0 in case its partner is still on the wire.
+                keep = 1 if self.buf[-1] == SYNC0 else 0
+                text += self.buf[:len(self.buf) - keep]
+                del self.buf[:len(self.buf) - keep]
+                break
+            text += self.buf[:start]
+            del self.buf[:start]
+            if len(self.buf) < 4:
+                break
+            length = self._frame_length()
+            if length is None:
+                text += self.buf[:1]
+                del self.buf[:1]
+                continue
+            if len(self.buf) < length:
+                break
+            frame = bytes(self.buf[:length])
+            if crc16(frame[2:-2]) != ((frame[-2] << 8) | frame[-1]):
+                self.crc_errors += 1
+                text += self.buf[:1]
+                del self.buf[:1]
+                continue
+            del self.buf[:length]
+
+            seq = frame[2]
+            if self.last_seq is not None and seq != ((self.last_seq + 1) & 0xFF):
+                self.lost_frames += (seq - self.last_seq - 1) & 0xFF
+            self.last_seq = seq
+
+            for i in range(frame[3]):
+                off = 4 + i * RECORD_BYTES
+                timestamp, arg, source, event = struct.unpack_from("<IIBB", frame, off)
+                lines.append(format_record(timestamp, arg, source, event, self.clock_hz))
+        return bytes(text), lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode TIVA UART0 telemetry")
+    parser.add_argument("port", nargs="?", default="/dev/ttyACM0", help="serial port (ignored with --file)")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--file", help="decode a raw capture instead of a serial port")
+    parser.add_argument("--clock-hz", type=float, default=50e6, help="TIVA time base frequency")
+    args = parser.parse_args()
+
+    decoder = TelemetryDecoder(args.clock_hz)
+    if args.file:
+        source = open(args.file, "rb")
+        read = lambda: source.read(4096)
+    else:
+        import serial
+        source = serial.Serial(args.port, args.baud, timeout=0.1)
+        read = lambda: source.read(256)
+
+    try:
+        while True:
+            data = read()
+            if not data:
+                if args.file:
+                    break
+                continue
+            text, lines = decoder.feed(data)
+            if text:
+                sys.stdout.write(text.decode("ascii", errors="replace"))
+            for line in lines:
+                print(line)
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        source.close()
+        if decoder.crc_errors or decoder.lost_frames:
+            print("telemetry: %u CRC errors, %u frames lost" % (decoder.crc_errors, decoder.lost_frames), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,339 @@
+/*
+ * Wake-up latency and throughput of two ways to pass messages between processes:
+ *
+ *   sem   the waiter/signaler handshake carrying a payload: one shared buffer, the named
+ *         semaphore /my_semaphore posted for every message and a second one to hand the
+ *         buffer back.
+ *   ring  shm_channel, the lock-free single producer / single consumer ring that only
+ *         enters the kernel on empty/full transitions.
+ *
+ * Each mode runs twice: paced (one message every -i microseconds, so the consumer is
+ * asleep when each message arrives and the latency is the wake-up latency) and unpaced
+ * (back to back, for throughput). The producer is the parent, the consumer a forked child;
+ * latency is taken from CLOCK_MONOTONIC stamps, the same clock in both processes.
+ */
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "shm_channel.h"
+
+#define SEM_NAME "/my_semaphore"
+#define SEM_FREE_NAME "/my_semaphore_free"
+#define RING_NAME "/ipc_bench_ring"
+
+struct msg_hdr {
+    uint64_t seq;
+    uint64_t sent_ns;
+};
+
+/* Shared with the consumer: its latency samples and the time of the last message. */
+struct results {
+    uint64_t last_ns;
+    uint64_t errors;        /* Messages out of order or short. */
+    uint64_t lat_ns[];
+};
+
+struct options {
+    uint32_t count;
+    uint32_t size;
+    uint32_t interval_us;
+    uint32_t slots;
+    int cpu[2];             /* Producer, consumer; -1 leaves it unpinned. */
+};
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void pin(int cpu)
+{
+    cpu_set_t set;
+
+    if (cpu < 0)
+        return;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) < 0)
+        perror("sched_setaffinity");
+}
+
+/* Sleeps until the next pacing deadline, if paced. */
+static void pace(struct timespec *next, uint32_t interval_us)
+{
+    if (interval_us == 0)
+        return;
+    next->tv_nsec += (long)interval_us * 1000;
+    while (next->tv_nsec >= 1000000000L) {
+        next->tv_nsec -= 1000000000L;
+        next->tv_sec++;
+    }
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, next, NULL) == EINTR)
+        ;
+}
+
+static void stamp(unsigned char *msg, uint64_t seq)
+{
+    struct msg_hdr h = { seq, now_ns() };
+    memcpy(msg, &h, sizeof(h));
+}
+
+static void record(struct results *res, const unsigned char *msg, int len, uint64_t expected, uint64_t size)
+{
+    uint64_t t = now_ns();
+    struct msg_hdr h;
+
+    memcpy(&h, msg, sizeof(h));
+    if (h.seq != expected || (uint64_t)len != size)
+        res->errors++;
+    res->lat_ns[expected] = t - h.sent_ns;
+    res->last_ns = t;
+}
+
+/* ---- sem: the HW2 handshake with a one message buffer ---- */
+
+struct sem_ipc {
+    sem_t *ready;           /* Posted by the producer: the buffer holds a message. */
+    sem_t *free;            /* Posted by the consumer: the buffer can be reused. */
+    unsigned char *buf;     /* Shared message buffer. */
+};
+
+static int sem_setup(struct sem_ipc *s, uint32_t size)
+{
+    sem_unlink(SEM_NAME);
+    sem_unlink(SEM_FREE_NAME);
+    s->ready = sem_open(SEM_NAME, O_CREAT, 0644, 0);
+    s->free = sem_open(SEM_FREE_NAME, O_CREAT, 0644, 1);
+    if (s->ready == SEM_FAILED || s->free == SEM_FAILED) {
+        perror("sem_open");
+        return -1;
+    }
+    s->buf = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (s->buf == MAP_FAILED) {
+        perror("mmap");
+        return -1;
+    }
+    return 0;
+}
+
+static void sem_teardown(struct sem_ipc *s, uint32_t size)
+{
+    munmap(s->buf, size);
+    sem_close(s->ready);
+    sem_close(s->free);
+    sem_unlink(SEM_NAME);
+    sem_unlink(SEM_FREE_NAME);
+}
+
+static void sem_consumer(struct sem_ipc *s, const struct options *o, struct results *res, unsigned char *msg)
+{
+    uint64_t i;
+
+    for (i = 0; i < o->count; i++) {
+        while (sem_wait(s->ready) < 0 && errno == EINTR)
+            ;
+        memcpy(msg, s->buf, o->size);
+        record(res, msg, o->size, i, o->size);
+        sem_post(s->free);
+    }
+}
+
+static void sem_producer(struct sem_ipc *s, const struct options *o, uint32_t interval_us, unsigned char *msg)
+{
+    struct timespec next;
+    uint64_t i;
+
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    for (i = 0; i < o->count; i++) {
+        pace(&next, interval_us);
+        while (sem_wait(s->free) < 0 && errno == EINTR)
+            ;
+        stamp(msg, i);
+        memcpy(s->buf, msg, o->size);
+        sem_post(s->ready);
+    }
+}
+
+/* ---- ring: shm_channel ---- */
+
+static void ring_consumer(const struct options *o, struct results *res, unsigned char *msg)
+{
+    struct shm_channel ch;
+    uint64_t i;
+    int len;
+
+    if (shm_channel_open(&ch, RING_NAME) < 0) {
+        perror("shm_channel_open");
+        exit(1);
+    }
+    for (i = 0; i < o->count; i++) {
+        len = shm_channel_recv(&ch, msg, o->size, 1);
+        record(res, msg, len, i, o->size);
+    }
+    shm_channel_close(&ch);
+}
+
+static void ring_producer(struct shm_channel *ch, const struct options *o, uint32_t interval_us, unsigned char *msg)
+{
+    struct timespec next;
+    uint64_t i;
+
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    for (i = 0; i < o->count; i++) {
+        pace(&next, interval_us);
+        stamp(msg, i);
+        shm_channel_send(ch, msg, o->size, 1);
+    }
+}
+
+/* ---- driver ---- */
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Nearest rank percentile of sorted[0..n-1]. */
+static uint64_t percentile(const uint64_t *sorted, uint32_t n, uint32_t pct)
+{
+    uint64_t rank = ((uint64_t)n * pct + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static int run(const char *mode, const struct options *o, uint32_t interval_us)
+{
+    size_t res_size = sizeof(struct results) + (size_t)o->count * sizeof(uint64_t);
+    struct results *res;
+    struct sem_ipc s;
+    struct shm_channel ch;
+    unsigned char *msg = calloc(1, o->size);
+    int ring = (strcmp(mode, "ring") == 0);
+    uint64_t start, span;
+    pid_t pid;
+    int status;
+
+    res = mmap(NULL, res_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (res == MAP_FAILED || msg == NULL) {
+        perror("mmap");
+        return -1;
+    }
+    res->errors = 0;
+
+    if (ring ? shm_channel_create(&ch, RING_NAME, o->slots, o->size) : sem_setup(&s, o->size)) {
+        if (ring)
+            perror("shm_channel_create");
+        return -1;
+    }
+
+    pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return -1;
+    }
+    if (pid == 0) {
+        pin(o->cpu[1]);
+        if (ring)
+            ring_consumer(o, res, msg);
+        else
+            sem_consumer(&s, o, res, msg);
+        _exit(0);
+    }
+
+    pin(o->cpu[0]);
+    /* Give the consumer time to block before the first message. */
+    usleep(10000);
+    start = now_ns();
+    if (ring)
+        ring_producer(&ch, o, interval_us, msg);
+    else
+        sem_producer(&s, o, interval_us, msg);
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "%s: consumer failed\n", mode);
+        return -1;
+    }
+
+    if (ring) {
+        shm_channel_close(&ch);
+        shm_channel_unlink(RING_NAME);
+    } else {
+        sem_teardown(&s, o->size);
+    }
+
+    span = res->last_ns - start;
+    qsort(res->lat_ns, o->count, sizeof(uint64_t), cmp_u64);
+    printf("%-5s %-10s %9.2f %9.2f %9.2f %12.0f %9.2f%s\n", mode, interval_us ? "paced" : "unpaced",
+           percentile(res->lat_ns, o->count, 50) / 1e3, percentile(res->lat_ns, o->count, 99) / 1e3,
+           res->lat_ns[o->count - 1] / 1e3, o->count * 1e9 / span, (double)o->count * o->size * 1e3 / span,
+           res->errors ? "  (out of order messages)" : "");
+
+    munmap(res, res_size);
+    free(msg);
+    return 0;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [-m sem|ring|both] [-n count] [-s bytes] [-i interval_us] [-r slots] [-c cpu,cpu]\n"
+            "  -m  what to measure (default both)\n"
+            "  -n  messages per run (default 10000)\n"
+            "  -s  payload size in bytes, at least %zu (default 64)\n"
+            "  -i  send interval of the paced runs in microseconds (default 200)\n"
+            "  -r  ring slots, a power of two (default 64)\n"
+            "  -c  pin the producer and the consumer to these CPUs\n",
+            prog, sizeof(struct msg_hdr));
+}
+
+int main(int argc, char *argv[])
+{
+    struct options o = { 10000, 64, 200, 64, { -1, -1 } };
+    const char *mode = "both";
+    int opt, rc = 0;
+
+    while ((opt = getopt(argc, argv, "m:n:s:i:r:c:h")) != -1) {
+        switch (opt) {
+        case 'm': mode = optarg; break;
+        case 'n': o.count = strtoul(optarg, NULL, 0); break;
+        case 's': o.size = strtoul(optarg, NULL, 0); break;
+        case 'i': o.interval_us = strtoul(optarg, NULL, 0); break;
+        case 'r': o.slots = strtoul(optarg, NULL, 0); break;
+        case 'c':
+            if (sscanf(optarg, "%d,%d", &o.cpu[0], &o.cpu[1]) != 2) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (o.count == 0 || o.size < sizeof(struct msg_hdr) || o.interval_us == 0 ||
+        (strcmp(mode, "sem") && strcmp(mode, "ring") && strcmp(mode, "both"))) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    printf("%u messages of %u bytes, paced every %u us, ring of %u slots\n", o.count, o.size, o.interval_us, o.slots);
+    printf("%-5s %-10s %9s %9s %9s %12s %9s\n", "mode", "run", "p50 us", "p99 us", "max us", "msg/s", "MB/s");
+    if (strcmp(mode, "ring") != 0)
+        rc |= run("sem", &o, o.interval_us) | run("sem", &o, 0);
+    if (strcmp(mode, "sem") != 0)
+        rc |= run("ring", &o, o.interval_us) | run("ring", &o, 0);
+    return rc ? 1 : 0;
+}
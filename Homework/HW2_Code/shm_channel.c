@@ -0,0 +1,194 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include "shm_channel.h"
+
+#define CACHE_LINE 64
+
+struct shm_channel_hdr {
+    uint32_t magic;         /* Written last by the creator. */
+    uint32_t slots;
+    uint32_t msg_size;
+    uint32_t slot_size;     /* Length word plus msg_size, rounded up to 8 bytes. */
+    /* Free running indices; head - tail is the number of queued messages. */
+    uint32_t head __attribute__((aligned(CACHE_LINE)));    /* Written by the producer only. */
+    uint32_t tail __attribute__((aligned(CACHE_LINE)));    /* Written by the consumer only. */
+} __attribute__((aligned(CACHE_LINE)));
+
+static size_t map_size(uint32_t slots, uint32_t slot_size)
+{
+    return sizeof(struct shm_channel_hdr) + (size_t)slots * slot_size;
+}
+
+/* Both sides map the object MAP_SHARED, so these are process shared (not private) futexes. */
+static void futex_wait(uint32_t *addr, uint32_t expected)
+{
+    syscall(SYS_futex, addr, FUTEX_WAIT, expected, NULL, NULL, 0);
+}
+
+static void futex_wake(uint32_t *addr)
+{
+    syscall(SYS_futex, addr, FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+static int map(struct shm_channel *ch, int fd, size_t size)
+{
+    void *p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+        return -1;
+    ch->hdr = p;
+    ch->slots = (unsigned char *)p + sizeof(struct shm_channel_hdr);
+    ch->map_size = size;
+    return 0;
+}
+
+int shm_channel_create(struct shm_channel *ch, const char *name, uint32_t slots, uint32_t msg_size)
+{
+    uint32_t slot_size = (sizeof(uint32_t) + msg_size + 7) & ~7u;
+    size_t size = map_size(slots, slot_size);
+    int fd, rc;
+
+    if (slots == 0 || (slots & (slots - 1)) != 0 || msg_size == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0)
+        return -1;
+    /* Truncate to zero first so a stale ring of the same size never leaks old indices. */
+    rc = (ftruncate(fd, 0) < 0 || ftruncate(fd, size) < 0) ? -1 : map(ch, fd, size);
+    close(fd);
+    if (rc < 0)
+        return -1;
+
+    ch->hdr->slots = slots;
+    ch->hdr->msg_size = msg_size;
+    ch->hdr->slot_size = slot_size;
+    ch->hdr->head = 0;
+    ch->hdr->tail = 0;
+    __atomic_store_n(&ch->hdr->magic, SHM_CHANNEL_MAGIC, __ATOMIC_RELEASE);
+    return 0;
+}
+
+int shm_channel_open(struct shm_channel *ch, const char *name)
+{
+    struct stat st;
+    int fd, rc;
+
+    fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0)
+        return -1;
+    if (fstat(fd, &st) < 0) {
+        rc = -1;
+    } else if ((size_t)st.st_size < sizeof(struct shm_channel_hdr)) {
+        errno = EINVAL;
+        rc = -1;
+    } else {
+        rc = map(ch, fd, st.st_size);
+    }
+    close(fd);
+    if (rc < 0)
+        return -1;
+
+    if (__atomic_load_n(&ch->hdr->magic, __ATOMIC_ACQUIRE) != SHM_CHANNEL_MAGIC ||
+        map_size(ch->hdr->slots, ch->hdr->slot_size) > ch->map_size) {
+        shm_channel_close(ch);
+        errno = EINVAL;
+        return -1;
+    }
+    return 0;
+}
+
+void shm_channel_close(struct shm_channel *ch)
+{
+    if (ch->hdr != NULL)
+        munmap(ch->hdr, ch->map_size);
+    ch->hdr = NULL;
+    ch->slots = NULL;
+}
+
+int shm_channel_unlink(const char *name)
+{
+    return shm_unlink(name);
+}
+
+uint32_t shm_channel_msg_size(const struct shm_channel *ch)
+{
+    return ch->hdr->msg_size;
+}
+
+int shm_channel_send(struct shm_channel *ch, const void *msg, uint32_t len, int block)
+{
+    struct shm_channel_hdr *h = ch->hdr;
+    uint32_t head = __atomic_load_n(&h->head, __ATOMIC_RELAXED);
+    uint32_t tail;
+    unsigned char *slot;
+
+    if (len > h->msg_size) {
+        errno = EMSGSIZE;
+        return -1;
+    }
+
+    for (;;) {
+        tail = __atomic_load_n(&h->tail, __ATOMIC_ACQUIRE);
+        if (head - tail < h->slots)
+            break;
+        if (!block) {
+            errno = EAGAIN;
+            return -1;
+        }
+        /* Returns at once if the consumer has moved tail since the load. */
+        futex_wait(&h->tail, tail);
+    }
+
+    slot = ch->slots + (size_t)(head & (h->slots - 1)) * h->slot_size;
+    memcpy(slot, &len, sizeof(len));
+    memcpy(slot + sizeof(len), msg, len);
+    __atomic_store_n(&h->head, head + 1, __ATOMIC_RELEASE);
+
+    /* Publishing head and reading tail must not be reordered, or a consumer going to sleep on the
+     * old head could be missed. The consumer can only be asleep if it had taken everything. */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&h->tail, __ATOMIC_RELAXED) == head)
+        futex_wake(&h->head);
+    return 0;
+}
+
+int shm_channel_recv(struct shm_channel *ch, void *buf, uint32_t cap, int block)
+{
+    struct shm_channel_hdr *h = ch->hdr;
+    uint32_t tail = __atomic_load_n(&h->tail, __ATOMIC_RELAXED);
+    uint32_t head, len;
+    unsigned char *slot;
+
+    for (;;) {
+        head = __atomic_load_n(&h->head, __ATOMIC_ACQUIRE);
+        if (head != tail)
+            break;
+        if (!block) {
+            errno = EAGAIN;
+            return -1;
+        }
+        futex_wait(&h->head, head);
+    }
+
+    slot = ch->slots + (size_t)(tail & (h->slots - 1)) * h->slot_size;
+    memcpy(&len, slot, sizeof(len));
+    if (len > cap)
+        len = cap;
+    memcpy(buf, slot + sizeof(len), len);
+    __atomic_store_n(&h->tail, tail + 1, __ATOMIC_RELEASE);
+
+    /* Same pairing as in send: the producer can only be asleep if the ring was full. */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&h->head, __ATOMIC_RELAXED) - tail == h->slots)
+        futex_wake(&h->tail);
+    return (int)len;
+}
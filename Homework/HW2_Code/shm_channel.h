@@ -0,0 +1,56 @@
+#ifndef SHM_CHANNEL_H
+#define SHM_CHANNEL_H
+
+/*
+ * Single producer / single consumer message ring in POSIX shared memory.
+ *
+ * The ring lives in a shm_open() object mapped by both processes: a header
+ * with the producer index (head) and the consumer index (tail) on cache
+ * lines of their own, followed by a power of two number of fixed size
+ * slots. Neither side takes a lock. Sleeping is done with futexes on the
+ * two indices, and the other side is only woken on a transition it can be
+ * waiting for: the producer wakes the consumer when the ring goes from
+ * empty to non-empty, the consumer wakes the producer when it goes from
+ * full to non-full. A busy stream therefore costs no system calls at all.
+ *
+ * The creator (shm_channel_create) sizes and initialises the object, the
+ * peer attaches with shm_channel_open. Either side may be the producer,
+ * but only one process (thread) may send and only one may receive.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SHM_CHANNEL_MAGIC 0x53504331u   /* "SPC1" */
+
+struct shm_channel_hdr;
+
+struct shm_channel {
+    struct shm_channel_hdr *hdr;
+    unsigned char *slots;
+    size_t map_size;
+};
+
+/* Creates (or truncates) the shared memory object name with slots slots of at most
+ * msg_size bytes each; slots must be a power of two. Returns 0 or -1 with errno set. */
+int shm_channel_create(struct shm_channel *ch, const char *name, uint32_t slots, uint32_t msg_size);
+
+/* Maps an object made by shm_channel_create. Returns 0 or -1 with errno set. */
+int shm_channel_open(struct shm_channel *ch, const char *name);
+
+/* Unmaps the channel; shm_channel_unlink removes the name. */
+void shm_channel_close(struct shm_channel *ch);
+int shm_channel_unlink(const char *name);
+
+/* Largest message the slots hold. */
+uint32_t shm_channel_msg_size(const struct shm_channel *ch);
+
+/* Copies len bytes into the next slot. Blocks while the ring is full when block is
+ * non-zero; otherwise returns -1 with errno EAGAIN. len above the slot size is EMSGSIZE. */
+int shm_channel_send(struct shm_channel *ch, const void *msg, uint32_t len, int block);
+
+/* Copies the oldest message into buf (at most cap bytes) and returns its length. Blocks
+ * while the ring is empty when block is non-zero; otherwise returns -1 with errno EAGAIN. */
+int shm_channel_recv(struct shm_channel *ch, void *buf, uint32_t cap, int block);
+
+#endif